@@ -0,0 +1,735 @@
+#if defined(ATLAS_IMPL) && defined(__STRICT_ANSI__) && !defined(_POSIX_C_SOURCE) && !defined(_WIN32) && !defined(__APPLE__)
+#define _POSIX_C_SOURCE 199309L // clock_gettime(CLOCK_MONOTONIC) under -std=c99
+#endif
+#ifndef ATLAS_H
+#define ATLAS_H
+/*
+    atlas.h -- runtime texture atlas builder on top of sokol_gfx.h
+
+    Include sokol_gfx.h first, and do this:
+
+        #define ATLAS_IMPL
+
+    before including this file in *one* C file to create the implementation.
+
+    Many small RGBA8 bitmaps (e.g. decoded with stbi_load(..., 4)) are packed
+    into a few large pages, each backed by one dynamic sg_image. Sprites that
+    use different bitmaps of the same page share a texture and therefore
+    don't break batching in sprite_batch.h.
+
+    Bitmaps are placed with a bottom-left skyline packer: every page keeps the
+    top edge of its occupied area as a list of horizontal segments, and a new
+    rectangle goes where its top edge ends up lowest, preferring the narrowest
+    segment on ties. Insertion is incremental, a bitmap added to a full atlas
+    opens a new page, up to desc.max_pages.
+
+    The atlas keeps a CPU copy of every bitmap. atlas_remove() only marks its
+    area as free, since a skyline can't reuse holes below its top edge. The
+    space is reclaimed by atlas_repack(), which sorts all live bitmaps by
+    height and packs them again from scratch. atlas_add() repacks on its own
+    when a bitmap doesn't fit anywhere and removed bitmaps left holes. Entry
+    ids stay the same across a repack, their rectangles don't, so look up
+    atlas_rect() when drawing instead of caching it.
+
+    Usage:
+
+        atlas_t atlas;
+        if (!atlas_init(&atlas, &(atlas_desc_t){ .width = 2048, .height = 2048 }))
+            return false;                           // out of memory
+
+        int id = atlas_add(&atlas, pixels, w, h);   // -1 if it doesn't fit or out of memory
+        ...
+        atlas_commit(&atlas);                       // at most once per frame
+
+        // when drawing:
+        const atlas_rect_t r = atlas_rect(&atlas, id);
+        sprite_batch_draw(&batch, atlas_image(&atlas, r.page), &(sprite_t){
+            ..., .u0 = r.u0, .v0 = r.v0, .u1 = r.u1, .v1 = r.v1, .color = SPRITE_COLOR_WHITE
+        });
+
+        // on exit, before sg_shutdown():
+        atlas_shutdown(&atlas);
+
+    atlas_commit() uploads every page modified since the last commit with
+    sg_update_image(), which may only be called once per image and frame.
+
+    Bitmaps are separated by desc.padding transparent pixels, use at least
+    one pixel with linear filtering to keep neighbours from bleeding in.
+
+    atlas_stats() reports the packing efficiency (pixels covered by live
+    bitmaps over the area of all pages) and the time spent packing and
+    uploading, measured with clock_gettime(CLOCK_MONOTONIC) on POSIX
+    platforms and QueryPerformanceCounter() on Windows. Under -std=c99 this
+    file defines _POSIX_C_SOURCE to get clock_gettime(), which only works
+    before the first system header: either include it (or sokol_gfx.h with
+    its implementation) ahead of them, or define _POSIX_C_SOURCE=199309L on
+    the command line.
+
+    If memory runs out, atlas_add() returns -1 and atlas_repack() returns
+    false, in both cases the atlas is left as it was.
+*/
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct
+{
+    int width, height;          // page size in pixels, default: 2048 x 2048
+    int padding;                // empty pixels right of and below each bitmap, default: 1, negative for none
+    int max_pages;              // default: 4
+    sg_filter min_filter;       // filters of the page images, default: sokol_gfx default
+    sg_filter mag_filter;
+    const char* label;
+} atlas_desc_t;
+
+typedef struct
+{
+    int page;                   // index of the page, see atlas_image()
+    int x, y, w, h;             // position and size in pixels
+    float u0, v0, u1, v1;       // texture coordinates of the top-left and bottom-right corners
+} atlas_rect_t;
+
+typedef struct
+{
+    int num_entries;            // live bitmaps
+    int num_pages;
+    int64_t used_pixels;        // pixels covered by live bitmaps
+    int64_t total_pixels;       // area of all pages
+    float efficiency;           // used_pixels / total_pixels
+    int num_repacks;
+    double pack_ms;             // time spent in atlas_add() and atlas_repack()
+    double upload_ms;           // time spent in atlas_commit()
+} atlas_stats_t;
+
+typedef struct
+{
+    int x, y, w;
+} atlas_node_t;
+
+typedef struct
+{
+    atlas_node_t* nodes;        // skyline, sorted by x, covers the page width
+    int num_nodes;
+    uint8_t* pixels;
+    sg_image image;
+    bool dirty;
+} atlas_page_t;
+
+typedef struct
+{
+    bool live;
+    uint8_t* pixels;
+    atlas_rect_t rect;
+} atlas_entry_t;
+
+typedef struct
+{
+    atlas_desc_t desc;
+    atlas_page_t* pages;
+    int num_pages;
+    atlas_entry_t* entries;
+    int num_entries;            // used entry slots, live or not
+    int max_entries;
+    int64_t freed_pixels;       // area of removed bitmaps, reclaimed by a repack
+    atlas_stats_t stats;
+} atlas_t;
+
+bool atlas_init(atlas_t* atlas, const atlas_desc_t* desc);
+void atlas_shutdown(atlas_t* atlas);
+int atlas_add(atlas_t* atlas, const void* pixels, int w, int h);
+void atlas_remove(atlas_t* atlas, int id);
+bool atlas_repack(atlas_t* atlas);
+void atlas_commit(atlas_t* atlas);
+atlas_rect_t atlas_rect(const atlas_t* atlas, int id);
+sg_image atlas_image(const atlas_t* atlas, int page);
+atlas_stats_t atlas_stats(const atlas_t* atlas);
+
+#endif // ATLAS_H
+
+#ifdef ATLAS_IMPL
+#ifndef ATLAS_IMPL_INCLUDED
+#define ATLAS_IMPL_INCLUDED
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <time.h>
+    #if !defined(CLOCK_MONOTONIC)
+    #error "atlas.h: clock_gettime() is unavailable, define _POSIX_C_SOURCE=199309L"
+    #endif
+#endif
+
+// Wall clock time, clock() would count the CPU time of all threads of the process
+static double atlas_now_ms(void)
+{
+    #if defined(_WIN32)
+        LARGE_INTEGER freq, counter;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&counter);
+        return (double)counter.QuadPart * 1000.0 / (double)freq.QuadPart;
+    #else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+    #endif
+}
+
+static void atlas_skyline_reset(const atlas_t* atlas, atlas_node_t* nodes, int* num_nodes)
+{
+    nodes[0] = (atlas_node_t){ 0, 0, atlas->desc.width };
+    *num_nodes = 1;
+}
+
+// Returns the lowest y at which a w x h rectangle with its left edge on node
+// 'index' rests on the skyline, or -1 if it doesn't fit there
+static int atlas_skyline_fit(const atlas_t* atlas, const atlas_node_t* nodes, int num_nodes, int index, int w, int h)
+{
+    const int x = nodes[index].x;
+
+    if (x + w > atlas->desc.width)
+        return -1;
+
+    int y = 0;
+
+    for (int i = index, width_left = w; width_left > 0; i++)
+    {
+        assert(i < num_nodes);
+
+        if (nodes[i].y > y)
+            y = nodes[i].y;
+
+        if (y + h > atlas->desc.height)
+            return -1;
+
+        width_left -= nodes[i].w;
+    }
+
+    return y;
+}
+
+static bool atlas_skyline_insert(const atlas_t* atlas, atlas_node_t* nodes, int* num_nodes, int w, int h, int* out_x, int* out_y)
+{
+    int best_index = -1, best_top = INT_MAX, best_width = INT_MAX;
+    int best_x = 0, best_y = 0;
+
+    for (int i = 0; i < *num_nodes; i++)
+    {
+        const int y = atlas_skyline_fit(atlas, nodes, *num_nodes, i, w, h);
+
+        if (y < 0)
+            continue;
+
+        if ((y + h < best_top) || ((y + h == best_top) && (nodes[i].w < best_width)))
+        {
+            best_index = i;
+            best_top = y + h;
+            best_width = nodes[i].w;
+            best_x = nodes[i].x;
+            best_y = y;
+        }
+    }
+
+    if (best_index < 0)
+        return false;
+
+    // the new segment covers the rectangle's top edge, segments it hides are
+    // shortened from the left or removed
+    memmove(nodes + best_index + 1, nodes + best_index, sizeof(atlas_node_t) * (*num_nodes - best_index));
+    nodes[best_index] = (atlas_node_t){ best_x, best_y + h, w };
+    (*num_nodes)++;
+
+    for (int i = best_index + 1; i < *num_nodes; )
+    {
+        const int prev_right = nodes[i - 1].x + nodes[i - 1].w;
+
+        if (nodes[i].x >= prev_right)
+            break;
+
+        const int shrink = prev_right - nodes[i].x;
+        nodes[i].x += shrink;
+        nodes[i].w -= shrink;
+
+        if (nodes[i].w > 0)
+            break;
+
+        memmove(nodes + i, nodes + i + 1, sizeof(atlas_node_t) * (*num_nodes - i - 1));
+        (*num_nodes)--;
+    }
+
+    // merge neighbours at the same height
+    for (int i = 0; i < *num_nodes - 1; )
+    {
+        if (nodes[i].y == nodes[i + 1].y)
+        {
+            nodes[i].w += nodes[i + 1].w;
+            memmove(nodes + i + 1, nodes + i + 2, sizeof(atlas_node_t) * (*num_nodes - i - 2));
+            (*num_nodes)--;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    *out_x = best_x;
+    *out_y = best_y;
+    return true;
+}
+
+static bool atlas_open_page(atlas_t* atlas)
+{
+    assert(atlas->num_pages < atlas->desc.max_pages);
+
+    atlas_page_t* page = &atlas->pages[atlas->num_pages];
+
+    // a skyline never has more segments than the page is wide
+    page->nodes = malloc(sizeof(atlas_node_t) * (atlas->desc.width + 1));
+    page->pixels = calloc((size_t)atlas->desc.width * atlas->desc.height, 4);
+
+    if (!page->nodes || !page->pixels)
+    {
+        free(page->nodes);
+        free(page->pixels);
+        memset(page, 0, sizeof(*page));
+        return false;
+    }
+
+    page->image.id = SG_INVALID_ID;
+    page->dirty = true;
+    atlas_skyline_reset(atlas, page->nodes, &page->num_nodes);
+    atlas->num_pages++;
+    return true;
+}
+
+static void atlas_close_page(atlas_t* atlas)
+{
+    assert(atlas->num_pages > 0);
+
+    atlas_page_t* page = &atlas->pages[--atlas->num_pages];
+
+    if (page->image.id != SG_INVALID_ID)
+        sg_destroy_image(page->image);
+
+    free(page->nodes);
+    free(page->pixels);
+    memset(page, 0, sizeof(*page));
+}
+
+static void atlas_set_rect(atlas_t* atlas, atlas_entry_t* entry, int page, int x, int y)
+{
+    atlas_rect_t* r = &entry->rect;
+
+    r->page = page;
+    r->x = x;
+    r->y = y;
+    r->u0 = (float)x / (float)atlas->desc.width;
+    r->v0 = (float)y / (float)atlas->desc.height;
+    r->u1 = (float)(x + r->w) / (float)atlas->desc.width;
+    r->v1 = (float)(y + r->h) / (float)atlas->desc.height;
+}
+
+static void atlas_blit(atlas_t* atlas, const atlas_entry_t* entry)
+{
+    const atlas_rect_t* r = &entry->rect;
+    atlas_page_t* page = &atlas->pages[r->page];
+    const size_t pitch = (size_t)atlas->desc.width * 4;
+
+    for (int row = 0; row < r->h; row++)
+    {
+        memcpy(page->pixels + (size_t)(r->y + row) * pitch + (size_t)r->x * 4,
+               entry->pixels + (size_t)row * r->w * 4,
+               (size_t)r->w * 4);
+    }
+
+    page->dirty = true;
+}
+
+static void atlas_update_stats(atlas_t* atlas)
+{
+    atlas_stats_t* stats = &atlas->stats;
+
+    stats->num_entries = 0;
+    stats->used_pixels = 0;
+
+    for (int i = 0; i < atlas->num_entries; i++)
+    {
+        if (atlas->entries[i].live)
+        {
+            stats->num_entries++;
+            stats->used_pixels += (int64_t)atlas->entries[i].rect.w * atlas->entries[i].rect.h;
+        }
+    }
+
+    stats->num_pages = atlas->num_pages;
+    stats->total_pixels = (int64_t)atlas->num_pages * atlas->desc.width * atlas->desc.height;
+    stats->efficiency = (stats->total_pixels > 0) ? (float)((double)stats->used_pixels / (double)stats->total_pixels) : 0.0f;
+}
+
+bool atlas_init(atlas_t* atlas, const atlas_desc_t* desc)
+{
+    assert(atlas && desc);
+    memset(atlas, 0, sizeof(*atlas));
+
+    atlas->desc = *desc;
+
+    if (atlas->desc.width <= 0)
+        atlas->desc.width = 2048;
+
+    if (atlas->desc.height <= 0)
+        atlas->desc.height = 2048;
+
+    if (atlas->desc.padding < 0)
+        atlas->desc.padding = 0;
+    else if (atlas->desc.padding == 0)
+        atlas->desc.padding = 1;
+
+    if (atlas->desc.max_pages <= 0)
+        atlas->desc.max_pages = 4;
+
+    atlas->pages = calloc(atlas->desc.max_pages, sizeof(atlas_page_t));
+
+    if (!atlas->pages)
+    {
+        memset(atlas, 0, sizeof(*atlas));
+        return false;
+    }
+
+    return true;
+}
+
+void atlas_shutdown(atlas_t* atlas)
+{
+    assert(atlas);
+
+    while (atlas->num_pages > 0)
+        atlas_close_page(atlas);
+
+    for (int i = 0; i < atlas->num_entries; i++)
+        free(atlas->entries[i].pixels);
+
+    free(atlas->entries);
+    free(atlas->pages);
+    memset(atlas, 0, sizeof(*atlas));
+}
+
+typedef struct
+{
+    int id;
+    int w, h;
+    int page, x, y;
+} atlas_placement_t;
+
+// tallest first, then widest
+static int atlas_compare_placements(const void* a, const void* b)
+{
+    const atlas_placement_t* pa = a;
+    const atlas_placement_t* pb = b;
+
+    if (pa->h != pb->h)
+        return pb->h - pa->h;
+
+    if (pa->w != pb->w)
+        return pb->w - pa->w;
+
+    return pa->id - pb->id;
+}
+
+bool atlas_repack(atlas_t* atlas)
+{
+    assert(atlas);
+
+    const double start = atlas_now_ms();
+    const int pad = atlas->desc.padding;
+
+    // pack into scratch skylines first, so the atlas is left untouched if
+    // the bitmaps don't fit into max_pages
+    const int max_nodes = atlas->desc.width + 1;
+    atlas_placement_t* items = malloc(sizeof(atlas_placement_t) * (atlas->num_entries + 1));
+    atlas_node_t* nodes = malloc(sizeof(atlas_node_t) * max_nodes * atlas->desc.max_pages);
+    int* num_nodes = malloc(sizeof(int) * atlas->desc.max_pages);
+
+    if (!items || !nodes || !num_nodes)
+    {
+        free(num_nodes);
+        free(nodes);
+        free(items);
+        atlas->stats.pack_ms += atlas_now_ms() - start;
+        return false;
+    }
+
+    int num_items = 0;
+
+    for (int i = 0; i < atlas->num_entries; i++)
+    {
+        if (atlas->entries[i].live)
+        {
+            const atlas_rect_t* r = &atlas->entries[i].rect;
+            items[num_items++] = (atlas_placement_t){ .id = i, .w = r->w, .h = r->h };
+        }
+    }
+
+    qsort(items, num_items, sizeof(atlas_placement_t), atlas_compare_placements);
+
+    int num_pages = 0;
+    bool ok = true;
+
+    for (int i = 0; (i < num_items) && ok; i++)
+    {
+        bool placed = false;
+
+        for (int p = 0; !placed; p++)
+        {
+            if (p == num_pages)
+            {
+                if (num_pages == atlas->desc.max_pages)
+                    break;
+
+                atlas_skyline_reset(atlas, nodes + p * max_nodes, &num_nodes[p]);
+                num_pages++;
+            }
+
+            placed = atlas_skyline_insert(atlas, nodes + p * max_nodes, &num_nodes[p],
+                                          items[i].w + pad, items[i].h + pad, &items[i].x, &items[i].y);
+            items[i].page = p;
+        }
+
+        ok = placed;
+    }
+
+    // new pages are opened before anything else changes, if that runs out
+    // of memory they are closed again and the atlas is left as it was
+    const int old_num_pages = atlas->num_pages;
+
+    while (ok && (atlas->num_pages < num_pages))
+        ok = atlas_open_page(atlas);
+
+    if (!ok)
+    {
+        while (atlas->num_pages > old_num_pages)
+            atlas_close_page(atlas);
+    }
+
+    if (ok)
+    {
+        while (atlas->num_pages > num_pages)
+            atlas_close_page(atlas);
+
+        for (int p = 0; p < num_pages; p++)
+        {
+            atlas_page_t* page = &atlas->pages[p];
+            memcpy(page->nodes, nodes + p * max_nodes, sizeof(atlas_node_t) * num_nodes[p]);
+            page->num_nodes = num_nodes[p];
+            memset(page->pixels, 0, (size_t)atlas->desc.width * atlas->desc.height * 4);
+            page->dirty = true;
+        }
+
+        for (int i = 0; i < num_items; i++)
+        {
+            atlas_entry_t* entry = &atlas->entries[items[i].id];
+            atlas_set_rect(atlas, entry, items[i].page, items[i].x, items[i].y);
+            atlas_blit(atlas, entry);
+        }
+
+        atlas->freed_pixels = 0;
+        atlas->stats.num_repacks++;
+        atlas_update_stats(atlas);
+    }
+
+    free(num_nodes);
+    free(nodes);
+    free(items);
+
+    atlas->stats.pack_ms += atlas_now_ms() - start;
+    return ok;
+}
+
+int atlas_add(atlas_t* atlas, const void* pixels, int w, int h)
+{
+    assert(atlas && pixels);
+
+    const int pad = atlas->desc.padding;
+
+    if ((w <= 0) || (h <= 0) || (w + pad > atlas->desc.width) || (h + pad > atlas->desc.height))
+        return -1;
+
+    const double start = atlas_now_ms();
+
+    // reuse the slot of a removed bitmap, so ids stay small
+    int id = 0;
+
+    while ((id < atlas->num_entries) && atlas->entries[id].live)
+        id++;
+
+    if (id == atlas->num_entries)
+    {
+        if (atlas->num_entries == atlas->max_entries)
+        {
+            const int max_entries = atlas->max_entries ? atlas->max_entries * 2 : 64;
+            atlas_entry_t* entries = realloc(atlas->entries, sizeof(atlas_entry_t) * max_entries);
+
+            if (!entries)
+            {
+                atlas->stats.pack_ms += atlas_now_ms() - start;
+                return -1;
+            }
+
+            atlas->entries = entries;
+            atlas->max_entries = max_entries;
+        }
+
+        atlas->num_entries++;
+    }
+
+    atlas_entry_t* entry = &atlas->entries[id];
+    const size_t size = (size_t)w * h * 4;
+
+    uint8_t* copy = malloc(size);
+
+    if (!copy)
+    {
+        *entry = (atlas_entry_t){ 0 };
+        atlas->stats.pack_ms += atlas_now_ms() - start;
+        return -1;
+    }
+
+    *entry = (atlas_entry_t){
+        .live = true,
+        .pixels = copy,
+        .rect = { .page = -1, .w = w, .h = h }
+    };
+
+    memcpy(entry->pixels, pixels, size);
+
+    int x = 0, y = 0, page = -1;
+
+    for (int p = 0; (p < atlas->num_pages) && (page < 0); p++)
+    {
+        if (atlas_skyline_insert(atlas, atlas->pages[p].nodes, &atlas->pages[p].num_nodes, w + pad, h + pad, &x, &y))
+            page = p;
+    }
+
+    if ((page < 0) && (atlas->num_pages < atlas->desc.max_pages) && atlas_open_page(atlas))
+    {
+        const int p = atlas->num_pages - 1;
+
+        if (atlas_skyline_insert(atlas, atlas->pages[p].nodes, &atlas->pages[p].num_nodes, w + pad, h + pad, &x, &y))
+            page = p;
+    }
+
+    if (page >= 0)
+    {
+        atlas_set_rect(atlas, entry, page, x, y);
+        atlas_blit(atlas, entry);
+        atlas_update_stats(atlas);
+        atlas->stats.pack_ms += atlas_now_ms() - start;
+        return id;
+    }
+
+    atlas->stats.pack_ms += atlas_now_ms() - start;
+
+    // out of pages, a repack places the new bitmap along with all others
+    if ((atlas->freed_pixels > 0) && atlas_repack(atlas))
+        return id;
+
+    free(entry->pixels);
+    *entry = (atlas_entry_t){ 0 };
+    return -1;
+}
+
+void atlas_remove(atlas_t* atlas, int id)
+{
+    assert(atlas);
+
+    if ((id < 0) || (id >= atlas->num_entries) || !atlas->entries[id].live)
+        return;
+
+    atlas_entry_t* entry = &atlas->entries[id];
+
+    // the area stays in the page until the next repack, clear it so stale
+    // texture coordinates show nothing
+    const atlas_rect_t* r = &entry->rect;
+    atlas_page_t* page = &atlas->pages[r->page];
+    const size_t pitch = (size_t)atlas->desc.width * 4;
+
+    for (int row = 0; row < r->h; row++)
+        memset(page->pixels + (size_t)(r->y + row) * pitch + (size_t)r->x * 4, 0, (size_t)r->w * 4);
+
+    page->dirty = true;
+    atlas->freed_pixels += (int64_t)r->w * r->h;
+
+    free(entry->pixels);
+    *entry = (atlas_entry_t){ 0 };
+    atlas_update_stats(atlas);
+}
+
+void atlas_commit(atlas_t* atlas)
+{
+    assert(atlas);
+
+    const double start = atlas_now_ms();
+
+    for (int p = 0; p < atlas->num_pages; p++)
+    {
+        atlas_page_t* page = &atlas->pages[p];
+
+        if (!page->dirty)
+            continue;
+
+        if (page->image.id == SG_INVALID_ID)
+        {
+            page->image = sg_make_image(&(sg_image_desc){
+                .width = atlas->desc.width,
+                .height = atlas->desc.height,
+                .usage = SG_USAGE_DYNAMIC,
+                .pixel_format = SG_PIXELFORMAT_RGBA8,
+                .min_filter = atlas->desc.min_filter,
+                .mag_filter = atlas->desc.mag_filter,
+                .label = atlas->desc.label
+            });
+        }
+
+        sg_update_image(page->image, &(sg_image_data){
+            .subimage[0][0] = { .ptr = page->pixels, .size = (size_t)atlas->desc.width * atlas->desc.height * 4 }
+        });
+
+        page->dirty = false;
+    }
+
+    atlas->stats.upload_ms += atlas_now_ms() - start;
+}
+
+atlas_rect_t atlas_rect(const atlas_t* atlas, int id)
+{
+    assert(atlas);
+
+    if ((id < 0) || (id >= atlas->num_entries) || !atlas->entries[id].live)
+        return (atlas_rect_t){ .page = -1 };
+
+    return atlas->entries[id].rect;
+}
+
+sg_image atlas_image(const atlas_t* atlas, int page)
+{
+    assert(atlas);
+
+    if ((page < 0) || (page >= atlas->num_pages))
+        return (sg_image){ SG_INVALID_ID };
+
+    return atlas->pages[page].image;
+}
+
+atlas_stats_t atlas_stats(const atlas_t* atlas)
+{
+    assert(atlas);
+    return atlas->stats;
+}
+
+#endif // ATLAS_IMPL_INCLUDED
+#endif // ATLAS_IMPL
@@ -1,4 +1,4 @@
 #!/bin/bash
-gcc -o demo sokol_gfx_sdl.c -lSDL2 -lGL -lm
+gcc -o demo sokol_gfx_sdl.c -lSDL2 -lGL -lm -lpthread
 #clang -o demo -Wall -Wextra -Wpedantic sokol_gfx_sdl2.c -lSDL2 -lGL -lm
 
@@ -37,3 +37,28 @@ void main() {
 @end
 
 @program quad vs fs
+
+@vs vs_instanced
+@glsl_options flip_vert_y
+
+layout(location = 0) in vec2 a_corner;
+layout(location = 1) in vec4 i_rect;
+layout(location = 2) in vec4 i_uv;
+layout(location = 3) in vec4 i_col;
+
+layout(binding = 0) uniform vs_instanced_params {
+    mat4 mvp;
+};
+
+out vec4 col;
+out vec2 uv;
+
+void main() {
+    gl_Position = mvp * vec4(i_rect.xy + a_corner * i_rect.zw, 0.0, 1.0);
+    col = i_col;
+    uv = mix(i_uv.xy, i_uv.zw, a_corner);
+}
+
+@end
+
+@program quad_instanced vs_instanced fs
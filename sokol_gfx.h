@@ -1,6 +1,9 @@
 #if defined(SOKOL_IMPL) && !defined(SOKOL_GFX_IMPL)
 #define SOKOL_GFX_IMPL
 #endif
+#if defined(SOKOL_GFX_IMPL) && defined(__STRICT_ANSI__) && !defined(_POSIX_C_SOURCE) && !defined(_WIN32) && !defined(__APPLE__) && !defined(__EMSCRIPTEN__)
+#define _POSIX_C_SOURCE 199309L // clock_gettime(CLOCK_MONOTONIC) under -std=c99
+#endif
 #ifndef SOKOL_GFX_INCLUDED
 /*
     sokol_gfx.h -- simple 3D API wrapper
@@ -148,6 +151,29 @@
 
         to update the resource bindings
 
+    --- for resource bindings which don't change between frames (for instance
+        static scene geometry), create a binding set object once:
+
+            sg_binding_set sg_make_binding_set(const sg_bindings* bindings)
+
+        ...and apply it instead of an sg_bindings struct:
+
+            sg_apply_binding_set(sg_binding_set bset)
+
+        The referenced resources are looked up and validated when the binding
+        set is created, so that applying a binding set only requires a single
+        handle lookup plus an id compare per referenced resource. While one
+        of the referenced buffers or images is destroyed (or uninitialized),
+        sg_query_binding_set_state() returns SG_RESOURCESTATE_FAILED and draw
+        calls with the binding set are silently skipped, similar to draw calls
+        with resources which are not in the VALID state. An uninitialized
+        resource which is initialized again (on the same handle) makes the
+        binding set usable again, a destroyed resource does not. Binding sets
+        of a discarded context are always FAILED.
+        Binding sets are destroyed with:
+
+            sg_destroy_binding_set(sg_binding_set bset)
+
     --- optionally update shader uniform data with:
 
             sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data)
@@ -169,6 +195,47 @@
         containing per-instance data must be bound, and the num_instances parameter
         must be > 1.
 
+    --- to kick off many draw calls with the same pipeline and bindings, call:
+
+            sg_draw_batch(const sg_draw_item* items, int num_items)
+
+        Each sg_draw_item has the same meaning as the arguments of sg_draw(),
+        plus an optional base_vertex which is added to each index before
+        vertices are fetched (or to base_element for non-indexed rendering).
+        base_vertex is only supported when sg_features.draw_base_vertex
+        is true, otherwise it must be 0.
+
+        The whole batch is validated once. The GL core profile backend maps
+        the batch to glMultiDrawArrays() or glMultiDrawElementsBaseVertex(),
+        or to glMultiDraw*Indirect() for instanced batches when GL 4.3 or
+        GL_ARB_multi_draw_indirect is available. All other backends loop over
+        the items.
+
+    --- if sg_desc.merge_draws is true, sokol-gfx holds back each sg_draw()
+        call and extends it with the following sg_draw() calls as long as
+        their element ranges are adjacent (base_element continues where the
+        previous draw ended), the number of instances is identical and no
+        state has changed in between. The pending draw is issued when any of
+        the following happens:
+
+            - sg_draw() with a non-adjacent element range or different num_instances
+            - sg_apply_pipeline() with a different pipeline
+            - sg_apply_bindings() or sg_apply_binding_set() with different bindings
+            - sg_apply_uniforms() with different uniform data (uniform blocks bigger
+              than 256 bytes are not compared and always issue the pending draw)
+            - sg_apply_viewport(), sg_apply_scissor_rect() or sg_draw_batch()
+            - buffer and image updates, resource creation and destruction
+            - sg_end_pass()
+
+        Only draws with a pipeline of primitive type SG_PRIMITIVETYPE_TRIANGLES,
+        SG_PRIMITIVETYPE_LINES or SG_PRIMITIVETYPE_POINTS are merged, joining
+        two strips would connect the end of the first strip with the start of
+        the second, so strip draws are always issued immediately.
+
+        This is useful for tile- and sprite-renderers which draw many adjacent
+        ranges of the same vertex- or index-buffer with identical state. Merged
+        draws are counted in sg_frame_stats.num_draw_merged.
+
     --- finish the current rendering pass with:
 
             sg_end_pass()
@@ -349,6 +416,42 @@
 
             sg_backend sg_query_backend(void)
 
+    --- you can inspect the resource pools (current size, number of used
+        slots and the high-water-mark of used slots) via:
+
+            sg_pools_info sg_query_pools_info(void)
+
+    --- on the GL backends, you can inspect the program binary cache via:
+
+            sg_program_cache_stats sg_query_program_cache_stats(void)
+
+    --- you can inspect how much work the previous frame did via:
+
+            sg_frame_stats sg_query_frame_stats(void)
+
+        ...this returns the number of sg_apply_*() and sg_draw() calls (where
+        each item of sg_draw_batch() counts as one draw call), the
+        number of bytes uploaded via sg_apply_uniforms(), sg_update_buffer(),
+        sg_append_buffer() and sg_update_image(), and (on the GL backends)
+        how many state changes the internal GL state cache has forwarded to
+        GL vs how many redundant state changes were filtered out. The counters
+        of the current frame are rolled over in sg_commit(), so the returned
+        stats are always those of the last completed frame.
+
+    --- on the GL core backend, with sg_desc.gpu_timings enabled, you can
+        inspect the GPU time spent in each pass and debug group via:
+
+            sg_gpu_timings sg_query_gpu_timings(void)
+
+        ...the results lag a few frames behind (see GPU TIMINGS).
+
+    --- CPU-side image processing code can average sRGB colors exactly like
+        the CPU mipmap generator with the lookup tables returned by:
+
+            sg_srgb_tables sg_query_srgb_tables(void)
+
+        ...this may be called from any thread, also before sg_setup().
+
 
     ON INITIALIZATION:
     ==================
@@ -665,6 +768,31 @@
     but for proper D3D11/Metal/GL a subset of the std140 layout must be used which is
     described in the next section:
 
+    Alternatively, the GL backends can upload a uniform block in a single operation
+    through a uniform buffer object. For this, the GLSL code must declare a
+    std140 uniform block:
+
+        layout(std140) uniform vs_params {
+            mat4 mvp;
+            vec2 offset0;
+            ...
+        };
+
+    ...and the uniform block desc must provide the name of the GLSL uniform block
+    and the std140 layout hint (the uniform block members are optional in this case):
+
+        sg_shader_desc desc = {
+            .vs.uniform_blocks[0] = {
+                .size = sizeof(params_t),
+                .layout = SG_UNIFORMLAYOUT_STD140,
+                .name = "vs_params",
+            }
+        };
+
+    The uniform data will then be copied into a per-frame uniform buffer (sized
+    by sg_desc.uniform_buffer_size, same as on Metal and WebGPU) and bound with
+    glBindBufferRange(), instead of calling glUniform*() for each block member.
+
 
     CROSS-BACKEND COMMON UNIFORM DATA LAYOUT
     ========================================
@@ -1028,6 +1156,171 @@
     listener item was found and removed, and false otherwise.
 
 
+    COMMAND LISTS
+    =============
+    Rendering commands can be recorded into command lists on any thread and
+    replayed later on the thread which owns the 3D context. This makes it
+    possible to spread scene traversal and draw submission over multiple
+    worker threads.
+
+    A command list records into memory owned by the caller, and nothing
+    is allocated:
+
+        static uint8_t memory[64 * 1024];
+        sg_command_list cmds = sg_begin_commands(&SG_RANGE(memory));
+
+    Then, on the worker thread, record commands with:
+
+        sg_cmd_apply_viewport(&cmds, x, y, width, height, origin_top_left);
+        sg_cmd_apply_scissor_rect(&cmds, x, y, width, height, origin_top_left);
+        sg_cmd_apply_pipeline(&cmds, pip);
+        sg_cmd_apply_bindings(&cmds, &bindings);
+        sg_cmd_apply_uniforms(&cmds, stage, ub_index, &SG_RANGE(params));
+        sg_cmd_draw(&cmds, base_element, num_elements, num_instances);
+        sg_cmd_draw_batch(&cmds, items, num_items);
+
+    The sg_cmd_*() functions only write into the command list memory and
+    never modify global sokol-gfx state, so different threads may record into
+    different command lists at the same time. Uniform data and draw items are
+    copied into the command list. Resource handles are looked up and validated
+    while recording: bindings and uniforms are checked against the last
+    pipeline recorded into the same command list, which must come first. If
+    that pipeline is still SG_RESOURCESTATE_PENDING, the checks happen during
+    replay instead. Resources must stay alive until the command list has been
+    submitted.
+
+    Back on the rendering thread, replay the commands inside a render pass:
+
+        sg_begin_default_pass(...);
+        sg_submit_commands(&cmds);
+        sg_end_pass();
+
+    Commands are replayed in recording order straight into the backend, only
+    the pipeline is checked against the current pass. Invalid commands skip
+    the following draws like their sg_apply_*() counterparts, frame stats are
+    counted as usual, but the trace hooks aren't called and replayed draws
+    are never merged (see sg_desc.merge_draws). If a command didn't fit into
+    the command list memory, the command list is marked as overflown and
+    sg_submit_commands() will log an error and drop the entire command list.
+
+    A command list can be submitted any number of times. To record new
+    commands, call sg_begin_commands() again.
+
+
+    PROGRAM BINARY CACHE
+    ====================
+    On the GL backends, compiling and linking GLSL sources in sg_make_shader()
+    can dominate the startup time of applications with many shaders. With a
+    cache directory provided in sg_setup(), linked programs are stored on disk
+    as driver-specific binaries (glGetProgramBinary()) and later launches load
+    them with glProgramBinary() instead of compiling:
+
+        sg_setup(&(sg_desc){
+            .program_cache_dir = "shader_cache",    // must exist and be writable
+        });
+
+    Cache entries are keyed by a hash of the vertex and fragment shader
+    sources, the vertex attribute names and the GL vendor, renderer and version
+    strings, so a driver update or an edited shader never picks up an old
+    entry. If the driver still rejects a cached binary, the shader is compiled
+    from source as usual and the entry is overwritten. Files which can't be
+    read or written are treated as cache misses and only produce a warning.
+
+    The cache requires GL_ARB_get_program_binary (core in GL 4.1) or GLES3
+    with at least one program binary format, otherwise sokol-gfx logs a warning and
+    compiles every shader. The other backends ignore .program_cache_dir.
+
+    How well the cache works can be inspected with:
+
+        sg_program_cache_stats sg_query_program_cache_stats(void)
+
+    ...which returns the number of cache hits, misses, rejected (stale)
+    entries and written entries since sg_setup(), together with the total
+    time spent creating programs from cached binaries and from source. The
+    time saved is roughly num_hits * (time_misses_us / num_misses) - time_hits_us.
+
+
+    ASYNCHRONOUS SHADER COMPILATION
+    ===============================
+    By default, sg_make_shader() on the GL backends checks the compile and link
+    status right away, which blocks until the driver has finished building the
+    program. When many shaders are created during loading, this serializes the
+    driver's shader compiler. With:
+
+        sg_setup(&(sg_desc){
+            .async_shader_compile = true,
+        });
+
+    ...sg_make_shader() only submits the sources and returns a shader in the
+    SG_RESOURCESTATE_PENDING state. Pipelines created with a pending shader are
+    PENDING as well. sg_commit() checks pending programs and moves them (and
+    their pipelines) into the VALID or FAILED state:
+
+        - with GL_KHR_parallel_shader_compile (or the ARB variant), the driver
+          compiles on its own threads and a program is finished as soon as
+          GL_COMPLETION_STATUS_KHR reports it as done
+        - without the extension, a program is finished in the first sg_commit()
+          of a later frame, limited by sg_desc.init_queue_budget_us (at least
+          one program per frame), so that drivers with a background compiler
+          get a frame of head start and the remaining stalls are spread out
+
+    Applying a PENDING pipeline is not an error: sg_apply_bindings() and
+    sg_apply_uniforms() are ignored and draws are skipped until the pipeline
+    is VALID, they are counted in sg_frame_stats.num_draw_pending. Use
+    sg_query_shader_state() and sg_query_pipeline_state() to wait for
+    shaders on a loading screen. Compile and link errors are logged when the
+    shader is finished in sg_commit().
+
+    Shaders which are loaded from the program binary cache are still created
+    synchronously, they don't need to be compiled. The other backends ignore
+    .async_shader_compile.
+
+
+    GPU TIMINGS
+    ===========
+    To find out where the GPU time of a frame goes without an external
+    profiler, enable timestamp queries in sg_setup():
+
+        sg_setup(&(sg_desc){
+            .gpu_timings = true,
+        });
+
+    Each pass and each sg_push_debug_group()/sg_pop_debug_group() pair then
+    writes a timestamp at its start and end. The queries come from a ring
+    which covers several frames, and sg_commit() only reads back the frames
+    whose results are already available, so the CPU never waits for the
+    GPU. The per-group tree of the latest completed frame is returned by:
+
+        sg_gpu_timings sg_query_gpu_timings(void)
+
+    for instance:
+
+        const sg_gpu_timings t = sg_query_gpu_timings();
+        if (t.valid) {
+            for (int i = 0; i < t.num_timings; i++) {
+                printf("%*s%s: %.3f ms\n", t.timings[i].depth * 2, "",
+                    t.timings[i].name, t.timings[i].time_ns / 1000000.0);
+            }
+        }
+
+    Passes show up as "pass" or "default pass", wrap them into a debug group
+    to give them a name. Debug groups can be used inside and outside of
+    passes, but they must be properly nested with the passes. With
+    sg_desc.merge_draws, a held back draw is issued before the timestamp, so
+    that it's attributed to the right group. Groups which are still open in
+    sg_commit() are closed there.
+
+    At most SG_MAX_GPU_TIMINGS passes and groups are measured per frame, the
+    rest is counted in sg_gpu_timings.num_dropped. When the GPU falls so far
+    behind that a frame's queries are reused before they have completed, the
+    frame is lost and counted in sg_gpu_timings.num_frames_lost.
+
+    GPU timings need GL_ARB_timer_query, which is core in OpenGL 3.3, so
+    they are only supported by the SOKOL_GLCORE33 backend. On the other
+    backends .gpu_timings is ignored (with a warning) and sg_gpu_timings.valid
+    always remains false.
+
+
     RESOURCE CREATION AND DESTRUCTION IN DETAIL
     ===========================================
     The 'vanilla' way to create resource objects is with the 'make functions':
@@ -1184,6 +1477,41 @@
     result in a pipeline object in FAILED state. Same when trying to create
     a pass object with image invalid image objects.
 
+    The 'alloc functions' and 'dealloc functions' are thread-safe, so that
+    for instance asset loader threads can reserve handles without involving
+    the rendering thread. All other functions must still be called from the
+    thread which owns the 3D context.
+
+    Instead of calling sg_init_buffer() or sg_init_image() directly, loader
+    threads can push the 'init work' for buffers and images into a queue:
+
+        bool sg_queue_init_buffer(sg_buffer buf, const sg_buffer_desc* desc)
+        bool sg_queue_init_image(sg_image img, const sg_image_desc* desc)
+
+    Both functions may be called from any thread, they copy the desc struct
+    into the queue and return false if the queue is full. The queued items
+    are processed inside sg_commit() on the rendering thread until the queue
+    is empty or the time budget for the current frame is used up (at least
+    one item is processed per frame). Note that only the desc struct itself
+    is copied, any data referenced by the desc struct (for instance image
+    pixel data) must remain valid until the resource has left the ALLOC
+    state.
+
+    The queue size and per-frame time budget are configured in sg_setup():
+
+        sg_setup(&(sg_desc){
+            .init_queue_size = 64,          // default: 64 items
+            .init_queue_budget_us = 2000,   // default: 2 milliseconds
+        });
+
+    The time budget is measured with a monotonic clock (QueryPerformanceCounter,
+    mach_absolute_time, emscripten_get_now or clock_gettime(CLOCK_MONOTONIC)).
+    When the implementation is compiled in strict ISO C mode on a POSIX
+    platform, sokol_gfx.h defines _POSIX_C_SOURCE to get clock_gettime(), this
+    only works if sokol_gfx.h is included before any system header in that
+    file, otherwise define _POSIX_C_SOURCE=199309L (or newer) on the command
+    line.
+
     LICENSE
     =======
     zlib/libpng license
@@ -1239,6 +1567,7 @@ extern "C" {
     sg_shader:      vertex- and fragment-shaders, uniform blocks
     sg_pipeline:    associated shader and vertex-layouts, and render states
     sg_pass:        a bundle of render targets and actions on them
+    sg_binding_set: a prevalidated set of resource bindings
     sg_context:     a 'context handle' for switching between 3D-API contexts
 
     Instead of pointers, resource creation functions return a 32-bit
@@ -1258,6 +1587,7 @@ typedef struct sg_image    { uint32_t id; } sg_image;
 typedef struct sg_shader   { uint32_t id; } sg_shader;
 typedef struct sg_pipeline { uint32_t id; } sg_pipeline;
 typedef struct sg_pass     { uint32_t id; } sg_pass;
+typedef struct sg_binding_set { uint32_t id; } sg_binding_set;
 typedef struct sg_context  { uint32_t id; } sg_context;
 
 /*
@@ -1297,7 +1627,8 @@ enum {
     SG_MAX_UB_MEMBERS = 16,
     SG_MAX_VERTEX_ATTRIBUTES = 16,
     SG_MAX_MIPMAPS = 16,
-    SG_MAX_TEXTUREARRAY_LAYERS = 128
+    SG_MAX_TEXTUREARRAY_LAYERS = 128,
+    SG_MAX_GPU_TIMINGS = 64
 };
 
 /*
@@ -1472,6 +1803,7 @@ typedef struct sg_features {
     bool image_clamp_to_border;         // border color and clamp-to-border UV-wrap mode is supported
     bool mrt_independent_blend_state;   // multiple-render-target rendering can use per-render-target blend state
     bool mrt_independent_write_mask;    // multiple-render-target rendering can use per-render-target color write masks
+    bool draw_base_vertex;              // sg_draw_item.base_vertex is supported in sg_draw_batch()
     #if defined(SOKOL_ZIG_BINDINGS)
     uint32_t __pad[3];
     #endif
@@ -1506,6 +1838,12 @@ typedef struct sg_limits {
     in the VALID state is attempted to be used for rendering, rendering
     operations will silently be dropped.
 
+    The PENDING state is only used for shaders and pipelines when
+    sg_desc.async_shader_compile is enabled: the GL driver is still compiling
+    and linking the program in the background, sg_commit() moves the resource
+    into the VALID or FAILED state once the program is ready. Draws with a
+    PENDING pipeline are skipped (see ASYNCHRONOUS SHADER COMPILATION).
+
     The special INVALID state is returned in sg_query_xxx_state() if no
     resource object exists for the provided resource id.
 */
@@ -1515,6 +1853,7 @@ typedef enum sg_resource_state {
     SG_RESOURCESTATE_VALID,
     SG_RESOURCESTATE_FAILED,
     SG_RESOURCESTATE_INVALID,
+    SG_RESOURCESTATE_PENDING,
     _SG_RESOURCESTATE_FORCE_U32 = 0x7FFFFFFF
 } sg_resource_state;
 
@@ -1540,6 +1879,26 @@ typedef enum sg_resource_state {
     CPU needs to wait for the GPU when attempting to update
     a resource that might be currently accessed by the GPU.
 
+    On the GL backend, SG_USAGE_STREAM buffers are persistently mapped
+    if GL_ARB_buffer_storage is available (GL 4.4 and up), updates are
+    then written directly into mapped memory and the CPU only waits
+    on a fence if it would overwrite data from a frame which is still
+    in flight. Mapped buffers get SG_NUM_INFLIGHT_FRAMES+1 slots, since the
+    slot which is rotated out may still be used by draws of the same frame,
+    so that a once-per-frame update doesn't wait for the previous frame.
+    Without the extension (or if mapping fails), the buffer storage is
+    'orphaned' before each update.
+
+    With the same extension, sg_update_image() copies the new content into
+    a persistently mapped ring of GL_PIXEL_UNPACK_BUFFER regions (one per
+    frame in flight, each sg_desc.staging_buffer_size bytes) and the
+    glTexSubImage*() calls read from there, so the driver can upload
+    asynchronously instead of copying from client memory before returning.
+    Updates which don't fit into the current frame's region fall back to
+    the direct upload. The counters in sg_frame_stats.gl tell which path
+    was taken, sg_frame_stats.size_update_image and .time_update_image_us
+    give the upload throughput seen by the CPU.
+
     Resource content is updated with the functions sg_update_buffer() or
     sg_append_buffer() for buffer objects, and sg_update_image() for image
     objects. For the sg_update_*() functions, only one update is allowed per
@@ -1616,6 +1975,34 @@ typedef enum sg_image_type {
     _SG_IMAGETYPE_FORCE_U32 = 0x7FFFFFFF
 } sg_image_type;
 
+/*
+    sg_mipmap_gen
+
+    Selects how the mipmap chain of an immutable texture is built when only
+    the content of the top level is provided (see sg_image_desc.generate_mipmaps):
+
+    SG_MIPMAPGEN_NONE:  no mipmaps are generated, all levels must be provided
+    SG_MIPMAPGEN_CPU:   sokol-gfx downsamples each level with a 2x2 box filter
+                        before the image is created, for SRGB8A8 images the
+                        color channels are averaged in linear space
+    SG_MIPMAPGEN_GPU:   only the top level is uploaded, the other levels are
+                        rendered by the 3D API (glGenerateMipmap() on GL),
+                        backends without GPU mipmap generation use the CPU path
+
+    Mipmap generation is supported for 2D and cube images in the 8-bit
+    formats R8, RG8, RGBA8, SRGB8A8 and BGRA8.
+
+    The default is SG_MIPMAPGEN_NONE.
+*/
+typedef enum sg_mipmap_gen {
+    _SG_MIPMAPGEN_DEFAULT,  /* value 0 reserved for default-init */
+    SG_MIPMAPGEN_NONE,
+    SG_MIPMAPGEN_CPU,
+    SG_MIPMAPGEN_GPU,
+    _SG_MIPMAPGEN_NUM,
+    _SG_MIPMAPGEN_FORCE_U32 = 0x7FFFFFFF
+} sg_mipmap_gen;
+
 /*
     sg_sampler_type
 
@@ -2103,6 +2490,14 @@ typedef enum sg_load_action {
 
     SG_STOREACTION_STORE:       store the rendered content to the color attachment image
     SG_STOREACTION_DONTCARE:    allows the GPU to discard the rendered content
+
+    On the GL backends, DONTCARE attachments are discarded with
+    glInvalidateFramebuffer() at the end of the pass (GLES3, GL 4.3 or
+    GL_ARB_invalidate_subdata), for multisampled color attachments this
+    happens after the MSAA resolve, so only the multisampled source is
+    discarded. The number of invalidated attachments and their size in
+    bytes are counted in sg_frame_stats.gl.num/size_invalidate_attachment,
+    divide by sg_frame_stats.num_passes for a per-pass value.
 */
 typedef enum sg_store_action {
     _SG_STOREACTION_DEFAULT,
@@ -2184,6 +2579,24 @@ typedef struct sg_bindings {
     uint32_t _end_canary;
 } sg_bindings;
 
+/*
+    sg_draw_item
+
+    One draw call in the array passed to sg_draw_batch(), base_element,
+    num_elements and num_instances are the same as in sg_draw().
+
+    The base_vertex is added to each index before vertices are fetched
+    from the vertex buffers (for non-indexed rendering it is added to
+    base_element). This is only supported if sg_features.draw_base_vertex
+    is true, otherwise base_vertex must be zero.
+*/
+typedef struct sg_draw_item {
+    int base_element;
+    int num_elements;
+    int num_instances;
+    int base_vertex;
+} sg_draw_item;
+
 /*
     sg_buffer_desc
 
@@ -2278,7 +2691,8 @@ typedef struct sg_image_data {
     .width              0 (must be set to >0)
     .height             0 (must be set to >0)
     .num_slices         1 (3D textures: depth; array textures: number of layers)
-    .num_mipmaps:       1
+    .num_mipmaps:       1, or the full mipmap chain down to 1x1 when mipmaps are generated
+    .generate_mipmaps:  SG_MIPMAPGEN_NONE
     .usage:             SG_USAGE_IMMUTABLE
     .pixel_format:      SG_PIXELFORMAT_RGBA8 for textures, or sg_desc.context.color_format for render targets
     .sample_count:      1 for textures, or sg_desc.context.sample_count for render targets
@@ -2307,6 +2721,17 @@ typedef struct sg_image_data {
 
     Images with usage SG_USAGE_IMMUTABLE must be fully initialized by
     providing a valid .data member which points to initialization data.
+    With .generate_mipmaps set to SG_MIPMAPGEN_CPU or SG_MIPMAPGEN_GPU, only
+    the top level (.data.subimage[face][0]) is needed, see sg_mipmap_gen.
+
+    On the GL, Metal and WGPU backends, images with identical sampler state
+    (.min_filter to .max_lod) share one sampler object, on GL this is a
+    glGenSamplers() object which is bound next to the texture. The
+    number of unique sampler states is limited by sg_desc.sampler_cache_size,
+    on GL images beyond that fall back to per-texture parameters. GL textures
+    created by sokol-gfx therefore keep the GL default texture parameters when
+    they are used by external GL code. Injected GL textures never use a sampler
+    object and are sampled with their own texture parameters.
 
     ADVANCED TOPIC: Injecting native 3D-API textures:
 
@@ -2338,6 +2763,7 @@ typedef struct sg_image_desc {
     int height;
     int num_slices;
     int num_mipmaps;
+    sg_mipmap_gen generate_mipmaps;
     sg_usage usage;
     sg_pixel_format pixel_format;
     int sample_count;
@@ -2415,6 +2841,7 @@ typedef struct sg_shader_uniform_desc {
 typedef struct sg_shader_uniform_block_desc {
     size_t size;
     sg_uniform_layout layout;
+    const char* name;           // GLSL uniform block name (optional, GL only: update via uniform buffer)
     sg_shader_uniform_desc uniforms[SG_MAX_UB_MEMBERS];
 } sg_shader_uniform_block_desc;
 
@@ -2657,11 +3084,13 @@ typedef struct sg_trace_hooks {
     void (*make_shader)(const sg_shader_desc* desc, sg_shader result, void* user_data);
     void (*make_pipeline)(const sg_pipeline_desc* desc, sg_pipeline result, void* user_data);
     void (*make_pass)(const sg_pass_desc* desc, sg_pass result, void* user_data);
+    void (*make_binding_set)(const sg_bindings* bindings, sg_binding_set result, void* user_data);
     void (*destroy_buffer)(sg_buffer buf, void* user_data);
     void (*destroy_image)(sg_image img, void* user_data);
     void (*destroy_shader)(sg_shader shd, void* user_data);
     void (*destroy_pipeline)(sg_pipeline pip, void* user_data);
     void (*destroy_pass)(sg_pass pass, void* user_data);
+    void (*destroy_binding_set)(sg_binding_set bset, void* user_data);
     void (*update_buffer)(sg_buffer buf, const sg_range* data, void* user_data);
     void (*update_image)(sg_image img, const sg_image_data* data, void* user_data);
     void (*append_buffer)(sg_buffer buf, const sg_range* data, int result, void* user_data);
@@ -2671,8 +3100,10 @@ typedef struct sg_trace_hooks {
     void (*apply_scissor_rect)(int x, int y, int width, int height, bool origin_top_left, void* user_data);
     void (*apply_pipeline)(sg_pipeline pip, void* user_data);
     void (*apply_bindings)(const sg_bindings* bindings, void* user_data);
+    void (*apply_binding_set)(sg_binding_set bset, void* user_data);
     void (*apply_uniforms)(sg_shader_stage stage, int ub_index, const sg_range* data, void* user_data);
     void (*draw)(int base_element, int num_elements, int num_instances, void* user_data);
+    void (*draw_batch)(const sg_draw_item* items, int num_items, void* user_data);
     void (*end_pass)(void* user_data);
     void (*commit)(void* user_data);
     void (*alloc_buffer)(sg_buffer result, void* user_data);
@@ -2707,6 +3138,7 @@ typedef struct sg_trace_hooks {
     void (*err_shader_pool_exhausted)(void* user_data);
     void (*err_pipeline_pool_exhausted)(void* user_data);
     void (*err_pass_pool_exhausted)(void* user_data);
+    void (*err_binding_set_pool_exhausted)(void* user_data);
     void (*err_context_mismatch)(void* user_data);
     void (*err_pass_invalid)(void* user_data);
     void (*err_draw_invalid)(void* user_data);
@@ -2769,6 +3201,149 @@ typedef struct sg_pass_info {
     sg_slot_info slot;              /* resource pool slot info */
 } sg_pass_info;
 
+/*
+    sg_pool_info, sg_pools_info
+
+    Returned by sg_query_pools_info(), contains the current size and usage
+    of each resource pool. The high_water_mark is the maximum number of
+    slots which have been in use at the same time since sg_setup(). Note
+    that the reserved slot 0 of each pool is not included in the counts.
+*/
+typedef struct sg_pool_info {
+    int size;               /* current number of slots in the pool */
+    int num_chunks;         /* number of allocated chunks (1 == pool never had to grow) */
+    int num_used;           /* number of currently allocated slots */
+    int high_water_mark;    /* max number of slots which were allocated at the same time */
+} sg_pool_info;
+
+typedef struct sg_pools_info {
+    sg_pool_info buffers;
+    sg_pool_info images;
+    sg_pool_info shaders;
+    sg_pool_info pipelines;
+    sg_pool_info passes;
+    sg_pool_info binding_sets;
+    sg_pool_info contexts;
+} sg_pools_info;
+
+/*
+    sg_program_cache_stats
+
+    Returned by sg_query_program_cache_stats(), counts the shaders created
+    since sg_setup() with the GL program binary cache enabled (see PROGRAM
+    BINARY CACHE). All counters are zero if the cache isn't used.
+*/
+typedef struct sg_program_cache_stats {
+    uint32_t num_hits;          /* programs created from a cached binary */
+    uint32_t num_misses;        /* programs compiled from source, including stale entries */
+    uint32_t num_stale;         /* cached binaries rejected by the driver */
+    uint32_t num_stored;        /* program binaries written to the cache directory */
+    uint64_t time_hits_us;      /* time spent creating programs from cached binaries */
+    uint64_t time_misses_us;    /* time spent compiling and linking programs from source */
+} sg_program_cache_stats;
+
+/*
+    sg_srgb_tables
+
+    Returned by sg_query_srgb_tables(), the constant tables which the CPU
+    mipmap generator uses to average SRGB8A8 colors as 12-bit linear
+    values. A linear value l converts back to the largest i with
+    from_linear[i] <= l.
+*/
+typedef struct sg_srgb_tables {
+    const uint16_t* to_linear;      /* [256] sRGB 8-bit -> linear 12-bit */
+    const uint16_t* from_linear;    /* [256] smallest linear 12-bit value which rounds to sRGB 8-bit value i */
+} sg_srgb_tables;
+
+/*
+    sg_frame_stats
+
+    Returned by sg_query_frame_stats(), contains counters collected
+    during the previous frame (between the two last calls to sg_commit()).
+
+    The nested sg_frame_stats_gl struct is only populated by the GL
+    backends and counts the GL calls issued by the internal state cache,
+    together with the number of state changes which were skipped because
+    the cached state already matched.
+*/
+typedef struct sg_frame_stats_gl {
+    uint32_t num_bind_buffer;               /* glBindBuffer() calls */
+    uint32_t num_bind_buffer_skipped;       /* redundant buffer bindings filtered by the state cache */
+    uint32_t num_active_texture;            /* glActiveTexture() calls */
+    uint32_t num_active_texture_skipped;
+    uint32_t num_bind_texture;              /* glBindTexture() calls */
+    uint32_t num_bind_texture_skipped;
+    uint32_t num_bind_sampler;              /* glBindSampler() calls */
+    uint32_t num_bind_sampler_skipped;
+    uint32_t num_use_program;               /* glUseProgram() calls */
+    uint32_t num_use_program_skipped;
+    uint32_t num_render_state;              /* depth-, stencil-, blend- and rasterizer-state calls */
+    uint32_t num_render_state_skipped;      /* render state blocks skipped because the state hashes matched */
+    uint32_t num_bind_vertex_array;         /* glBindVertexArray() calls */
+    uint32_t num_bind_vertex_array_skipped;
+    uint32_t num_vertex_attrib;             /* glVertexAttribPointer/Divisor and glEnable/DisableVertexAttribArray() calls */
+    uint32_t num_vertex_attrib_skipped;     /* vertex attributes which didn't need an update (VAO cache hits) */
+    uint32_t num_uniform;                   /* glUniform*() calls */
+    uint32_t num_uniform_buffer_update;     /* uniform blocks copied into the uniform buffer ring */
+    uint32_t num_apply_pipeline_skipped;    /* sg_apply_pipeline() with the already applied pipeline */
+    uint32_t num_image_upload_staged;       /* image surfaces uploaded through the pixel unpack buffer ring */
+    uint32_t size_image_upload_staged;
+    uint32_t num_image_upload_direct;       /* image surfaces uploaded straight from client memory */
+    uint32_t num_invalidate_attachment;     /* pass attachments discarded with glInvalidateFramebuffer() (SG_STOREACTION_DONTCARE) */
+    uint32_t size_invalidate_attachment;    /* bytes of those attachments the driver doesn't need to write back */
+} sg_frame_stats_gl;
+
+typedef struct sg_frame_stats {
+    uint32_t frame_index;           /* frame index the stats have been collected in */
+    uint32_t num_passes;
+    uint32_t num_apply_pipeline;
+    uint32_t num_apply_bindings;
+    uint32_t num_apply_uniforms;
+    uint32_t num_draw;
+    uint32_t num_draw_batch;        /* number of sg_draw_batch() calls, each item also counts in num_draw */
+    uint32_t num_draw_merged;       /* number of sg_draw() calls merged into the previous draw (sg_desc.merge_draws) */
+    uint32_t num_draw_pending;      /* draws skipped because the applied pipeline is still SG_RESOURCESTATE_PENDING */
+    uint32_t num_update_buffer;
+    uint32_t num_append_buffer;
+    uint32_t num_update_image;
+    uint32_t size_apply_uniforms;   /* number of bytes passed into sg_apply_uniforms() */
+    uint32_t size_update_buffer;
+    uint32_t size_append_buffer;
+    uint32_t size_update_image;
+    uint32_t time_update_image_us;  /* CPU time spent in sg_update_image(), size_update_image / time is the upload throughput */
+    sg_frame_stats_gl gl;
+} sg_frame_stats;
+
+/*
+    sg_gpu_timings
+
+    Returned by sg_query_gpu_timings() when sg_desc.gpu_timings is enabled,
+    contains the GPU time of each pass and debug group of the most recent
+    frame whose timestamp queries have completed, which is usually two or
+    three frames behind the current frame (see GPU TIMINGS).
+
+    The items are stored in the order in which the passes and debug groups
+    were started, so that each item comes after its parent. The tree can be
+    rebuilt from the .parent indices, or printed as it is with .depth as
+    indentation.
+*/
+typedef struct sg_gpu_timing {
+    const char* name;       /* debug group name, or "pass" and "default pass", valid until the next sg_commit() */
+    int parent;             /* index of the enclosing pass or debug group, -1 at the top level */
+    int depth;              /* nesting depth, 0 at the top level */
+    uint64_t time_ns;       /* GPU time between the begin and end timestamps */
+} sg_gpu_timing;
+
+typedef struct sg_gpu_timings {
+    bool valid;                 /* false until the results of the first frame have been read back */
+    uint32_t frame_index;       /* frame the timings have been measured in */
+    uint64_t frame_time_ns;     /* GPU time from the first to the last timestamp of that frame */
+    uint32_t num_dropped;       /* passes and debug groups which didn't fit into SG_MAX_GPU_TIMINGS */
+    uint32_t num_frames_lost;   /* frames overwritten before their results were available (since sg_setup) */
+    int num_timings;
+    sg_gpu_timing timings[SG_MAX_GPU_TIMINGS];
+} sg_gpu_timings;
+
 /*
     sg_log_item
 
@@ -2785,6 +3360,17 @@ typedef struct sg_pass_info {
     _SG_LOGITEM_XMACRO(GL_SHADER_LINKING_FAILED, "shader linking failed (gl)") \
     _SG_LOGITEM_XMACRO(GL_VERTEX_ATTRIBUTE_NOT_FOUND_IN_SHADER, "vertex attribute not found in shader (gl)") \
     _SG_LOGITEM_XMACRO(GL_TEXTURE_NAME_NOT_FOUND_IN_SHADER, "texture name not found in shader (gl)") \
+    _SG_LOGITEM_XMACRO(GL_UNIFORMBLOCK_NAME_NOT_FOUND_IN_SHADER, "uniform block name not found in shader (gl)") \
+    _SG_LOGITEM_XMACRO(GL_UNIFORMBLOCK_SIZE_MISMATCH, "uniform block in shader is bigger than sg_shader_uniform_block_desc.size (gl)") \
+    _SG_LOGITEM_XMACRO(GL_UNIFORMBUFFER_OVERFLOW, "per-frame uniform buffer overflow, increase sg_desc.uniform_buffer_size (gl)") \
+    _SG_LOGITEM_XMACRO(GL_UNIFORMBLOCK_TOO_BIG, "uniform block is bigger than its sg_shader_uniform_block_desc.size or sg_desc.uniform_buffer_size (gl)") \
+    _SG_LOGITEM_XMACRO(GL_MAP_BUFFER_STORAGE_FAILED, "failed to persistently map stream buffer, falling back to glBufferData() (gl)") \
+    _SG_LOGITEM_XMACRO(GL_UNPACK_BUFFER_MAP_FAILED, "failed to persistently map pixel unpack buffer, sg_update_image() uploads from client memory (gl)") \
+    _SG_LOGITEM_XMACRO(GL_UNPACK_BUFFER_FULL, "per-frame pixel unpack buffer full, increase sg_desc.staging_buffer_size (gl)") \
+    _SG_LOGITEM_XMACRO(GL_PROGRAM_CACHE_UNSUPPORTED, "program binaries not supported, sg_desc.program_cache_dir is ignored (gl)") \
+    _SG_LOGITEM_XMACRO(GL_PROGRAM_CACHE_DIR_TOO_LONG, "sg_desc.program_cache_dir is too long, the program binary cache is disabled (gl)") \
+    _SG_LOGITEM_XMACRO(GL_PROGRAM_CACHE_WRITE_FAILED, "failed to write program binary cache entry (gl)") \
+    _SG_LOGITEM_XMACRO(GL_SAMPLER_CACHE_FULL, "sampler cache full, increase sg_desc.sampler_cache_size, falling back to texture parameters (gl)") \
     _SG_LOGITEM_XMACRO(GL_FRAMEBUFFER_INCOMPLETE, "framebuffer completeness check failed (gl)") \
     _SG_LOGITEM_XMACRO(GL_MSAA_FRAMEBUFFER_INCOMPLETE, "completeness check failed for msaa resolve framebuffer (gl)") \
     _SG_LOGITEM_XMACRO(D3D11_CREATE_BUFFER_FAILED, "CreateBuffer() failed (d3d11)") \
@@ -2857,7 +3443,10 @@ typedef struct sg_pass_info {
     _SG_LOGITEM_XMACRO(SHADER_POOL_EXHAUSTED, "shader pool exhausted") \
     _SG_LOGITEM_XMACRO(PIPELINE_POOL_EXHAUSTED, "pipeline pool exhausted") \
     _SG_LOGITEM_XMACRO(PASS_POOL_EXHAUSTED, "pass pool exhausted") \
+    _SG_LOGITEM_XMACRO(BINDING_SET_POOL_EXHAUSTED, "binding set pool exhausted") \
     _SG_LOGITEM_XMACRO(DRAW_WITHOUT_BINDINGS, "attempting to draw without resource bindings") \
+    _SG_LOGITEM_XMACRO(COMMAND_LIST_OVERFLOW, "command list overflow, increase the memory passed into sg_begin_commands()") \
+    _SG_LOGITEM_XMACRO(GPU_TIMINGS_NOT_SUPPORTED, "sg_desc.gpu_timings is only supported on the GL core backend, ignored") \
     _SG_LOGITEM_XMACRO(VALIDATE_BUFFERDESC_CANARY, "sg_buffer_desc not initialized") \
     _SG_LOGITEM_XMACRO(VALIDATE_BUFFERDESC_SIZE, "sg_buffer_desc.size and .data.size cannot both be 0") \
     _SG_LOGITEM_XMACRO(VALIDATE_BUFFERDESC_DATA, "immutable buffers must be initialized with data (sg_buffer_desc.data.ptr and sg_buffer_desc.data.size)") \
@@ -2880,6 +3469,9 @@ typedef struct sg_pass_info {
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_INJECTED_NO_DATA, "images with injected textures cannot be initialized with data") \
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_DYNAMIC_NO_DATA, "dynamic/stream images cannot be initialized with data") \
     _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_COMPRESSED_IMMUTABLE, "compressed images must be immutable") \
+    _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_MIPMAPGEN_IMMUTABLE, "generated mipmaps require an immutable image which isn't a render target or injected") \
+    _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_MIPMAPGEN_TYPE, "generated mipmaps require a 2D or cube image") \
+    _SG_LOGITEM_XMACRO(VALIDATE_IMAGEDESC_MIPMAPGEN_PIXELFORMAT, "generated mipmaps require an R8, RG8, RGBA8, SRGB8A8 or BGRA8 image") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_CANARY, "sg_shader_desc not initialized") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_SOURCE, "shader source code required") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_BYTECODE, "shader byte code required") \
@@ -2892,6 +3484,7 @@ typedef struct sg_pass_info {
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_UB_SIZE_MISMATCH, "size of uniform block members doesn't match uniform block size") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_UB_ARRAY_COUNT, "uniform array count must be >= 1") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_UB_STD140_ARRAY_TYPE, "uniform arrays only allowed for FLOAT4, INT4, MAT4 in std140 layout") \
+    _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_UB_NAME_STD140, "uniform blocks with a GLSL block name must use SG_UNIFORMLAYOUT_STD140") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_NO_CONT_IMGS, "shader images must occupy continuous slots") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_IMG_NAME, "GL backend requires uniform block member names") \
     _SG_LOGITEM_XMACRO(VALIDATE_SHADERDESC_ATTR_SEMANTICS, "D3D11 backend requires vertex attribute semantics") \
@@ -2967,6 +3560,12 @@ typedef struct sg_pass_info {
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_FS_IMG_TYPES, "sg_apply_bindings: one or more fragment shader image types don't match sg_shader_desc") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_FS_IMG_MSAA, "sg_apply_bindings: cannot bind image with sample_count>1 to fragment stage") \
     _SG_LOGITEM_XMACRO(VALIDATE_ABND_FS_IMG_DEPTH, "sg_apply_bindings: cannot bind depth/stencil image to fragment stage") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BSETDESC_CANARY, "sg_make_binding_set: sg_bindings not initialized") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BSETDESC_VB_TYPE, "sg_make_binding_set: buffer in vertex buffer slot is not a SG_BUFFERTYPE_VERTEXBUFFER") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BSETDESC_IB_TYPE, "sg_make_binding_set: buffer in index buffer slot is not a SG_BUFFERTYPE_INDEXBUFFER") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BSETDESC_IMG_MSAA, "sg_make_binding_set: cannot bind image with sample_count>1 as texture") \
+    _SG_LOGITEM_XMACRO(VALIDATE_BSETDESC_IMG_DEPTH, "sg_make_binding_set: cannot bind depth/stencil image as texture") \
+    _SG_LOGITEM_XMACRO(VALIDATE_ABSET_EXISTS, "sg_apply_binding_set: binding set object no longer alive") \
     _SG_LOGITEM_XMACRO(VALIDATE_AUB_NO_PIPELINE, "sg_apply_uniforms: must be called after sg_apply_pipeline()") \
     _SG_LOGITEM_XMACRO(VALIDATE_AUB_NO_UB_AT_SLOT, "sg_apply_uniforms: no uniform block declaration at this shader stage UB slot") \
     _SG_LOGITEM_XMACRO(VALIDATE_AUB_SIZE, "sg_apply_uniforms: data size exceeds declared uniform block size") \
@@ -3000,6 +3599,13 @@ typedef enum sg_log_item {
 
     FIXME: explain the various configuration options
 
+    The *_pool_size items are the initial number of resource slots of each
+    pool. When a pool runs out of free slots it grows by another chunk of the
+    same size (up to 64 chunks and a total of 65535 slots). Existing resource
+    handles and internal resource pointers remain valid when a pool grows. Use
+    sg_query_pools_info() to find out how many slots your application actually
+    needs and size the pools accordingly.
+
     The default configuration is:
 
     .buffer_pool_size       128
@@ -3007,12 +3613,21 @@ typedef enum sg_log_item {
     .shader_pool_size       32
     .pipeline_pool_size     64
     .pass_pool_size         16
+    .binding_set_pool_size  128
     .context_pool_size      16
-    .uniform_buffer_size    4 MB (4*1024*1024)
-    .staging_buffer_size    8 MB (8*1024*1024)
+    .uniform_buffer_size    4 MB (4*1024*1024), on GL only allocated when uniform blocks
+                            with a GLSL block name are used
+    .staging_buffer_size    8 MB (8*1024*1024), on GL the per-frame size of the pixel unpack
+                            buffer ring used by sg_update_image(), allocated on first use
     .sampler_cache_size     64
     .max_commit_listeners   1024
+    .init_queue_size        64
+    .init_queue_budget_us   2000 (time spent on queued sg_init_buffer/image() calls per sg_commit())
     .disable_validation     false
+    .merge_draws            false (merge adjacent sg_draw() calls with identical state, see sg_draw())
+    .program_cache_dir      0 (GL only: directory for cached program binaries, see PROGRAM BINARY CACHE)
+    .async_shader_compile   false (GL only: don't wait for shader compilation, see ASYNCHRONOUS SHADER COMPILATION)
+    .gpu_timings            false (GL core only: timestamp queries for passes and debug groups, see GPU TIMINGS)
 
     .allocator.alloc        0 (in this case, malloc() will be called)
     .allocator.free         0 (in this case, free() will be called)
@@ -3151,6 +3766,22 @@ typedef struct sg_commit_listener {
     void* user_data;
 } sg_commit_listener;
 
+/*
+    sg_command_list
+
+    Returned by sg_begin_commands(), records rendering commands into
+    caller-provided memory for a later sg_submit_commands(). Treat
+    the content as opaque. See the section COMMAND LISTS for details.
+*/
+typedef struct sg_command_list {
+    uint8_t* ptr;       // start of the recording memory
+    size_t size;        // size of the recording memory in bytes
+    size_t pos;         // number of bytes recorded so far
+    int num_commands;
+    uint32_t pipeline_id;   // the last recorded pipeline, bindings and uniforms are checked against it
+    bool overflow;      // true if a command didn't fit into the recording memory
+} sg_command_list;
+
 /*
     sg_allocator
 
@@ -3194,12 +3825,19 @@ typedef struct sg_desc {
     int shader_pool_size;
     int pipeline_pool_size;
     int pass_pool_size;
+    int binding_set_pool_size;
     int context_pool_size;
     int uniform_buffer_size;
     int staging_buffer_size;
     int sampler_cache_size;
     int max_commit_listeners;
+    int init_queue_size;        // max number of items queued with sg_queue_init_buffer/image()
+    int init_queue_budget_us;   // time budget for processing the init queue in sg_commit()
     bool disable_validation;    // disable validation layer even in debug mode, useful for tests
+    bool merge_draws;           // merge adjacent sg_draw() calls with identical state
+    const char* program_cache_dir;  // GL only: directory for cached program binaries
+    bool async_shader_compile;      // GL only: shaders and pipelines start in the PENDING state
+    bool gpu_timings;               // GL core only: measure passes and debug groups, see sg_query_gpu_timings()
     sg_allocator allocator;
     sg_logger logger; // optional log function override
     sg_context_desc context;
@@ -3223,11 +3861,13 @@ SOKOL_GFX_API_DECL sg_image sg_make_image(const sg_image_desc* desc);
 SOKOL_GFX_API_DECL sg_shader sg_make_shader(const sg_shader_desc* desc);
 SOKOL_GFX_API_DECL sg_pipeline sg_make_pipeline(const sg_pipeline_desc* desc);
 SOKOL_GFX_API_DECL sg_pass sg_make_pass(const sg_pass_desc* desc);
+SOKOL_GFX_API_DECL sg_binding_set sg_make_binding_set(const sg_bindings* bindings);
 SOKOL_GFX_API_DECL void sg_destroy_buffer(sg_buffer buf);
 SOKOL_GFX_API_DECL void sg_destroy_image(sg_image img);
 SOKOL_GFX_API_DECL void sg_destroy_shader(sg_shader shd);
 SOKOL_GFX_API_DECL void sg_destroy_pipeline(sg_pipeline pip);
 SOKOL_GFX_API_DECL void sg_destroy_pass(sg_pass pass);
+SOKOL_GFX_API_DECL void sg_destroy_binding_set(sg_binding_set bset);
 SOKOL_GFX_API_DECL void sg_update_buffer(sg_buffer buf, const sg_range* data);
 SOKOL_GFX_API_DECL void sg_update_image(sg_image img, const sg_image_data* data);
 SOKOL_GFX_API_DECL int sg_append_buffer(sg_buffer buf, const sg_range* data);
@@ -3244,23 +3884,42 @@ SOKOL_GFX_API_DECL void sg_apply_scissor_rect(int x, int y, int width, int heigh
 SOKOL_GFX_API_DECL void sg_apply_scissor_rectf(float x, float y, float width, float height, bool origin_top_left);
 SOKOL_GFX_API_DECL void sg_apply_pipeline(sg_pipeline pip);
 SOKOL_GFX_API_DECL void sg_apply_bindings(const sg_bindings* bindings);
+SOKOL_GFX_API_DECL void sg_apply_binding_set(sg_binding_set bset);
 SOKOL_GFX_API_DECL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data);
 SOKOL_GFX_API_DECL void sg_draw(int base_element, int num_elements, int num_instances);
+SOKOL_GFX_API_DECL void sg_draw_batch(const sg_draw_item* items, int num_items);
 SOKOL_GFX_API_DECL void sg_end_pass(void);
 SOKOL_GFX_API_DECL void sg_commit(void);
 
+/* command lists, the recording functions may be called from any thread */
+SOKOL_GFX_API_DECL sg_command_list sg_begin_commands(const sg_range* memory);
+SOKOL_GFX_API_DECL void sg_cmd_apply_viewport(sg_command_list* cmds, int x, int y, int width, int height, bool origin_top_left);
+SOKOL_GFX_API_DECL void sg_cmd_apply_scissor_rect(sg_command_list* cmds, int x, int y, int width, int height, bool origin_top_left);
+SOKOL_GFX_API_DECL void sg_cmd_apply_pipeline(sg_command_list* cmds, sg_pipeline pip);
+SOKOL_GFX_API_DECL void sg_cmd_apply_bindings(sg_command_list* cmds, const sg_bindings* bindings);
+SOKOL_GFX_API_DECL void sg_cmd_apply_uniforms(sg_command_list* cmds, sg_shader_stage stage, int ub_index, const sg_range* data);
+SOKOL_GFX_API_DECL void sg_cmd_draw(sg_command_list* cmds, int base_element, int num_elements, int num_instances);
+SOKOL_GFX_API_DECL void sg_cmd_draw_batch(sg_command_list* cmds, const sg_draw_item* items, int num_items);
+SOKOL_GFX_API_DECL void sg_submit_commands(const sg_command_list* cmds);
+
 /* getting information */
 SOKOL_GFX_API_DECL sg_desc sg_query_desc(void);
 SOKOL_GFX_API_DECL sg_backend sg_query_backend(void);
 SOKOL_GFX_API_DECL sg_features sg_query_features(void);
 SOKOL_GFX_API_DECL sg_limits sg_query_limits(void);
 SOKOL_GFX_API_DECL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt);
+SOKOL_GFX_API_DECL sg_frame_stats sg_query_frame_stats(void);
+SOKOL_GFX_API_DECL sg_gpu_timings sg_query_gpu_timings(void);
+SOKOL_GFX_API_DECL sg_pools_info sg_query_pools_info(void);
+SOKOL_GFX_API_DECL sg_program_cache_stats sg_query_program_cache_stats(void);
+SOKOL_GFX_API_DECL sg_srgb_tables sg_query_srgb_tables(void);
 /* get current state of a resource (INITIAL, ALLOC, VALID, FAILED, INVALID) */
 SOKOL_GFX_API_DECL sg_resource_state sg_query_buffer_state(sg_buffer buf);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_image_state(sg_image img);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_shader_state(sg_shader shd);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_pipeline_state(sg_pipeline pip);
 SOKOL_GFX_API_DECL sg_resource_state sg_query_pass_state(sg_pass pass);
+SOKOL_GFX_API_DECL sg_resource_state sg_query_binding_set_state(sg_binding_set bset);
 /* get runtime information about a resource */
 SOKOL_GFX_API_DECL sg_buffer_info sg_query_buffer_info(sg_buffer buf);
 SOKOL_GFX_API_DECL sg_image_info sg_query_image_info(sg_image img);
@@ -3306,6 +3965,8 @@ SOKOL_GFX_API_DECL void sg_fail_image(sg_image img);
 SOKOL_GFX_API_DECL void sg_fail_shader(sg_shader shd);
 SOKOL_GFX_API_DECL void sg_fail_pipeline(sg_pipeline pip);
 SOKOL_GFX_API_DECL void sg_fail_pass(sg_pass pass);
+SOKOL_GFX_API_DECL bool sg_queue_init_buffer(sg_buffer buf, const sg_buffer_desc* desc);
+SOKOL_GFX_API_DECL bool sg_queue_init_image(sg_image img, const sg_image_desc* desc);
 
 /* rendering contexts (optional) */
 SOKOL_GFX_API_DECL sg_context sg_setup_context(void);
@@ -3496,6 +4157,7 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
     #endif
 #elif defined(SOKOL_GLCORE33) || defined(SOKOL_GLES3)
     #define _SOKOL_ANY_GL (1)
+    #include <stdio.h>  // fopen, fread, fwrite for the program binary cache
 
     // include platform specific GL headers (or on Win32: use an embedded GL loader)
     #if !defined(SOKOL_EXTERNAL_GL_LOADER)
@@ -3566,6 +4228,7 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         typedef int64_t  GLint64;
         typedef float  GLfloat;
         typedef int  GLint;
+        typedef struct __GLsync* GLsync;
         #define GL_INT_2_10_10_10_REV 0x8D9F
         #define GL_R32F 0x822E
         #define GL_PROGRAM_POINT_SIZE 0x8642
@@ -3632,6 +4295,7 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         #define GL_FRAGMENT_SHADER 0x8B30
         #define GL_FLOAT 0x1406
         #define GL_TEXTURE_MAX_LOD 0x813B
+        #define GL_TEXTURE_MAX_LEVEL 0x813D
         #define GL_DEPTH_COMPONENT 0x1902
         #define GL_ONE_MINUS_DST_ALPHA 0x0305
         #define GL_COLOR 0x1800
@@ -3769,6 +4433,26 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
         #define GL_MAX_VERTEX_UNIFORM_VECTORS 0x8DFB
         #define GL_UNPACK_ALIGNMENT 0x0CF5
         #define GL_FRAMEBUFFER_SRGB 0x8DB9
+        #define GL_UNIFORM_BUFFER 0x8A11
+        #define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+        #define GL_UNIFORM_BLOCK_DATA_SIZE 0x8A40
+        #define GL_INVALID_INDEX 0xFFFFFFFFu
+        #define GL_MAP_WRITE_BIT 0x0002
+        #define GL_MAP_PERSISTENT_BIT 0x0040
+        #define GL_MAP_COHERENT_BIT 0x0080
+        #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+        #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+        #define GL_TIMEOUT_EXPIRED 0x911B
+        #define GL_WAIT_FAILED 0x911D
+        #define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+        #define GL_PIXEL_UNPACK_BUFFER 0x88EC
+        #define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+        #define GL_PROGRAM_BINARY_LENGTH 0x8741
+        #define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+        #define GL_STENCIL_ATTACHMENT 0x8D20
+        #define GL_TIMESTAMP 0x8E28
+        #define GL_QUERY_RESULT 0x8866
+        #define GL_QUERY_RESULT_AVAILABLE 0x8867
     #endif
 
     #ifndef GL_UNSIGNED_INT_2_10_10_10_REV
@@ -3780,6 +4464,9 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
     #ifndef GL_TEXTURE_MAX_ANISOTROPY_EXT
     #define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
     #endif
+    #ifndef GL_COMPLETION_STATUS_KHR
+    #define GL_COMPLETION_STATUS_KHR 0x91B1
+    #endif
     #ifndef GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT
     #define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT 0x84FF
     #endif
@@ -3855,9 +4542,49 @@ inline int sg_append_buffer(sg_buffer buf_id, const sg_range& data) { return sg_
     #ifndef GL_LUMINANCE
     #define GL_LUMINANCE 0x1909
     #endif
+    // persistently mapped buffers require GL 4.4 or GL_ARB_buffer_storage
+    #if defined(SOKOL_GLCORE33) && (defined(_SOKOL_USE_WIN32_GL_LOADER) || defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage))
+    #define _SOKOL_GL_HAS_BUFFER_STORAGE (1)
+    #endif
+    // batched instanced draws require GL 4.3 or GL_ARB_multi_draw_indirect
+    #if defined(SOKOL_GLCORE33) && (defined(_SOKOL_USE_WIN32_GL_LOADER) || defined(GL_VERSION_4_3) || defined(GL_ARB_multi_draw_indirect))
+    #define _SOKOL_GL_HAS_MULTI_DRAW_INDIRECT (1)
+    #endif
+    // the program binary cache requires GL 4.1, GL_ARB_get_program_binary or GLES3
+    #if defined(SOKOL_GLES3) || (defined(SOKOL_GLCORE33) && (defined(_SOKOL_USE_WIN32_GL_LOADER) || defined(GL_VERSION_4_1) || defined(GL_ARB_get_program_binary)))
+    #define _SOKOL_GL_HAS_PROGRAM_BINARY (1)
+    #endif
+    // framebuffer invalidation is part of GLES3, GL core needs 4.3 or GL_ARB_invalidate_subdata
+    #if defined(SOKOL_GLES3) || (defined(SOKOL_GLCORE33) && (defined(_SOKOL_USE_WIN32_GL_LOADER) || defined(GL_VERSION_4_3) || defined(GL_ARB_invalidate_subdata)))
+    #define _SOKOL_GL_HAS_INVALIDATE_FRAMEBUFFER (1)
+    #endif
+    // timestamp queries require GL 3.3 or GL_ARB_timer_query, GLES3 only has them as an extension
+    #if defined(SOKOL_GLCORE33) && (defined(_SOKOL_USE_WIN32_GL_LOADER) || defined(GL_VERSION_3_3) || defined(GL_ARB_timer_query))
+    #define _SOKOL_GL_HAS_TIMER_QUERY (1)
+    #endif
     #define _SG_GL_CHECK_ERROR() { SOKOL_ASSERT(glGetError() == GL_NO_ERROR); }
 #endif
 
+// platform specific includes for the spinlock and timer used by the init queue
+// (the D3D11 backend and the Win32 GL loader already pulled in windows.h)
+#if defined(_WIN32)
+    #if !defined(SOKOL_D3D11) && !defined(_SOKOL_USE_WIN32_GL_LOADER)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #endif
+#elif defined(__APPLE__)
+    #include <mach/mach_time.h>
+#elif defined(__EMSCRIPTEN__)
+    #include <emscripten/emscripten.h>
+#else
+    #include <time.h>
+#endif
+
 // ███████ ████████ ██████  ██    ██  ██████ ████████ ███████
 // ██         ██    ██   ██ ██    ██ ██         ██    ██
 // ███████    ██    ██████  ██    ██ ██         ██    ███████
@@ -3878,16 +4605,23 @@ enum {
     _SG_SLOT_SHIFT = 16,
     _SG_SLOT_MASK = (1<<_SG_SLOT_SHIFT)-1,
     _SG_MAX_POOL_SIZE = (1<<_SG_SLOT_SHIFT),
+    _SG_MAX_POOL_CHUNKS = 64,
     _SG_DEFAULT_BUFFER_POOL_SIZE = 128,
     _SG_DEFAULT_IMAGE_POOL_SIZE = 128,
     _SG_DEFAULT_SHADER_POOL_SIZE = 32,
     _SG_DEFAULT_PIPELINE_POOL_SIZE = 64,
     _SG_DEFAULT_PASS_POOL_SIZE = 16,
+    _SG_DEFAULT_BINDING_SET_POOL_SIZE = 128,
     _SG_DEFAULT_CONTEXT_POOL_SIZE = 16,
     _SG_DEFAULT_SAMPLER_CACHE_CAPACITY = 64,
     _SG_DEFAULT_UB_SIZE = 4 * 1024 * 1024,
     _SG_DEFAULT_STAGING_SIZE = 8 * 1024 * 1024,
     _SG_DEFAULT_MAX_COMMIT_LISTENERS = 1024,
+    _SG_DEFAULT_INIT_QUEUE_SIZE = 64,
+    _SG_DEFAULT_INIT_QUEUE_BUDGET_US = 2000,
+    _SG_GPU_TIMER_NUM_FRAMES = 4,       // frames in flight in the timestamp query ring
+    _SG_GPU_TIMER_MAX_DEPTH = 16,       // max nesting of passes and debug groups
+    _SG_GPU_TIMER_NAME_SIZE = 32,
 };
 
 /* fixed-size string */
@@ -3902,6 +4636,7 @@ typedef struct {
 #define _sg_max(a,b) (((a)>(b))?(a):(b))
 #define _sg_clamp(v,v0,v1) (((v)<(v0))?(v0):(((v)>(v1))?(v1):(v)))
 #define _sg_fequal(val,cmp,delta) ((((val)-(cmp))> -(delta))&&(((val)-(cmp))<(delta)))
+#define _sg_stats_add(key, val) do { _sg.stats.cur_frame.key += (val); } while (0)
 
 _SOKOL_PRIVATE void* _sg_malloc_clear(size_t size);
 _SOKOL_PRIVATE void _sg_free(void* ptr);
@@ -4060,6 +4795,7 @@ typedef struct {
     int sample_count;
     sg_color blend_color;
     bool alpha_to_coverage_enabled;
+    sg_pipeline_desc* pending_desc; /* copy of the desc while the shader is SG_RESOURCESTATE_PENDING */
 } _sg_pipeline_common_t;
 
 _SOKOL_PRIVATE void _sg_pipeline_common_init(_sg_pipeline_common_t* cmn, const sg_pipeline_desc* desc) {
@@ -4165,12 +4901,17 @@ typedef struct {
 typedef _sg_dummy_context_t _sg_context_t;
 
 #elif defined(_SOKOL_ANY_GL)
+/* a mapped slot may still be read in the frame it's rotated out, one extra slot avoids waiting on the previous frame */
+#define _SG_GL_MAX_BUFFER_SLOTS (SG_NUM_INFLIGHT_FRAMES + 1)
+
 typedef struct {
     _sg_slot_t slot;
     _sg_buffer_common_t cmn;
     struct {
-        GLuint buf[SG_NUM_INFLIGHT_FRAMES];
+        GLuint buf[_SG_GL_MAX_BUFFER_SLOTS];
         bool ext_buffers;   /* if true, external buffers were injected with sg_buffer_desc.gl_buffers */
+        uint8_t* mapped[_SG_GL_MAX_BUFFER_SLOTS];               /* persistently mapped stream buffer memory, or 0 */
+        uint32_t retire_frame_index[_SG_GL_MAX_BUFFER_SLOTS];   /* last frame which may have used a mapped slot */
     } gl;
 } _sg_gl_buffer_t;
 typedef _sg_gl_buffer_t _sg_buffer_t;
@@ -4182,6 +4923,7 @@ typedef struct {
         GLenum target;
         GLuint msaa_render_buffer;
         GLuint tex[SG_NUM_INFLIGHT_FRAMES];
+        GLuint sampler;     /* shared sampler object from the sampler cache, 0 if the texture parameters are used */
         bool ext_textures;  /* if true, external textures were injected with sg_image_desc.gl_textures */
     } gl;
 } _sg_gl_image_t;
@@ -4197,6 +4939,7 @@ typedef struct {
 typedef struct {
     int num_uniforms;
     _sg_gl_uniform_t uniforms[SG_MAX_UB_MEMBERS];
+    bool use_ubo;           /* if true, update via uniform buffer ring instead of glUniform*() */
 } _sg_gl_uniform_block_t;
 
 typedef struct {
@@ -4219,6 +4962,14 @@ typedef struct {
         GLuint prog;
         _sg_gl_shader_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
         _sg_gl_shader_stage_t stage[SG_NUM_SHADER_STAGES];
+        struct {
+            GLuint vs;
+            GLuint fs;
+            uint32_t frame_index;   /* frame in which compilation was started */
+            uint64_t cache_key;
+            uint64_t time_us;
+            sg_shader_desc* desc;   /* names needed to resolve the program, see _sg_gl_copy_shader_desc() */
+        } pending;
     } gl;
 } _sg_gl_shader_t;
 typedef _sg_gl_shader_t _sg_shader_t;
@@ -4233,6 +4984,14 @@ typedef struct {
     GLenum type;
 } _sg_gl_attr_t;
 
+/* per-block render state signatures, 0 means 'unknown' */
+typedef struct {
+    uint64_t depth;
+    uint64_t stencil;
+    uint64_t blend;     // blend state, blend color and color write masks
+    uint64_t raster;    // cull mode, face winding, alpha-to-coverage and sample count
+} _sg_gl_state_hashes_t;
+
 typedef struct {
     _sg_slot_t slot;
     _sg_pipeline_common_t cmn;
@@ -4248,6 +5007,7 @@ typedef struct {
         sg_face_winding face_winding;
         int sample_count;
         bool alpha_to_coverage_enabled;
+        _sg_gl_state_hashes_t hashes;
     } gl;
 } _sg_gl_pipeline_t;
 typedef _sg_gl_pipeline_t _sg_pipeline_t;
@@ -4270,24 +5030,58 @@ typedef struct {
 typedef _sg_gl_pass_t _sg_pass_t;
 typedef _sg_pass_attachment_common_t _sg_pass_attachment_t;
 
+#define _SG_GL_VAO_CACHE_SIZE (64)
+
+/* vertex buffer offsets are not part of the key, attributes are re-pointed when only an offset changes */
+typedef struct {
+    uint32_t pip_id;
+    GLuint vbufs[SG_MAX_SHADERSTAGE_BUFFERS];
+} _sg_gl_vao_key_t;
+
+typedef struct {
+    _sg_gl_vao_key_t key;   /* key.pip_id == 0 if the item is unused */
+    uint32_t hash;
+    uint32_t last_used;
+    GLuint vao;
+    GLuint index_buffer;    /* GL_ELEMENT_ARRAY_BUFFER binding, this is part of the VAO state */
+    bool stale;             /* invalidated while another context was current, deleted on activation */
+    int vb_offsets[SG_MAX_SHADERSTAGE_BUFFERS];     /* offsets the attribute pointers were specified with */
+} _sg_gl_vao_cache_item_t;
+
 typedef struct {
     _sg_slot_t slot;
     GLuint vao;
     GLuint default_framebuffer;
+    uint32_t vao_cache_tick;
+    _sg_gl_vao_cache_item_t vao_cache[_SG_GL_VAO_CACHE_SIZE];
 } _sg_gl_context_t;
 typedef _sg_gl_context_t _sg_context_t;
 
-typedef struct {
-    _sg_gl_attr_t gl_attr;
-    GLuint gl_vbuf;
-} _sg_gl_cache_attr_t;
-
 typedef struct {
     GLenum target;
     GLuint texture;
 } _sg_gl_texture_bind_slot;
 
 #define _SG_GL_IMAGE_CACHE_SIZE (SG_MAX_SHADERSTAGE_IMAGES * SG_NUM_SHADER_STAGES)
+#define _SG_GL_NUM_FRAME_FENCES (SG_NUM_INFLIGHT_FRAMES + 1)
+#define _SG_GL_DRAW_BATCH_SIZE (128)
+#define _SG_GL_PROGRAM_CACHE_MAX_PATH (512)
+
+/* layout of the GL draw-indirect command structs */
+typedef struct {
+    GLuint count;
+    GLuint instance_count;
+    GLuint first;
+    GLuint base_instance;
+} _sg_gl_draw_arrays_indirect_t;
+
+typedef struct {
+    GLuint count;
+    GLuint instance_count;
+    GLuint first_index;
+    GLint base_vertex;
+    GLuint base_instance;
+} _sg_gl_draw_elements_indirect_t;
 
 typedef struct {
     sg_depth_state depth;
@@ -4300,7 +5094,8 @@ typedef struct {
     int sample_count;
     sg_color blend_color;
     bool alpha_to_coverage_enabled;
-    _sg_gl_cache_attr_t attrs[SG_MAX_VERTEX_ATTRIBUTES];
+    _sg_gl_state_hashes_t hashes;       /* signatures of the pipeline render state blocks in the cache */
+    _sg_gl_vao_cache_item_t* cur_vao;   /* 0 while the context's default VAO is bound */
     GLuint vertex_buffer;
     GLuint index_buffer;
     GLuint stored_vertex_buffer;
@@ -4308,6 +5103,7 @@ typedef struct {
     GLuint prog;
     _sg_gl_texture_bind_slot textures[_SG_GL_IMAGE_CACHE_SIZE];
     _sg_gl_texture_bind_slot stored_texture;
+    GLuint samplers[_SG_GL_IMAGE_CACHE_SIZE];
     int cur_ib_offset;
     GLenum cur_primitive_type;
     GLenum cur_index_type;
@@ -4326,10 +5122,52 @@ typedef struct {
     sg_pass cur_pass_id;
     _sg_gl_state_cache_t cache;
     bool ext_anisotropic;
+    bool ext_buffer_storage;
+    bool ext_multi_draw_indirect;
+    bool ext_parallel_shader_compile;
+    bool ext_program_binary;
+    bool ext_invalidate_framebuffer;
     GLint max_anisotropy;
+    _sg_sampler_cache_t sampler_cache;
+    GLuint indirect_buf;    /* created on first use by sg_draw_batch() */
+    #if defined(_SOKOL_GL_HAS_TIMER_QUERY)
+    GLuint timer_queries[_SG_GPU_TIMER_NUM_FRAMES][2 * SG_MAX_GPU_TIMINGS];    /* only with sg_desc.gpu_timings */
+    #endif
     sg_store_action color_store_actions[SG_MAX_COLOR_ATTACHMENTS];
     sg_store_action depth_store_action;
     sg_store_action stencil_store_action;
+    struct {
+        GLuint buf[SG_NUM_INFLIGHT_FRAMES];
+        int size;
+        int align;
+        int cur_slot;
+        int cur_offset;
+        bool overflow;
+    } ub;
+    struct {
+        int num_mapped_buffers;     /* frame fences are only needed while mapped buffers exist */
+        uint32_t completed_frame_index;
+        #if defined(_SOKOL_GL_HAS_BUFFER_STORAGE)
+        GLsync sync[_SG_GL_NUM_FRAME_FENCES];
+        uint32_t frame_index[_SG_GL_NUM_FRAME_FENCES];
+        #endif
+    } fences;
+    struct {
+        GLuint buf;         /* created by the first sg_update_image(), one region per frame in flight */
+        uint8_t* mapped;    /* persistently mapped buffer memory */
+        int size;           /* size of one region */
+        int cur_slot;
+        int cur_offset;
+        bool disabled;      /* persistent mapping not available, upload from client memory */
+        bool overflow;
+        uint32_t retire_frame_index[SG_NUM_INFLIGHT_FRAMES];
+    } unpack;
+    struct {
+        bool enabled;       /* sg_desc.program_cache_dir set and program binaries supported */
+        uint64_t driver_hash;   /* hash of the GL vendor, renderer and version strings */
+        char dir[_SG_GL_PROGRAM_CACHE_MAX_PATH];
+        sg_program_cache_stats stats;
+    } program_cache;
     #if _SOKOL_USE_WIN32_GL_LOADER
     HINSTANCE opengl32_dll;
     #endif
@@ -4726,15 +5564,54 @@ typedef struct {
 
 // POOL STRUCTS
 
+/* binding sets are backend-agnostic, they hold resolved resource pointers
+   (pool items never move) and the resource ids at creation time, the ids
+   are compared against the resources' current slot ids when the binding set
+   is applied after any buffer or image has been uninitialized (see
+   _sg.resource_epoch), so that destroyed or re-initialized resources are
+   detected without having to touch the binding sets when a resource goes away
+*/
+typedef struct {
+    _sg_slot_t slot;
+    uint32_t checked_epoch;     // value of _sg.resource_epoch when the resources were last found valid
+    int num_vbs;
+    int num_vs_imgs;
+    int num_fs_imgs;
+    int ib_offset;
+    _sg_buffer_t* ib;
+    uint32_t ib_id;
+    _sg_buffer_t* vbs[SG_MAX_SHADERSTAGE_BUFFERS];
+    uint32_t vb_ids[SG_MAX_SHADERSTAGE_BUFFERS];
+    int vb_offsets[SG_MAX_SHADERSTAGE_BUFFERS];
+    _sg_image_t* vs_imgs[SG_MAX_SHADERSTAGE_IMAGES];
+    uint32_t vs_img_ids[SG_MAX_SHADERSTAGE_IMAGES];
+    _sg_image_t* fs_imgs[SG_MAX_SHADERSTAGE_IMAGES];
+    uint32_t fs_img_ids[SG_MAX_SHADERSTAGE_IMAGES];
+} _sg_binding_set_t;
+
 
 /* this *MUST* remain 0 */
 #define _SG_INVALID_SLOT_INDEX (0)
 
+#if defined(_WIN32)
+typedef volatile LONG _sg_spinlock_t;
+#else
+typedef int _sg_spinlock_t;
+#endif
+
+/* resource pools grow in chunks, so that item pointers remain valid */
 typedef struct {
-    int size;
+    int size;               // total number of slots in all chunks, including the reserved slot 0
+    int chunk_size;         // number of slots per chunk
+    int num_chunks;
     int queue_top;
-    uint32_t* gen_ctrs;
+    int num_used;
+    int high_water_mark;
+    size_t item_size;
     int* free_queue;
+    void* gen_ctrs[_SG_MAX_POOL_CHUNKS];    // uint32_t[chunk_size], published with a release store
+    void* items[_SG_MAX_POOL_CHUNKS];       // item_size * chunk_size bytes, published with a release store
+    _sg_spinlock_t lock;    // alloc/free index may be called from any thread
 } _sg_pool_t;
 
 typedef struct {
@@ -4743,21 +5620,87 @@ typedef struct {
     _sg_pool_t shader_pool;
     _sg_pool_t pipeline_pool;
     _sg_pool_t pass_pool;
+    _sg_pool_t binding_set_pool;
     _sg_pool_t context_pool;
-    _sg_buffer_t* buffers;
-    _sg_image_t* images;
-    _sg_shader_t* shaders;
-    _sg_pipeline_t* pipelines;
-    _sg_pass_t* passes;
-    _sg_context_t* contexts;
 } _sg_pools_t;
 
+_SOKOL_PRIVATE void* _sg_pool_item(const _sg_pool_t* pool, int slot_index);
+
 typedef struct {
     int num;        // number of allocated commit listener items
     int upper;      // the current upper index (no valid items past this point)
     sg_commit_listener* items;
 } _sg_commit_listeners_t;
 
+typedef enum {
+    _SG_INITITEM_BUFFER,
+    _SG_INITITEM_IMAGE,
+} _sg_init_item_type_t;
+
+typedef struct {
+    _sg_init_item_type_t type;
+    uint32_t id;
+    union {
+        sg_buffer_desc buf;
+        sg_image_desc img;
+    } desc;
+} _sg_init_item_t;
+
+typedef struct {
+    _sg_spinlock_t lock;
+    int size;       // capacity of the ring buffer
+    int head;       // next item to process
+    int count;      // number of queued items
+    _sg_init_item_t* items;
+} _sg_init_queue_t;
+
+typedef struct {
+    sg_frame_stats cur_frame;
+    sg_frame_stats prev_frame;
+} _sg_stats_t;
+
+/* a pass or debug group measured with sg_desc.gpu_timings, uses the timestamp queries 2*i and 2*i+1 */
+typedef struct {
+    char name[_SG_GPU_TIMER_NAME_SIZE];
+    int parent;
+    int depth;
+} _sg_gpu_timer_group_t;
+
+typedef struct {
+    bool pending;                   // timestamps have been written, results not read back yet
+    uint32_t frame_index;
+    int num_groups;
+    uint32_t num_dropped;
+    _sg_gpu_timer_group_t groups[SG_MAX_GPU_TIMINGS];
+} _sg_gpu_timer_frame_t;
+
+typedef struct {
+    bool enabled;
+    int cur_slot;                   // ring slot of the current frame
+    int stack_depth;
+    int stack[_SG_GPU_TIMER_MAX_DEPTH];     // open groups of the current frame, -1 if dropped
+    _sg_gpu_timer_frame_t frames[_SG_GPU_TIMER_NUM_FRAMES];
+    char names[SG_MAX_GPU_TIMINGS][_SG_GPU_TIMER_NAME_SIZE];    // referenced by results.timings[].name
+    sg_gpu_timings results;
+} _sg_gpu_timer_t;
+
+enum {
+    _SG_MERGE_MAX_UNIFORM_SIZE = 256,   // bigger uniform blocks always issue the pending draw
+};
+
+/* the held back draw for sg_desc.merge_draws, and the state it was recorded with */
+typedef struct {
+    bool pending;
+    bool list_primitives;           // the current pipeline draws triangle, line or point lists
+    int base_element;
+    int num_elements;
+    int num_instances;
+    uint32_t binding_set_id;        // != 0 if the bindings came from sg_apply_binding_set()
+    sg_bindings bindings;
+    size_t uniform_size[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS];
+    uint8_t uniform_data[SG_NUM_SHADER_STAGES][SG_MAX_SHADERSTAGE_UBS][_SG_MERGE_MAX_UNIFORM_SIZE];
+} _sg_draw_merge_t;
+
 typedef struct {
     bool valid;
     sg_desc desc;       /* original desc with default values patched in */
@@ -4768,9 +5711,10 @@ typedef struct {
     bool pass_valid;
     bool bindings_valid;
     bool next_draw_valid;
-    #if defined(SOKOL_DEBUG)
-    sg_log_item validate_error;
-    #endif
+    bool pipeline_pending;  /* the applied pipeline is SG_RESOURCESTATE_PENDING */
+    int num_pending_shaders;
+    int num_pending_pipelines;
+    uint32_t resource_epoch;    /* bumped when a buffer or image is uninitialized, see _sg_binding_set_resources_valid() */
     _sg_pools_t pools;
     sg_backend backend;
     sg_features features;
@@ -4789,9 +5733,22 @@ typedef struct {
     sg_trace_hooks hooks;
     #endif
     _sg_commit_listeners_t commit_listeners;
+    _sg_init_queue_t init_queue;
+    _sg_draw_merge_t merge;
+    _sg_stats_t stats;
+    _sg_gpu_timer_t gpu_timer;
 } _sg_state_t;
 static _sg_state_t _sg;
 
+#if defined(SOKOL_DEBUG)
+/* per thread, since command lists are validated on the threads which record them */
+#if defined(_MSC_VER)
+static __declspec(thread) sg_log_item _sg_validate_error;
+#else
+static __thread sg_log_item _sg_validate_error;
+#endif
+#endif
+
 // ███████  █████  ███    ███ ██████  ██      ███████ ██████       ██████  █████   ██████ ██   ██ ███████
 // ██      ██   ██ ████  ████ ██   ██ ██      ██      ██   ██     ██      ██   ██ ██      ██   ██ ██
 // ███████ ███████ ██ ████ ██ ██████  ██      █████   ██████      ██      ███████ ██      ███████ █████
@@ -4800,7 +5757,7 @@ static _sg_state_t _sg;
 //
 // >>sampler cache
 /*
-    this is used by the Metal and WGPU backends to reduce the
+    this is used by the Metal, WGPU and GL backends to reduce the
     number of sampler state objects created through the backend API
 */
 _SOKOL_PRIVATE void _sg_smpcache_init(_sg_sampler_cache_t* cache, int capacity) {
@@ -4896,7 +5853,7 @@ static const char* _sg_log_messages[] = {
 #define _SG_WARN(code) _sg_log(SG_LOGITEM_ ##code, 2, 0, __LINE__)
 #define _SG_INFO(code) _sg_log(SG_LOGITEM_ ##code, 3, 0, __LINE__)
 #define _SG_LOGMSG(code,msg) _sg_log(SG_LOGITEM_ ##code, 3, msg, __LINE__)
-#define _SG_VALIDATE(cond,code) if (!(cond)){ _sg.validate_error = SG_LOGITEM_ ##code; _sg_log(SG_LOGITEM_ ##code, 1, 0, __LINE__); }
+#define _SG_VALIDATE(cond,code) if (!(cond)){ _sg_validate_error = SG_LOGITEM_ ##code; _sg_log(SG_LOGITEM_ ##code, 1, 0, __LINE__); }
 
 static void _sg_log(sg_log_item log_item, uint32_t log_level, const char* msg, uint32_t line_nr) {
     if (_sg.desc.logger.func) {
@@ -5247,6 +6204,53 @@ _SOKOL_PRIVATE int _sg_roundup(int val, int round_to) {
     return (val+(round_to-1)) & ~(round_to-1);
 }
 
+/* number of mipmaps down to 1x1 */
+_SOKOL_PRIVATE int _sg_full_mipmap_count(int width, int height) {
+    int size = (width > height) ? width : height;
+    int count = 1;
+    while ((size > 1) && (count < SG_MAX_MIPMAPS)) {
+        size >>= 1;
+        count++;
+    }
+    return count;
+}
+
+/* pixel formats which sokol-gfx can build a mipmap chain for */
+_SOKOL_PRIVATE bool _sg_is_mipmap_gen_format(sg_pixel_format fmt) {
+    switch (fmt) {
+        case SG_PIXELFORMAT_R8:
+        case SG_PIXELFORMAT_RG8:
+        case SG_PIXELFORMAT_RGBA8:
+        case SG_PIXELFORMAT_SRGB8A8:
+        case SG_PIXELFORMAT_BGRA8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* microsecond timer for time budgets and stats */
+_SOKOL_PRIVATE uint64_t _sg_time_us(void) {
+    #if defined(_WIN32)
+        LARGE_INTEGER freq, counter;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&counter);
+        return (uint64_t)((counter.QuadPart / freq.QuadPart) * 1000000 + ((counter.QuadPart % freq.QuadPart) * 1000000) / freq.QuadPart);
+    #elif defined(__APPLE__)
+        static mach_timebase_info_data_t timebase;
+        if (0 == timebase.denom) {
+            mach_timebase_info(&timebase);
+        }
+        return ((mach_absolute_time() * timebase.numer) / timebase.denom) / 1000;
+    #elif defined(__EMSCRIPTEN__)
+        return (uint64_t)(emscripten_get_now() * 1000.0);
+    #else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+    #endif
+}
+
 /* return row pitch for an image
 
     see ComputePitch in https://github.com/microsoft/DirectXTex/blob/master/DirectXTex/DirectXTexUtil.cpp
@@ -5789,6 +6793,7 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glBufferData,                      void, (GLenum target, GLsizeiptr size, const void * data, GLenum usage)) \
     _SG_XMACRO(glBlendFuncSeparate,               void, (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha)) \
     _SG_XMACRO(glTexParameteri,                   void, (GLenum target, GLenum pname, GLint param)) \
+    _SG_XMACRO(glGenerateMipmap,                  void, (GLenum target)) \
     _SG_XMACRO(glGetIntegerv,                     void, (GLenum pname, GLint * data)) \
     _SG_XMACRO(glEnable,                          void, (GLenum cap)) \
     _SG_XMACRO(glBlitFramebuffer,                 void, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)) \
@@ -5798,6 +6803,12 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glBlendColor,                      void, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)) \
     _SG_XMACRO(glTexParameterf,                   void, (GLenum target, GLenum pname, GLfloat param)) \
     _SG_XMACRO(glTexParameterfv,                  void, (GLenum target, GLenum pname, const GLfloat* params)) \
+    _SG_XMACRO(glGenSamplers,                     void, (GLsizei count, GLuint * samplers)) \
+    _SG_XMACRO(glDeleteSamplers,                  void, (GLsizei count, const GLuint * samplers)) \
+    _SG_XMACRO(glBindSampler,                     void, (GLuint unit, GLuint sampler)) \
+    _SG_XMACRO(glSamplerParameteri,               void, (GLuint sampler, GLenum pname, GLint param)) \
+    _SG_XMACRO(glSamplerParameterf,               void, (GLuint sampler, GLenum pname, GLfloat param)) \
+    _SG_XMACRO(glSamplerParameterfv,              void, (GLuint sampler, GLenum pname, const GLfloat * param)) \
     _SG_XMACRO(glGetShaderInfoLog,                void, (GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * infoLog)) \
     _SG_XMACRO(glDepthFunc,                       void, (GLenum func)) \
     _SG_XMACRO(glStencilOp ,                      void, (GLenum fail, GLenum zfail, GLenum zpass)) \
@@ -5809,25 +6820,58 @@ _SOKOL_PRIVATE void _sg_dummy_update_image(_sg_image_t* img, const sg_image_data
     _SG_XMACRO(glGenVertexArrays,                 void, (GLsizei n, GLuint * arrays)) \
     _SG_XMACRO(glFrontFace,                       void, (GLenum mode)) \
     _SG_XMACRO(glCullFace,                        void, (GLenum mode)) \
-    _SG_XMACRO(glPixelStorei,                     void, (GLenum pname, GLint param))
+    _SG_XMACRO(glPixelStorei,                     void, (GLenum pname, GLint param)) \
+    _SG_XMACRO(glBindBufferRange,                 void, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)) \
+    _SG_XMACRO(glGetUniformBlockIndex,            GLuint, (GLuint program, const GLchar * uniformBlockName)) \
+    _SG_XMACRO(glUniformBlockBinding,             void, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)) \
+    _SG_XMACRO(glGetActiveUniformBlockiv,         void, (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint * params)) \
+    _SG_XMACRO(glMapBufferRange,                  void *, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)) \
+    _SG_XMACRO(glFenceSync,                       GLsync, (GLenum condition, GLbitfield flags)) \
+    _SG_XMACRO(glClientWaitSync,                  GLenum, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+    _SG_XMACRO(glDeleteSync,                      void, (GLsync sync)) \
+    _SG_XMACRO(glMultiDrawArrays,                 void, (GLenum mode, const GLint * first, const GLsizei * count, GLsizei drawcount)) \
+    _SG_XMACRO(glMultiDrawElementsBaseVertex,     void, (GLenum mode, const GLsizei * count, GLenum type, const void * const * indices, GLsizei drawcount, const GLint * basevertex)) \
+    _SG_XMACRO(glDrawElementsInstancedBaseVertex, void, (GLenum mode, GLsizei count, GLenum type, const void * indices, GLsizei instancecount, GLint basevertex)) \
+    _SG_XMACRO(glGenQueries,                      void, (GLsizei n, GLuint * ids)) \
+    _SG_XMACRO(glDeleteQueries,                   void, (GLsizei n, const GLuint * ids)) \
+    _SG_XMACRO(glQueryCounter,                    void, (GLuint id, GLenum target)) \
+    _SG_XMACRO(glGetQueryObjectiv,                void, (GLuint id, GLenum pname, GLint * params)) \
+    _SG_XMACRO(glGetQueryObjectui64v,             void, (GLuint id, GLenum pname, GLuint64 * params))
+
+// X Macro list of optional GL functions, these may be null
+#define _SG_GL_OPT_FUNCS \
+    _SG_XMACRO(glBufferStorage,                   void, (GLenum target, GLsizeiptr size, const void * data, GLbitfield flags)) \
+    _SG_XMACRO(glMultiDrawArraysIndirect,         void, (GLenum mode, const void * indirect, GLsizei drawcount, GLsizei stride)) \
+    _SG_XMACRO(glMultiDrawElementsIndirect,       void, (GLenum mode, GLenum type, const void * indirect, GLsizei drawcount, GLsizei stride)) \
+    _SG_XMACRO(glGetProgramBinary,                void, (GLuint program, GLsizei bufSize, GLsizei * length, GLenum * binaryFormat, void * binary)) \
+    _SG_XMACRO(glProgramBinary,                   void, (GLuint program, GLenum binaryFormat, const void * binary, GLsizei length)) \
+    _SG_XMACRO(glProgramParameteri,               void, (GLuint program, GLenum pname, GLint value)) \
+    _SG_XMACRO(glInvalidateFramebuffer,           void, (GLenum target, GLsizei numAttachments, const GLenum * attachments))
 
 // generate GL function pointer typedefs
 #define _SG_XMACRO(name, ret, args) typedef ret (GL_APIENTRY* PFN_ ## name) args;
 _SG_GL_FUNCS
+_SG_GL_OPT_FUNCS
 #undef _SG_XMACRO
 
 // generate GL function pointers
 #define _SG_XMACRO(name, ret, args) static PFN_ ## name name;
 _SG_GL_FUNCS
+_SG_GL_OPT_FUNCS
 #undef _SG_XMACRO
 
 // helper function to lookup GL functions in GL DLL
 typedef PROC (WINAPI * _sg_wglGetProcAddress)(LPCSTR);
-_SOKOL_PRIVATE void* _sg_gl_getprocaddr(const char* name, _sg_wglGetProcAddress wgl_getprocaddress) {
+_SOKOL_PRIVATE void* _sg_gl_getprocaddr_opt(const char* name, _sg_wglGetProcAddress wgl_getprocaddress) {
     void* proc_addr = (void*) wgl_getprocaddress(name);
     if (0 == proc_addr) {
         proc_addr = (void*) GetProcAddress(_sg.gl.opengl32_dll, name);
     }
+    return proc_addr;
+}
+
+_SOKOL_PRIVATE void* _sg_gl_getprocaddr(const char* name, _sg_wglGetProcAddress wgl_getprocaddress) {
+    void* proc_addr = _sg_gl_getprocaddr_opt(name, wgl_getprocaddress);
     SOKOL_ASSERT(proc_addr);
     return proc_addr;
 }
@@ -5842,6 +6886,9 @@ _SOKOL_PRIVATE  void _sg_gl_load_opengl(void) {
     #define _SG_XMACRO(name, ret, args) name = (PFN_ ## name) _sg_gl_getprocaddr(#name, wgl_getprocaddress);
     _SG_GL_FUNCS
     #undef _SG_XMACRO
+    #define _SG_XMACRO(name, ret, args) name = (PFN_ ## name) _sg_gl_getprocaddr_opt(#name, wgl_getprocaddress);
+    _SG_GL_OPT_FUNCS
+    #undef _SG_XMACRO
 }
 
 _SOKOL_PRIVATE void _sg_gl_unload_opengl(void) {
@@ -6475,6 +7522,7 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
     _sg.features.image_clamp_to_border = true;
     _sg.features.mrt_independent_blend_state = false;
     _sg.features.mrt_independent_write_mask = true;
+    _sg.features.draw_base_vertex = true;
 
     /* scan extensions */
     bool has_s3tc = false;  /* BC1..BC3 */
@@ -6499,6 +7547,32 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_glcore33(void) {
                 has_etc2 = true;
             } else if (strstr(ext, "_texture_filter_anisotropic")) {
                 _sg.gl.ext_anisotropic = true;
+            } else if (strstr(ext, "_ARB_buffer_storage")) {
+                #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+                _sg.gl.ext_buffer_storage = (0 != glBufferStorage);
+                #elif defined(_SOKOL_GL_HAS_BUFFER_STORAGE)
+                _sg.gl.ext_buffer_storage = true;
+                #endif
+            } else if (strstr(ext, "_parallel_shader_compile")) {
+                _sg.gl.ext_parallel_shader_compile = true;
+            } else if (strstr(ext, "_ARB_invalidate_subdata")) {
+                #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+                _sg.gl.ext_invalidate_framebuffer = (0 != glInvalidateFramebuffer);
+                #elif defined(_SOKOL_GL_HAS_INVALIDATE_FRAMEBUFFER)
+                _sg.gl.ext_invalidate_framebuffer = true;
+                #endif
+            } else if (strstr(ext, "_ARB_multi_draw_indirect")) {
+                #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+                _sg.gl.ext_multi_draw_indirect = (0 != glMultiDrawArraysIndirect) && (0 != glMultiDrawElementsIndirect);
+                #elif defined(_SOKOL_GL_HAS_MULTI_DRAW_INDIRECT)
+                _sg.gl.ext_multi_draw_indirect = true;
+                #endif
+            } else if (strstr(ext, "_ARB_get_program_binary")) {
+                #if defined(_SOKOL_USE_WIN32_GL_LOADER)
+                _sg.gl.ext_program_binary = (0 != glGetProgramBinary) && (0 != glProgramBinary) && (0 != glProgramParameteri);
+                #elif defined(_SOKOL_GL_HAS_PROGRAM_BINARY)
+                _sg.gl.ext_program_binary = true;
+                #endif
             }
         }
     }
@@ -6555,6 +7629,9 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles3(void) {
     bool has_colorbuffer_half_float = false;
     bool has_texture_float_linear = false;
     bool has_float_blend = false;
+    /* glInvalidateFramebuffer() and program binaries are core in GLES3 */
+    _sg.gl.ext_invalidate_framebuffer = true;
+    _sg.gl.ext_program_binary = true;
     GLint num_ext = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_ext);
     for (int i = 0; i < num_ext; i++) {
@@ -6584,6 +7661,8 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles3(void) {
                 has_float_blend = true;
             } else if (strstr(ext, "_texture_filter_anisotropic")) {
                 _sg.gl.ext_anisotropic = true;
+            } else if (strstr(ext, "_parallel_shader_compile")) {
+                _sg.gl.ext_parallel_shader_compile = true;
             }
         }
     }
@@ -6623,6 +7702,11 @@ _SOKOL_PRIVATE void _sg_gl_init_caps_gles3(void) {
 }
 #endif
 
+/* uniform buffer binding point for a shader stage's uniform block */
+_SOKOL_PRIVATE GLuint _sg_gl_ub_binding(int stage_index, int ub_index) {
+    return (GLuint)(stage_index * SG_MAX_SHADERSTAGE_UBS + ub_index);
+}
+
 /*-- state cache implementation ----------------------------------------------*/
 _SOKOL_PRIVATE void _sg_gl_cache_clear_buffer_bindings(bool force) {
     if (force || (_sg.gl.cache.vertex_buffer != 0)) {
@@ -6641,11 +7725,17 @@ _SOKOL_PRIVATE void _sg_gl_cache_bind_buffer(GLenum target, GLuint buffer) {
         if (_sg.gl.cache.vertex_buffer != buffer) {
             _sg.gl.cache.vertex_buffer = buffer;
             glBindBuffer(target, buffer);
+            _sg_stats_add(gl.num_bind_buffer, 1);
+        } else {
+            _sg_stats_add(gl.num_bind_buffer_skipped, 1);
         }
     } else {
         if (_sg.gl.cache.index_buffer != buffer) {
             _sg.gl.cache.index_buffer = buffer;
             glBindBuffer(target, buffer);
+            _sg_stats_add(gl.num_bind_buffer, 1);
+        } else {
+            _sg_stats_add(gl.num_bind_buffer_skipped, 1);
         }
     }
 }
@@ -6674,47 +7764,129 @@ _SOKOL_PRIVATE void _sg_gl_cache_restore_buffer_binding(GLenum target) {
     }
 }
 
-/* called when _sg_gl_deinit_buffer() */
-_SOKOL_PRIVATE void _sg_gl_cache_invalidate_buffer(GLuint buf) {
-    if (buf == _sg.gl.cache.vertex_buffer) {
-        _sg.gl.cache.vertex_buffer = 0;
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+_SOKOL_PRIVATE uint32_t _sg_gl_vao_key_hash(const _sg_gl_vao_key_t* key) {
+    /* FNV-1a */
+    const uint8_t* ptr = (const uint8_t*) key;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(_sg_gl_vao_key_t); i++) {
+        hash = (hash ^ ptr[i]) * 16777619u;
     }
-    if (buf == _sg.gl.cache.index_buffer) {
-        _sg.gl.cache.index_buffer = 0;
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    return hash;
+}
+
+/* find the VAO for a pipeline and vertex buffer combination, or recycle the least recently used one */
+_SOKOL_PRIVATE _sg_gl_vao_cache_item_t* _sg_gl_vao_cache_lookup(const _sg_gl_vao_key_t* key, bool* out_hit) {
+    SOKOL_ASSERT(_sg.gl.cur_context && key && (key->pip_id != SG_INVALID_ID) && out_hit);
+    _sg_context_t* ctx = _sg.gl.cur_context;
+    const uint32_t hash = _sg_gl_vao_key_hash(key);
+    const uint32_t tick = ++ctx->vao_cache_tick;
+    _sg_gl_vao_cache_item_t* item = _sg.gl.cache.cur_vao;
+    if (item && (item->hash == hash) && (0 == memcmp(&item->key, key, sizeof(_sg_gl_vao_key_t)))) {
+        item->last_used = tick;
+        *out_hit = true;
+        return item;
     }
-    if (buf == _sg.gl.cache.stored_vertex_buffer) {
-        _sg.gl.cache.stored_vertex_buffer = 0;
+    _sg_gl_vao_cache_item_t* lru_item = &ctx->vao_cache[0];
+    for (int i = 0; i < _SG_GL_VAO_CACHE_SIZE; i++) {
+        item = &ctx->vao_cache[i];
+        if ((item->key.pip_id != SG_INVALID_ID) && (item->hash == hash) && (0 == memcmp(&item->key, key, sizeof(_sg_gl_vao_key_t)))) {
+            item->last_used = tick;
+            *out_hit = true;
+            return item;
+        }
+        if (item->last_used < lru_item->last_used) {
+            lru_item = item;
+        }
     }
-    if (buf == _sg.gl.cache.stored_index_buffer) {
-        _sg.gl.cache.stored_index_buffer = 0;
+    if (0 == lru_item->vao) {
+        glGenVertexArrays(1, &lru_item->vao);
+        SOKOL_ASSERT(lru_item->vao);
     }
-    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
-        if (buf == _sg.gl.cache.attrs[i].gl_vbuf) {
-            _sg.gl.cache.attrs[i].gl_vbuf = 0;
+    lru_item->key = *key;
+    lru_item->hash = hash;
+    lru_item->last_used = tick;
+    lru_item->stale = false;
+    *out_hit = false;
+    return lru_item;
+}
+
+/* drop VAO cache items which reference a destroyed buffer or pipeline */
+_SOKOL_PRIVATE void _sg_gl_vao_cache_invalidate(GLuint buf, uint32_t pip_id) {
+    for (int ctx_index = 0; ctx_index < _sg.pools.context_pool.size; ctx_index++) {
+        _sg_context_t* ctx = (_sg_context_t*) _sg_pool_item(&_sg.pools.context_pool, ctx_index);
+        if (ctx->slot.state != SG_RESOURCESTATE_VALID) {
+            continue;
+        }
+        for (int i = 0; i < _SG_GL_VAO_CACHE_SIZE; i++) {
+            _sg_gl_vao_cache_item_t* item = &ctx->vao_cache[i];
+            if (item->key.pip_id == SG_INVALID_ID) {
+                continue;
+            }
+            bool match = (pip_id != SG_INVALID_ID) && (item->key.pip_id == pip_id);
+            if (buf != 0) {
+                match |= (item->index_buffer == buf);
+                for (int vb_index = 0; vb_index < SG_MAX_SHADERSTAGE_BUFFERS; vb_index++) {
+                    match |= (item->key.vbufs[vb_index] == buf);
+                }
+            }
+            if (match) {
+                _sg_clear(&item->key, sizeof(item->key));
+                item->last_used = 0;
+                /* an unbound VAO would keep deleted buffers alive, so delete it as soon as possible */
+                if ((ctx == _sg.gl.cur_context) && (item != _sg.gl.cache.cur_vao)) {
+                    glDeleteVertexArrays(1, &item->vao);
+                    item->vao = 0;
+                    item->index_buffer = 0;
+                } else if (item->vao) {
+                    item->stale = true;
+                }
+            }
         }
     }
 }
 
+/* called when _sg_gl_deinit_buffer() */
+_SOKOL_PRIVATE void _sg_gl_cache_invalidate_buffer(GLuint buf) {
+    if (buf == _sg.gl.cache.vertex_buffer) {
+        _sg.gl.cache.vertex_buffer = 0;
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    if (buf == _sg.gl.cache.index_buffer) {
+        _sg.gl.cache.index_buffer = 0;
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+    if (buf == _sg.gl.cache.stored_vertex_buffer) {
+        _sg.gl.cache.stored_vertex_buffer = 0;
+    }
+    if (buf == _sg.gl.cache.stored_index_buffer) {
+        _sg.gl.cache.stored_index_buffer = 0;
+    }
+    _sg_gl_vao_cache_invalidate(buf, 0);
+}
+
 _SOKOL_PRIVATE void _sg_gl_cache_active_texture(GLenum texture) {
     if (_sg.gl.cache.cur_active_texture != texture) {
         _sg.gl.cache.cur_active_texture = texture;
         glActiveTexture(texture);
+        _sg_stats_add(gl.num_active_texture, 1);
+    } else {
+        _sg_stats_add(gl.num_active_texture_skipped, 1);
     }
 }
 
 _SOKOL_PRIVATE void _sg_gl_cache_clear_texture_bindings(bool force) {
     for (int i = 0; (i < _SG_GL_IMAGE_CACHE_SIZE) && (i < _sg.limits.gl_max_combined_texture_image_units); i++) {
-        if (force || (_sg.gl.cache.textures[i].texture != 0)) {
+        if (force || (_sg.gl.cache.textures[i].texture != 0) || (_sg.gl.cache.samplers[i] != 0)) {
             GLenum gl_texture_slot = (GLenum) (GL_TEXTURE0 + i);
             glActiveTexture(gl_texture_slot);
             glBindTexture(GL_TEXTURE_2D, 0);
             glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
             glBindTexture(GL_TEXTURE_3D, 0);
             glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+            glBindSampler((GLuint)i, 0);
             _sg.gl.cache.textures[i].target = 0;
             _sg.gl.cache.textures[i].texture = 0;
+            _sg.gl.cache.samplers[i] = 0;
             _sg.gl.cache.cur_active_texture = gl_texture_slot;
         }
     }
@@ -6739,9 +7911,26 @@ _SOKOL_PRIVATE void _sg_gl_cache_bind_texture(int slot_index, GLenum target, GLu
         /* apply new binding (texture can be 0 to unbind) */
         if (target != 0) {
             glBindTexture(target, texture);
+            _sg_stats_add(gl.num_bind_texture, 1);
         }
         slot->target = target;
         slot->texture = texture;
+    } else {
+        _sg_stats_add(gl.num_bind_texture_skipped, 1);
+    }
+}
+
+_SOKOL_PRIVATE void _sg_gl_cache_bind_sampler(int slot_index, GLuint sampler) {
+    SOKOL_ASSERT((slot_index >= 0) && (slot_index < _SG_GL_IMAGE_CACHE_SIZE));
+    if (slot_index >= _sg.limits.gl_max_combined_texture_image_units) {
+        return;
+    }
+    if (_sg.gl.cache.samplers[slot_index] != sampler) {
+        _sg.gl.cache.samplers[slot_index] = sampler;
+        glBindSampler((GLuint)slot_index, sampler);
+        _sg_stats_add(gl.num_bind_sampler, 1);
+    } else {
+        _sg_stats_add(gl.num_bind_sampler_skipped, 1);
     }
 }
 
@@ -6793,6 +7982,23 @@ _SOKOL_PRIVATE void _sg_gl_cache_invalidate_pipeline(_sg_pipeline_t* pip) {
         _sg.gl.cache.cur_pipeline = 0;
         _sg.gl.cache.cur_pipeline_id.id = SG_INVALID_ID;
     }
+    _sg_gl_vao_cache_invalidate(0, pip->slot.id);
+}
+
+/* the index buffer binding is part of the VAO state and must be tracked per VAO */
+_SOKOL_PRIVATE void _sg_gl_cache_bind_vao(_sg_gl_vao_cache_item_t* item) {
+    SOKOL_ASSERT(item && item->vao);
+    if (item != _sg.gl.cache.cur_vao) {
+        if (_sg.gl.cache.cur_vao) {
+            _sg.gl.cache.cur_vao->index_buffer = _sg.gl.cache.index_buffer;
+        }
+        _sg.gl.cache.cur_vao = item;
+        _sg.gl.cache.index_buffer = item->index_buffer;
+        glBindVertexArray(item->vao);
+        _sg_stats_add(gl.num_bind_vertex_array, 1);
+    } else {
+        _sg_stats_add(gl.num_bind_vertex_array_skipped, 1);
+    }
 }
 
 _SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
@@ -6800,15 +8006,26 @@ _SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
         _SG_GL_CHECK_ERROR();
         glBindVertexArray(_sg.gl.cur_context->vao);
         _SG_GL_CHECK_ERROR();
+        /* cached VAOs may have been modified by external code, keep the GL objects but drop the keys,
+           VAOs which were invalidated while another context was current can be deleted now
+        */
+        for (int i = 0; i < _SG_GL_VAO_CACHE_SIZE; i++) {
+            _sg_gl_vao_cache_item_t* item = &_sg.gl.cur_context->vao_cache[i];
+            _sg_clear(&item->key, sizeof(item->key));
+            item->last_used = 0;
+            if (item->stale) {
+                glDeleteVertexArrays(1, &item->vao);
+                item->vao = 0;
+                item->index_buffer = 0;
+                item->stale = false;
+            }
+        }
         _sg_clear(&_sg.gl.cache, sizeof(_sg.gl.cache));
         _sg_gl_cache_clear_buffer_bindings(true);
         _SG_GL_CHECK_ERROR();
         _sg_gl_cache_clear_texture_bindings(true);
         _SG_GL_CHECK_ERROR();
         for (int i = 0; i < _sg.limits.max_vertex_attrs; i++) {
-            _sg_gl_attr_t* attr = &_sg.gl.cache.attrs[i].gl_attr;
-            attr->vb_index = -1;
-            attr->divisor = -1;
             glDisableVertexAttribArray((GLuint)i);
             _SG_GL_CHECK_ERROR();
         }
@@ -6872,10 +8089,177 @@ _SOKOL_PRIVATE void _sg_gl_reset_state_cache(void) {
     }
 }
 
+/*-- program binary cache (sg_desc.program_cache_dir) ------------------------*/
+#define _SG_GL_PROGRAM_CACHE_MAGIC (0x42504753)    /* 'SGPB' */
+#define _SG_GL_PROGRAM_CACHE_VERSION (1)
+#define _SG_GL_PROGRAM_CACHE_MAX_SIZE (64 * 1024 * 1024)
+
+/* header of a cache file, followed by the program binary */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t binary_format;
+    uint32_t binary_size;
+} _sg_gl_program_cache_header_t;
+
+/* FNV-1a over a string including its terminator, so that "ab","c" and "a","bc" differ */
+_SOKOL_PRIVATE uint64_t _sg_gl_program_cache_hash(uint64_t hash, const char* str) {
+    if (str) {
+        while (*str) {
+            hash = (hash ^ (uint8_t)*str++) * 1099511628211u;
+        }
+    }
+    return hash * 1099511628211u;   /* the terminator */
+}
+
+_SOKOL_PRIVATE void _sg_gl_program_cache_setup(const char* dir) {
+    SOKOL_ASSERT(dir);
+    #if defined(_SOKOL_GL_HAS_PROGRAM_BINARY)
+        /* GL_NUM_PROGRAM_BINARY_FORMATS is an invalid enum without GL_ARB_get_program_binary */
+        GLint num_formats = 0;
+        if (_sg.gl.ext_program_binary) {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+            _SG_GL_CHECK_ERROR();
+        }
+        if (num_formats <= 0) {
+            _SG_WARN(GL_PROGRAM_CACHE_UNSUPPORTED);
+            return;
+        }
+        /* room for the separator, 16 hex digits, the file extension and the terminator */
+        if ((strlen(dir) + 24) > _SG_GL_PROGRAM_CACHE_MAX_PATH) {
+            _SG_WARN(GL_PROGRAM_CACHE_DIR_TOO_LONG);
+            return;
+        }
+        memcpy(_sg.gl.program_cache.dir, dir, strlen(dir) + 1);
+        uint64_t hash = 14695981039346656037u;
+        hash = _sg_gl_program_cache_hash(hash, (const char*)glGetString(GL_VENDOR));
+        hash = _sg_gl_program_cache_hash(hash, (const char*)glGetString(GL_RENDERER));
+        hash = _sg_gl_program_cache_hash(hash, (const char*)glGetString(GL_VERSION));
+        _sg.gl.program_cache.driver_hash = hash;
+        _sg.gl.program_cache.enabled = true;
+    #else
+        _SG_WARN(GL_PROGRAM_CACHE_UNSUPPORTED);
+    #endif
+}
+
+_SOKOL_PRIVATE uint64_t _sg_gl_program_cache_key(const sg_shader_desc* desc) {
+    uint64_t hash = _sg.gl.program_cache.driver_hash;
+    hash = _sg_gl_program_cache_hash(hash, desc->vs.source);
+    hash = _sg_gl_program_cache_hash(hash, desc->fs.source);
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        hash = _sg_gl_program_cache_hash(hash, desc->attrs[i].name);
+    }
+    return hash;
+}
+
+_SOKOL_PRIVATE void _sg_gl_program_cache_path(uint64_t key, char* buf) {
+    static const char hex[] = "0123456789abcdef";
+    size_t len = strlen(_sg.gl.program_cache.dir);
+    memcpy(buf, _sg.gl.program_cache.dir, len);
+    if ((len > 0) && (buf[len - 1] != '/') && (buf[len - 1] != '\\')) {
+        buf[len++] = '/';
+    }
+    for (int i = 15; i >= 0; i--) {
+        buf[len++] = hex[(key >> (i * 4)) & 0xF];
+    }
+    memcpy(buf + len, ".glprog", 8);
+}
+
+/* returns a linked program, or 0 if the entry is missing, unreadable or rejected by the driver */
+_SOKOL_PRIVATE GLuint _sg_gl_program_cache_load(uint64_t key) {
+    #if defined(_SOKOL_GL_HAS_PROGRAM_BINARY)
+        char path[_SG_GL_PROGRAM_CACHE_MAX_PATH];
+        _sg_gl_program_cache_path(key, path);
+        FILE* fp = fopen(path, "rb");
+        if (!fp) {
+            return 0;
+        }
+        _sg_gl_program_cache_header_t hdr;
+        void* binary = 0;
+        bool valid = (1 == fread(&hdr, sizeof(hdr), 1, fp))
+            && (hdr.magic == _SG_GL_PROGRAM_CACHE_MAGIC)
+            && (hdr.version == _SG_GL_PROGRAM_CACHE_VERSION)
+            && (hdr.key == key)
+            && (hdr.binary_size > 0)
+            && (hdr.binary_size <= _SG_GL_PROGRAM_CACHE_MAX_SIZE);
+        if (valid) {
+            binary = _sg_malloc(hdr.binary_size);
+            valid = (1 == fread(binary, hdr.binary_size, 1, fp));
+        }
+        fclose(fp);
+        GLuint gl_prog = 0;
+        if (valid) {
+            gl_prog = glCreateProgram();
+            glProgramBinary(gl_prog, (GLenum)hdr.binary_format, binary, (GLsizei)hdr.binary_size);
+            /* an unknown binary format sets GL_INVALID_ENUM, treat it like any rejected binary */
+            glGetError();
+            GLint link_status = 0;
+            glGetProgramiv(gl_prog, GL_LINK_STATUS, &link_status);
+            if (!link_status) {
+                glDeleteProgram(gl_prog);
+                gl_prog = 0;
+            }
+        }
+        if (!gl_prog) {
+            _sg.gl.program_cache.stats.num_stale++;
+        }
+        _sg_free(binary);
+        _SG_GL_CHECK_ERROR();
+        return gl_prog;
+    #else
+        _SOKOL_UNUSED(key);
+        return 0;
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_gl_program_cache_store(uint64_t key, GLuint gl_prog) {
+    #if defined(_SOKOL_GL_HAS_PROGRAM_BINARY)
+        GLint binary_size = 0;
+        glGetProgramiv(gl_prog, GL_PROGRAM_BINARY_LENGTH, &binary_size);
+        if ((binary_size <= 0) || (binary_size > _SG_GL_PROGRAM_CACHE_MAX_SIZE)) {
+            return;
+        }
+        void* binary = _sg_malloc((size_t)binary_size);
+        GLsizei length = 0;
+        GLenum binary_format = 0;
+        glGetProgramBinary(gl_prog, binary_size, &length, &binary_format, binary);
+        _SG_GL_CHECK_ERROR();
+        if (length > 0) {
+            _sg_gl_program_cache_header_t hdr;
+            _sg_clear(&hdr, sizeof(hdr));
+            hdr.magic = _SG_GL_PROGRAM_CACHE_MAGIC;
+            hdr.version = _SG_GL_PROGRAM_CACHE_VERSION;
+            hdr.key = key;
+            hdr.binary_format = (uint32_t)binary_format;
+            hdr.binary_size = (uint32_t)length;
+            char path[_SG_GL_PROGRAM_CACHE_MAX_PATH];
+            _sg_gl_program_cache_path(key, path);
+            FILE* fp = fopen(path, "wb");
+            bool written = false;
+            if (fp) {
+                written = (1 == fwrite(&hdr, sizeof(hdr), 1, fp)) && (1 == fwrite(binary, (size_t)length, 1, fp));
+                written &= (0 == fclose(fp));
+            }
+            if (written) {
+                _sg.gl.program_cache.stats.num_stored++;
+            } else {
+                _SG_WARN(GL_PROGRAM_CACHE_WRITE_FAILED);
+            }
+        }
+        _sg_free(binary);
+    #else
+        _SOKOL_UNUSED(key);
+        _SOKOL_UNUSED(gl_prog);
+    #endif
+}
+
 _SOKOL_PRIVATE void _sg_gl_setup_backend(const sg_desc* desc) {
-    _SOKOL_UNUSED(desc);
+    SOKOL_ASSERT(desc->uniform_buffer_size > 0);
     /* assumes that _sg.gl is already zero-initialized */
     _sg.gl.valid = true;
+    _sg.gl.ub.size = desc->uniform_buffer_size;
+    _sg.gl.unpack.size = _sg_roundup(desc->staging_buffer_size, 16);
 
     #if defined(_SOKOL_USE_WIN32_GL_LOADER)
     _sg_gl_load_opengl();
@@ -6890,10 +8274,48 @@ _SOKOL_PRIVATE void _sg_gl_setup_backend(const sg_desc* desc) {
     #elif defined(SOKOL_GLES3)
         _sg_gl_init_caps_gles3();
     #endif
+    if (desc->program_cache_dir) {
+        _sg_gl_program_cache_setup(desc->program_cache_dir);
+    }
+    SOKOL_ASSERT(desc->sampler_cache_size > 0);
+    _sg_smpcache_init(&_sg.gl.sampler_cache, desc->sampler_cache_size);
+    #if defined(_SOKOL_GL_HAS_TIMER_QUERY)
+    if (desc->gpu_timings) {
+        glGenQueries(_SG_GPU_TIMER_NUM_FRAMES * 2 * SG_MAX_GPU_TIMINGS, &_sg.gl.timer_queries[0][0]);
+        _SG_GL_CHECK_ERROR();
+    }
+    #endif
 }
 
 _SOKOL_PRIVATE void _sg_gl_discard_backend(void) {
     SOKOL_ASSERT(_sg.gl.valid);
+    if (_sg.gl.ub.buf[0]) {
+        glDeleteBuffers(SG_NUM_INFLIGHT_FRAMES, _sg.gl.ub.buf);
+    }
+    if (_sg.gl.indirect_buf) {
+        glDeleteBuffers(1, &_sg.gl.indirect_buf);
+    }
+    if (_sg.gl.unpack.buf) {
+        glDeleteBuffers(1, &_sg.gl.unpack.buf);
+    }
+    for (int i = 0; i < _sg.gl.sampler_cache.num_items; i++) {
+        GLuint gl_smp = (GLuint) _sg_smpcache_sampler(&_sg.gl.sampler_cache, i);
+        glDeleteSamplers(1, &gl_smp);
+    }
+    _sg_smpcache_discard(&_sg.gl.sampler_cache);
+    #if defined(_SOKOL_GL_HAS_TIMER_QUERY)
+    if (_sg.gl.timer_queries[0][0]) {
+        glDeleteQueries(_SG_GPU_TIMER_NUM_FRAMES * 2 * SG_MAX_GPU_TIMINGS, &_sg.gl.timer_queries[0][0]);
+    }
+    #endif
+    #if defined(_SOKOL_GL_HAS_BUFFER_STORAGE)
+    for (int i = 0; i < _SG_GL_NUM_FRAME_FENCES; i++) {
+        if (_sg.gl.fences.sync[i]) {
+            glDeleteSync(_sg.gl.fences.sync[i]);
+            _sg.gl.fences.sync[i] = 0;
+        }
+    }
+    #endif
     _sg.gl.valid = false;
     #if defined(_SOKOL_USE_WIN32_GL_LOADER)
     _sg_gl_unload_opengl();
@@ -6925,12 +8347,66 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_context(_sg_context_t* ctx) {
 
 _SOKOL_PRIVATE void _sg_gl_discard_context(_sg_context_t* ctx) {
     SOKOL_ASSERT(ctx);
+    if (ctx == _sg.gl.cur_context) {
+        _sg.gl.cache.cur_vao = 0;
+    }
+    for (int i = 0; i < _SG_GL_VAO_CACHE_SIZE; i++) {
+        if (ctx->vao_cache[i].vao) {
+            glDeleteVertexArrays(1, &ctx->vao_cache[i].vao);
+        }
+    }
     if (ctx->vao) {
         glDeleteVertexArrays(1, &ctx->vao);
     }
     _SG_GL_CHECK_ERROR();
 }
 
+/* allocate immutable storage for the currently bound buffer and map it persistently */
+_SOKOL_PRIVATE uint8_t* _sg_gl_map_buffer_storage(GLenum gl_target, int size) {
+    #if defined(_SOKOL_GL_HAS_BUFFER_STORAGE)
+        SOKOL_ASSERT(_sg.gl.ext_buffer_storage);
+        const GLbitfield gl_flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(gl_target, size, 0, gl_flags);
+        return (uint8_t*) glMapBufferRange(gl_target, 0, size, gl_flags);
+    #else
+        _SOKOL_UNUSED(gl_target);
+        _SOKOL_UNUSED(size);
+        return 0;
+    #endif
+}
+
+/* create all slots of a STREAM buffer as persistently mapped storage, false if mapping failed */
+_SOKOL_PRIVATE bool _sg_gl_create_mapped_buffer(_sg_buffer_t* buf, GLenum gl_target) {
+    bool ok = true;
+    for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
+        GLuint gl_buf = 0;
+        glGenBuffers(1, &gl_buf);
+        SOKOL_ASSERT(gl_buf);
+        _sg_gl_cache_store_buffer_binding(gl_target);
+        _sg_gl_cache_bind_buffer(gl_target, gl_buf);
+        buf->gl.mapped[slot] = _sg_gl_map_buffer_storage(gl_target, buf->cmn.size);
+        _sg_gl_cache_restore_buffer_binding(gl_target);
+        buf->gl.buf[slot] = gl_buf;
+        if (0 == buf->gl.mapped[slot]) {
+            ok = false;
+            break;
+        }
+    }
+    if (!ok) {
+        /* the storage is immutable, start over with new buffer objects */
+        while (glGetError() != GL_NO_ERROR);
+        for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
+            if (buf->gl.buf[slot]) {
+                _sg_gl_cache_invalidate_buffer(buf->gl.buf[slot]);
+                glDeleteBuffers(1, &buf->gl.buf[slot]);
+            }
+        }
+        _sg_clear(buf->gl.buf, sizeof(buf->gl.buf));
+        _sg_clear(buf->gl.mapped, sizeof(buf->gl.mapped));
+    }
+    return ok;
+}
+
 _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
     SOKOL_ASSERT(buf && desc);
     _SG_GL_CHECK_ERROR();
@@ -6938,6 +8414,16 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
     buf->gl.ext_buffers = (0 != desc->gl_buffers[0]);
     const GLenum gl_target = _sg_gl_buffer_target(buf->cmn.type);
     const GLenum gl_usage  = _sg_gl_usage(buf->cmn.usage);
+    if (_sg.gl.ext_buffer_storage && (buf->cmn.usage == SG_USAGE_STREAM) && !buf->gl.ext_buffers) {
+        buf->cmn.num_slots = _SG_GL_MAX_BUFFER_SLOTS;
+        if (_sg_gl_create_mapped_buffer(buf, gl_target)) {
+            _sg.gl.fences.num_mapped_buffers++;
+            _SG_GL_CHECK_ERROR();
+            return SG_RESOURCESTATE_VALID;
+        }
+        _SG_WARN(GL_MAP_BUFFER_STORAGE_FAILED);
+        buf->cmn.num_slots = SG_NUM_INFLIGHT_FRAMES;
+    }
     for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
         GLuint gl_buf = 0;
         if (buf->gl.ext_buffers) {
@@ -6964,6 +8450,10 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_buffer(_sg_buffer_t* buf, const s
 _SOKOL_PRIVATE void _sg_gl_discard_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf);
     _SG_GL_CHECK_ERROR();
+    if (buf->gl.mapped[0]) {
+        SOKOL_ASSERT(_sg.gl.fences.num_mapped_buffers > 0);
+        _sg.gl.fences.num_mapped_buffers--;
+    }
     for (int slot = 0; slot < buf->cmn.num_slots; slot++) {
         if (buf->gl.buf[slot]) {
             _sg_gl_cache_invalidate_buffer(buf->gl.buf[slot]);
@@ -6981,6 +8471,71 @@ _SOKOL_PRIVATE bool _sg_gl_supported_texture_format(sg_pixel_format fmt) {
     return _sg.formats[fmt_index].sample;
 }
 
+_SOKOL_PRIVATE void _sg_gl_border_color(sg_border_color border_color, float* border) {
+    switch (border_color) {
+        case SG_BORDERCOLOR_TRANSPARENT_BLACK:
+            border[0] = 0.0f; border[1] = 0.0f; border[2] = 0.0f; border[3] = 0.0f;
+            break;
+        case SG_BORDERCOLOR_OPAQUE_WHITE:
+            border[0] = 1.0f; border[1] = 1.0f; border[2] = 1.0f; border[3] = 1.0f;
+            break;
+        default:
+            border[0] = 0.0f; border[1] = 0.0f; border[2] = 0.0f; border[3] = 1.0f;
+            break;
+    }
+}
+
+/*
+    return a shared sampler object for the image's sampler state, textures
+    with identical filtering, wrapping, anisotropy, border color and LOD range
+    use the same GL sampler object, returns 0 if the sampler cache is full
+*/
+_SOKOL_PRIVATE GLuint _sg_gl_create_sampler(const _sg_image_t* img, const sg_image_desc* desc) {
+    SOKOL_ASSERT(img && desc);
+    sg_image_desc smp_desc = *desc;
+    if (img->cmn.type == SG_IMAGETYPE_CUBE) {
+        /* cubemaps are always sampled with clamp-to-edge */
+        smp_desc.wrap_u = SG_WRAP_CLAMP_TO_EDGE;
+        smp_desc.wrap_v = SG_WRAP_CLAMP_TO_EDGE;
+        smp_desc.wrap_w = SG_WRAP_CLAMP_TO_EDGE;
+    }
+    int index = _sg_smpcache_find_item(&_sg.gl.sampler_cache, &smp_desc);
+    if (index >= 0) {
+        /* reuse existing sampler */
+        return (GLuint) _sg_smpcache_sampler(&_sg.gl.sampler_cache, index);
+    }
+    if (_sg.gl.sampler_cache.num_items >= _sg.gl.sampler_cache.capacity) {
+        _SG_WARN(GL_SAMPLER_CACHE_FULL);
+        return 0;
+    }
+    GLuint gl_smp = 0;
+    glGenSamplers(1, &gl_smp);
+    SOKOL_ASSERT(gl_smp);
+    glSamplerParameteri(gl_smp, GL_TEXTURE_MIN_FILTER, (GLint)_sg_gl_filter(smp_desc.min_filter));
+    glSamplerParameteri(gl_smp, GL_TEXTURE_MAG_FILTER, (GLint)_sg_gl_filter(smp_desc.mag_filter));
+    if (_sg.gl.ext_anisotropic && (smp_desc.max_anisotropy > 1)) {
+        GLint max_aniso = (GLint) smp_desc.max_anisotropy;
+        if (max_aniso > _sg.gl.max_anisotropy) {
+            max_aniso = _sg.gl.max_anisotropy;
+        }
+        glSamplerParameteri(gl_smp, GL_TEXTURE_MAX_ANISOTROPY_EXT, max_aniso);
+    }
+    glSamplerParameteri(gl_smp, GL_TEXTURE_WRAP_S, (GLint)_sg_gl_wrap(smp_desc.wrap_u));
+    glSamplerParameteri(gl_smp, GL_TEXTURE_WRAP_T, (GLint)_sg_gl_wrap(smp_desc.wrap_v));
+    glSamplerParameteri(gl_smp, GL_TEXTURE_WRAP_R, (GLint)_sg_gl_wrap(smp_desc.wrap_w));
+    #if defined(SOKOL_GLCORE33)
+    float border[4];
+    _sg_gl_border_color(smp_desc.border_color, border);
+    glSamplerParameterfv(gl_smp, GL_TEXTURE_BORDER_COLOR, border);
+    #endif
+    /* GL spec has strange defaults for mipmap min/max lod: -1000 to +1000 */
+    glSamplerParameterf(gl_smp, GL_TEXTURE_MIN_LOD, _sg_clamp(smp_desc.min_lod, 0.0f, 1000.0f));
+    glSamplerParameterf(gl_smp, GL_TEXTURE_MAX_LOD, _sg_clamp(smp_desc.max_lod, 0.0f, 1000.0f));
+    _SG_GL_CHECK_ERROR();
+    _sg_smpcache_add_item(&_sg.gl.sampler_cache, &smp_desc, (uintptr_t)gl_smp);
+    return gl_smp;
+}
+
 _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_image_desc* desc) {
     SOKOL_ASSERT(img && desc);
     _SG_GL_CHECK_ERROR();
@@ -7013,6 +8568,7 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
     } else {
         // create our own GL texture(s)
         img->gl.target = _sg_gl_texture_target(img->cmn.type);
+        img->gl.sampler = _sg_gl_create_sampler(img, desc);
         const GLenum gl_format = _sg_gl_teximage_format(img->cmn.pixel_format);
         const bool is_compressed = _sg_is_compressed_pixel_format(img->cmn.pixel_format);
         for (int slot = 0; slot < img->cmn.num_slots; slot++) {
@@ -7020,51 +8576,47 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
             SOKOL_ASSERT(img->gl.tex[slot]);
             _sg_gl_cache_store_texture_binding(0);
             _sg_gl_cache_bind_texture(0, img->gl.target, img->gl.tex[slot]);
-            const GLenum gl_min_filter = _sg_gl_filter(img->cmn.min_filter);
-            const GLenum gl_mag_filter = _sg_gl_filter(img->cmn.mag_filter);
-            glTexParameteri(img->gl.target, GL_TEXTURE_MIN_FILTER, (GLint)gl_min_filter);
-            glTexParameteri(img->gl.target, GL_TEXTURE_MAG_FILTER, (GLint)gl_mag_filter);
-            if (_sg.gl.ext_anisotropic && (img->cmn.max_anisotropy > 1)) {
-                GLint max_aniso = (GLint) img->cmn.max_anisotropy;
-                if (max_aniso > _sg.gl.max_anisotropy) {
-                    max_aniso = _sg.gl.max_anisotropy;
-                }
-                glTexParameteri(img->gl.target, GL_TEXTURE_MAX_ANISOTROPY_EXT, max_aniso);
-            }
-            if (img->cmn.type == SG_IMAGETYPE_CUBE) {
-                glTexParameteri(img->gl.target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(img->gl.target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            } else {
-                glTexParameteri(img->gl.target, GL_TEXTURE_WRAP_S, (GLint)_sg_gl_wrap(img->cmn.wrap_u));
-                glTexParameteri(img->gl.target, GL_TEXTURE_WRAP_T, (GLint)_sg_gl_wrap(img->cmn.wrap_v));
-                if (img->cmn.type == SG_IMAGETYPE_3D) {
-                    glTexParameteri(img->gl.target, GL_TEXTURE_WRAP_R, (GLint)_sg_gl_wrap(img->cmn.wrap_w));
+            /* only without a shared sampler object (sampler cache full) */
+            if (0 == img->gl.sampler) {
+                const GLenum gl_min_filter = _sg_gl_filter(img->cmn.min_filter);
+                const GLenum gl_mag_filter = _sg_gl_filter(img->cmn.mag_filter);
+                glTexParameteri(img->gl.target, GL_TEXTURE_MIN_FILTER, (GLint)gl_min_filter);
+                glTexParameteri(img->gl.target, GL_TEXTURE_MAG_FILTER, (GLint)gl_mag_filter);
+                if (_sg.gl.ext_anisotropic && (img->cmn.max_anisotropy > 1)) {
+                    GLint max_aniso = (GLint) img->cmn.max_anisotropy;
+                    if (max_aniso > _sg.gl.max_anisotropy) {
+                        max_aniso = _sg.gl.max_anisotropy;
+                    }
+                    glTexParameteri(img->gl.target, GL_TEXTURE_MAX_ANISOTROPY_EXT, max_aniso);
                 }
-                #if defined(SOKOL_GLCORE33)
-                float border[4];
-                switch (img->cmn.border_color) {
-                    case SG_BORDERCOLOR_TRANSPARENT_BLACK:
-                        border[0] = 0.0f; border[1] = 0.0f; border[2] = 0.0f; border[3] = 0.0f;
-                        break;
-                    case SG_BORDERCOLOR_OPAQUE_WHITE:
-                        border[0] = 1.0f; border[1] = 1.0f; border[2] = 1.0f; border[3] = 1.0f;
-                        break;
-                    default:
-                        border[0] = 0.0f; border[1] = 0.0f; border[2] = 0.0f; border[3] = 1.0f;
-                        break;
+                if (img->cmn.type == SG_IMAGETYPE_CUBE) {
+                    glTexParameteri(img->gl.target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                    glTexParameteri(img->gl.target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                } else {
+                    glTexParameteri(img->gl.target, GL_TEXTURE_WRAP_S, (GLint)_sg_gl_wrap(img->cmn.wrap_u));
+                    glTexParameteri(img->gl.target, GL_TEXTURE_WRAP_T, (GLint)_sg_gl_wrap(img->cmn.wrap_v));
+                    if (img->cmn.type == SG_IMAGETYPE_3D) {
+                        glTexParameteri(img->gl.target, GL_TEXTURE_WRAP_R, (GLint)_sg_gl_wrap(img->cmn.wrap_w));
+                    }
+                    #if defined(SOKOL_GLCORE33)
+                    float border[4];
+                    _sg_gl_border_color(img->cmn.border_color, border);
+                    glTexParameterfv(img->gl.target, GL_TEXTURE_BORDER_COLOR, border);
+                    #endif
                 }
-                glTexParameterfv(img->gl.target, GL_TEXTURE_BORDER_COLOR, border);
-                #endif
+                /* GL spec has strange defaults for mipmap min/max lod: -1000 to +1000 */
+                const float min_lod = _sg_clamp(desc->min_lod, 0.0f, 1000.0f);
+                const float max_lod = _sg_clamp(desc->max_lod, 0.0f, 1000.0f);
+                glTexParameterf(img->gl.target, GL_TEXTURE_MIN_LOD, min_lod);
+                glTexParameterf(img->gl.target, GL_TEXTURE_MAX_LOD, max_lod);
             }
-            /* GL spec has strange defaults for mipmap min/max lod: -1000 to +1000 */
-            const float min_lod = _sg_clamp(desc->min_lod, 0.0f, 1000.0f);
-            const float max_lod = _sg_clamp(desc->max_lod, 0.0f, 1000.0f);
-            glTexParameterf(img->gl.target, GL_TEXTURE_MIN_LOD, min_lod);
-            glTexParameterf(img->gl.target, GL_TEXTURE_MAX_LOD, max_lod);
             const int num_faces = img->cmn.type == SG_IMAGETYPE_CUBE ? 6 : 1;
+            /* with GPU mipmap generation only the top level is uploaded */
+            const bool gen_mipmaps = (desc->generate_mipmaps == SG_MIPMAPGEN_GPU) && (img->cmn.num_mipmaps > 1);
+            const int num_upload_mipmaps = gen_mipmaps ? 1 : img->cmn.num_mipmaps;
             int data_index = 0;
             for (int face_index = 0; face_index < num_faces; face_index++) {
-                for (int mip_index = 0; mip_index < img->cmn.num_mipmaps; mip_index++, data_index++) {
+                for (int mip_index = 0; mip_index < num_upload_mipmaps; mip_index++, data_index++) {
                     GLenum gl_img_target = img->gl.target;
                     if (SG_IMAGETYPE_CUBE == img->cmn.type) {
                         gl_img_target = _sg_gl_cubeface_target(face_index);
@@ -7108,6 +8660,10 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_image(_sg_image_t* img, const sg_
                     }
                 }
             }
+            if (gen_mipmaps) {
+                glTexParameteri(img->gl.target, GL_TEXTURE_MAX_LEVEL, img->cmn.num_mipmaps - 1);
+                glGenerateMipmap(img->gl.target);
+            }
             _sg_gl_cache_restore_texture_binding(0);
         }
     }
@@ -7132,16 +8688,12 @@ _SOKOL_PRIVATE void _sg_gl_discard_image(_sg_image_t* img) {
     _SG_GL_CHECK_ERROR();
 }
 
-_SOKOL_PRIVATE GLuint _sg_gl_compile_shader(sg_shader_stage stage, const char* src) {
-    SOKOL_ASSERT(src);
-    _SG_GL_CHECK_ERROR();
-    GLuint gl_shd = glCreateShader(_sg_gl_shader_stage(stage));
-    glShaderSource(gl_shd, 1, &src, 0);
-    glCompileShader(gl_shd);
+/* returns false if compilation failed, the shader object is left alive */
+_SOKOL_PRIVATE bool _sg_gl_check_compile_status(GLuint gl_shd) {
     GLint compile_status = 0;
     glGetShaderiv(gl_shd, GL_COMPILE_STATUS, &compile_status);
     if (!compile_status) {
-        /* compilation failed, log error and delete shader */
+        /* compilation failed, log error */
         GLint log_len = 0;
         glGetShaderiv(gl_shd, GL_INFO_LOG_LENGTH, &log_len);
         if (log_len > 0) {
@@ -7151,39 +8703,13 @@ _SOKOL_PRIVATE GLuint _sg_gl_compile_shader(sg_shader_stage stage, const char* s
             _SG_LOGMSG(GL_SHADER_COMPILATION_FAILED, log_buf);
             _sg_free(log_buf);
         }
-        glDeleteShader(gl_shd);
-        gl_shd = 0;
     }
-    _SG_GL_CHECK_ERROR();
-    return gl_shd;
+    return 0 != compile_status;
 }
 
-_SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
-    SOKOL_ASSERT(shd && desc);
-    SOKOL_ASSERT(!shd->gl.prog);
-    _SG_GL_CHECK_ERROR();
-
-    _sg_shader_common_init(&shd->cmn, desc);
-
-    /* copy vertex attribute names over, these are used by, but optional on GLES3 and GL3.x */
-    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
-        _sg_strcpy(&shd->gl.attrs[i].name, desc->attrs[i].name);
-    }
-
-    GLuint gl_vs = _sg_gl_compile_shader(SG_SHADERSTAGE_VS, desc->vs.source);
-    GLuint gl_fs = _sg_gl_compile_shader(SG_SHADERSTAGE_FS, desc->fs.source);
-    if (!(gl_vs && gl_fs)) {
-        return SG_RESOURCESTATE_FAILED;
-    }
-    GLuint gl_prog = glCreateProgram();
-    glAttachShader(gl_prog, gl_vs);
-    glAttachShader(gl_prog, gl_fs);
-    glLinkProgram(gl_prog);
-    glDeleteShader(gl_vs);
-    glDeleteShader(gl_fs);
-    _SG_GL_CHECK_ERROR();
-
-    GLint link_status;
+/* returns false if linking failed, the program object is left alive */
+_SOKOL_PRIVATE bool _sg_gl_check_link_status(GLuint gl_prog) {
+    GLint link_status = 0;
     glGetProgramiv(gl_prog, GL_LINK_STATUS, &link_status);
     if (!link_status) {
         GLint log_len = 0;
@@ -7195,10 +8721,98 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
             _SG_LOGMSG(GL_SHADER_LINKING_FAILED, log_buf);
             _sg_free(log_buf);
         }
-        glDeleteProgram(gl_prog);
-        return SG_RESOURCESTATE_FAILED;
     }
-    shd->gl.prog = gl_prog;
+    return 0 != link_status;
+}
+
+/* starts compilation without waiting for the result */
+_SOKOL_PRIVATE GLuint _sg_gl_start_compile_shader(sg_shader_stage stage, const char* src) {
+    SOKOL_ASSERT(src);
+    _SG_GL_CHECK_ERROR();
+    GLuint gl_shd = glCreateShader(_sg_gl_shader_stage(stage));
+    glShaderSource(gl_shd, 1, &src, 0);
+    glCompileShader(gl_shd);
+    _SG_GL_CHECK_ERROR();
+    return gl_shd;
+}
+
+_SOKOL_PRIVATE GLuint _sg_gl_compile_shader(sg_shader_stage stage, const char* src) {
+    GLuint gl_shd = _sg_gl_start_compile_shader(stage, src);
+    if (!_sg_gl_check_compile_status(gl_shd)) {
+        glDeleteShader(gl_shd);
+        gl_shd = 0;
+    }
+    _SG_GL_CHECK_ERROR();
+    return gl_shd;
+}
+
+/* starts linking without waiting for the result, the shaders are not deleted */
+_SOKOL_PRIVATE GLuint _sg_gl_start_link_program(GLuint gl_vs, GLuint gl_fs) {
+    GLuint gl_prog = glCreateProgram();
+    #if defined(_SOKOL_GL_HAS_PROGRAM_BINARY)
+    if (_sg.gl.program_cache.enabled) {
+        glProgramParameteri(gl_prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    #endif
+    glAttachShader(gl_prog, gl_vs);
+    glAttachShader(gl_prog, gl_fs);
+    glLinkProgram(gl_prog);
+    _SG_GL_CHECK_ERROR();
+    return gl_prog;
+}
+
+/* copies a string behind the desc copy and patches the pointer, with dst == 0 only counts */
+_SOKOL_PRIVATE size_t _sg_gl_copy_name(const char** name, char* dst, size_t pos) {
+    if (*name) {
+        const size_t len = strlen(*name) + 1;
+        if (dst) {
+            memcpy(dst + pos, *name, len);
+            *name = dst + pos;
+        }
+        pos += len;
+    }
+    return pos;
+}
+
+_SOKOL_PRIVATE size_t _sg_gl_copy_shader_names(sg_shader_desc* desc, char* dst) {
+    size_t pos = 0;
+    for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+        sg_shader_stage_desc* stage_desc = (stage_index == SG_SHADERSTAGE_VS)? &desc->vs : &desc->fs;
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            sg_shader_uniform_block_desc* ub_desc = &stage_desc->uniform_blocks[ub_index];
+            pos = _sg_gl_copy_name(&ub_desc->name, dst, pos);
+            for (int u_index = 0; u_index < SG_MAX_UB_MEMBERS; u_index++) {
+                pos = _sg_gl_copy_name(&ub_desc->uniforms[u_index].name, dst, pos);
+            }
+        }
+        for (int img_index = 0; img_index < SG_MAX_SHADERSTAGE_IMAGES; img_index++) {
+            pos = _sg_gl_copy_name(&stage_desc->images[img_index].name, dst, pos);
+        }
+    }
+    return pos;
+}
+
+/* the application's desc strings don't need to outlive sg_make_shader(), so a
+   pending shader keeps a copy of the desc with the names needed by
+   _sg_gl_resolve_shader() in a single allocation
+*/
+_SOKOL_PRIVATE sg_shader_desc* _sg_gl_copy_shader_desc(const sg_shader_desc* desc) {
+    sg_shader_desc tmp = *desc;
+    const size_t names_size = _sg_gl_copy_shader_names(&tmp, 0);
+    sg_shader_desc* copy = (sg_shader_desc*) _sg_malloc(sizeof(sg_shader_desc) + names_size);
+    *copy = *desc;
+    _sg_gl_copy_shader_names(copy, (char*)(copy + 1));
+    /* the sources have already been passed to GL */
+    copy->vs.source = 0;
+    copy->fs.source = 0;
+    copy->label = 0;
+    return copy;
+}
+
+/* looks up uniform, uniform block and texture locations of a linked program */
+_SOKOL_PRIVATE sg_resource_state _sg_gl_resolve_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
+    GLuint gl_prog = shd->gl.prog;
+    SOKOL_ASSERT(gl_prog);
 
     /* resolve uniforms */
     _SG_GL_CHECK_ERROR();
@@ -7235,8 +8849,38 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
             if (ub_desc->layout == SG_UNIFORMLAYOUT_STD140) {
                 cur_uniform_offset = _sg_align_u32(cur_uniform_offset, 16);
             }
-            SOKOL_ASSERT(ub_desc->size == (size_t)cur_uniform_offset);
+            SOKOL_ASSERT((ub->num_uniforms == 0) || (ub_desc->size == (size_t)cur_uniform_offset));
             _SOKOL_UNUSED(cur_uniform_offset);
+            if (ub_desc->name) {
+                SOKOL_ASSERT(ub_desc->layout == SG_UNIFORMLAYOUT_STD140);
+                const GLuint gl_block_index = glGetUniformBlockIndex(gl_prog, ub_desc->name);
+                if (ub_desc->size > (size_t)_sg.gl.ub.size) {
+                    _SG_ERROR(GL_UNIFORMBLOCK_TOO_BIG);
+                    _SG_LOGMSG(GL_UNIFORMBLOCK_TOO_BIG, ub_desc->name);
+                    glDeleteProgram(gl_prog);
+                    shd->gl.prog = 0;
+                    return SG_RESOURCESTATE_FAILED;
+                }
+                if (gl_block_index != GL_INVALID_INDEX) {
+                    GLint gl_block_size = 0;
+                    glGetActiveUniformBlockiv(gl_prog, gl_block_index, GL_UNIFORM_BLOCK_DATA_SIZE, &gl_block_size);
+                    if ((size_t)gl_block_size > ub_desc->size) {
+                        _SG_ERROR(GL_UNIFORMBLOCK_SIZE_MISMATCH);
+                        _SG_LOGMSG(GL_UNIFORMBLOCK_SIZE_MISMATCH, ub_desc->name);
+                        glDeleteProgram(gl_prog);
+                        shd->gl.prog = 0;
+                        return SG_RESOURCESTATE_FAILED;
+                    }
+                    glUniformBlockBinding(gl_prog, gl_block_index, _sg_gl_ub_binding(stage_index, ub_index));
+                    ub->use_ubo = true;
+                } else {
+                    _SG_ERROR(GL_UNIFORMBLOCK_NAME_NOT_FOUND_IN_SHADER);
+                    _SG_LOGMSG(GL_UNIFORMBLOCK_NAME_NOT_FOUND_IN_SHADER, ub_desc->name);
+                    glDeleteProgram(gl_prog);
+                    shd->gl.prog = 0;
+                    return SG_RESOURCESTATE_FAILED;
+                }
+            }
         }
     }
 
@@ -7273,6 +8917,105 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const s
     return SG_RESOURCESTATE_VALID;
 }
 
+_SOKOL_PRIVATE sg_resource_state _sg_gl_create_shader(_sg_shader_t* shd, const sg_shader_desc* desc) {
+    SOKOL_ASSERT(shd && desc);
+    SOKOL_ASSERT(!shd->gl.prog);
+    _SG_GL_CHECK_ERROR();
+
+    _sg_shader_common_init(&shd->cmn, desc);
+
+    /* copy vertex attribute names over, these are used by, but optional on GLES3 and GL3.x */
+    for (int i = 0; i < SG_MAX_VERTEX_ATTRIBUTES; i++) {
+        _sg_strcpy(&shd->gl.attrs[i].name, desc->attrs[i].name);
+    }
+
+    /* try the program binary cache first */
+    const bool use_cache = _sg.gl.program_cache.enabled;
+    const uint64_t start_us = _sg_time_us();
+    uint64_t cache_key = 0;
+    GLuint gl_prog = 0;
+    if (use_cache) {
+        cache_key = _sg_gl_program_cache_key(desc);
+        gl_prog = _sg_gl_program_cache_load(cache_key);
+    }
+    if (gl_prog) {
+        _sg.gl.program_cache.stats.num_hits++;
+        _sg.gl.program_cache.stats.time_hits_us += _sg_time_us() - start_us;
+    } else if (_sg.desc.async_shader_compile) {
+        /* don't query any status here, _sg_gl_poll_shader() finishes the program in sg_commit() */
+        shd->gl.pending.vs = _sg_gl_start_compile_shader(SG_SHADERSTAGE_VS, desc->vs.source);
+        shd->gl.pending.fs = _sg_gl_start_compile_shader(SG_SHADERSTAGE_FS, desc->fs.source);
+        shd->gl.prog = _sg_gl_start_link_program(shd->gl.pending.vs, shd->gl.pending.fs);
+        shd->gl.pending.frame_index = _sg.frame_index;
+        shd->gl.pending.cache_key = cache_key;
+        shd->gl.pending.desc = _sg_gl_copy_shader_desc(desc);
+        shd->gl.pending.time_us = _sg_time_us() - start_us;
+        return SG_RESOURCESTATE_PENDING;
+    } else {
+        GLuint gl_vs = _sg_gl_compile_shader(SG_SHADERSTAGE_VS, desc->vs.source);
+        GLuint gl_fs = _sg_gl_compile_shader(SG_SHADERSTAGE_FS, desc->fs.source);
+        if (!(gl_vs && gl_fs)) {
+            return SG_RESOURCESTATE_FAILED;
+        }
+        gl_prog = _sg_gl_start_link_program(gl_vs, gl_fs);
+        glDeleteShader(gl_vs);
+        glDeleteShader(gl_fs);
+        _SG_GL_CHECK_ERROR();
+        if (!_sg_gl_check_link_status(gl_prog)) {
+            glDeleteProgram(gl_prog);
+            return SG_RESOURCESTATE_FAILED;
+        }
+        if (use_cache) {
+            _sg.gl.program_cache.stats.num_misses++;
+            _sg.gl.program_cache.stats.time_misses_us += _sg_time_us() - start_us;
+            _sg_gl_program_cache_store(cache_key, gl_prog);
+        }
+    }
+    shd->gl.prog = gl_prog;
+    return _sg_gl_resolve_shader(shd, desc);
+}
+
+/* called from sg_commit() for PENDING shaders, returns PENDING while the driver is still busy */
+_SOKOL_PRIVATE sg_resource_state _sg_gl_poll_shader(_sg_shader_t* shd) {
+    SOKOL_ASSERT(shd && shd->gl.prog && shd->gl.pending.desc);
+    if (_sg.gl.ext_parallel_shader_compile) {
+        GLint completed = 0;
+        glGetProgramiv(shd->gl.prog, GL_COMPLETION_STATUS_KHR, &completed);
+        if (!completed) {
+            return SG_RESOURCESTATE_PENDING;
+        }
+    } else if (shd->gl.pending.frame_index == _sg.frame_index) {
+        /* give the driver at least one frame before blocking on the status */
+        return SG_RESOURCESTATE_PENDING;
+    }
+    const uint64_t start_us = _sg_time_us();
+    /* query both shaders so that all compile errors are logged */
+    bool ok = _sg_gl_check_compile_status(shd->gl.pending.vs);
+    ok = _sg_gl_check_compile_status(shd->gl.pending.fs) && ok;
+    ok = ok && _sg_gl_check_link_status(shd->gl.prog);
+    glDeleteShader(shd->gl.pending.vs);
+    glDeleteShader(shd->gl.pending.fs);
+    shd->gl.pending.vs = 0;
+    shd->gl.pending.fs = 0;
+    sg_shader_desc* desc = shd->gl.pending.desc;
+    shd->gl.pending.desc = 0;
+    sg_resource_state state = SG_RESOURCESTATE_FAILED;
+    if (ok) {
+        if (_sg.gl.program_cache.enabled) {
+            _sg.gl.program_cache.stats.num_misses++;
+            _sg.gl.program_cache.stats.time_misses_us += shd->gl.pending.time_us + (_sg_time_us() - start_us);
+            _sg_gl_program_cache_store(shd->gl.pending.cache_key, shd->gl.prog);
+        }
+        state = _sg_gl_resolve_shader(shd, desc);
+    } else {
+        glDeleteProgram(shd->gl.prog);
+        shd->gl.prog = 0;
+    }
+    _sg_free(desc);
+    _SG_GL_CHECK_ERROR();
+    return state;
+}
+
 _SOKOL_PRIVATE void _sg_gl_discard_shader(_sg_shader_t* shd) {
     SOKOL_ASSERT(shd);
     _SG_GL_CHECK_ERROR();
@@ -7280,9 +9023,79 @@ _SOKOL_PRIVATE void _sg_gl_discard_shader(_sg_shader_t* shd) {
         _sg_gl_cache_invalidate_program(shd->gl.prog);
         glDeleteProgram(shd->gl.prog);
     }
+    /* a shader discarded while still pending */
+    if (shd->gl.pending.vs) {
+        glDeleteShader(shd->gl.pending.vs);
+    }
+    if (shd->gl.pending.fs) {
+        glDeleteShader(shd->gl.pending.fs);
+    }
+    if (shd->gl.pending.desc) {
+        _sg_free(shd->gl.pending.desc);
+    }
     _SG_GL_CHECK_ERROR();
 }
 
+/* FNV-1a over the state values, never returns the 'unknown' hash 0 */
+_SOKOL_PRIVATE uint64_t _sg_gl_state_hash_u32(uint64_t hash, uint32_t val) {
+    for (int i = 0; i < 4; i++) {
+        hash = (hash ^ ((val >> (i * 8)) & 0xFF)) * 1099511628211u;
+    }
+    return (hash == 0) ? 1 : hash;
+}
+
+_SOKOL_PRIVATE uint64_t _sg_gl_state_hash_f32(uint64_t hash, float val) {
+    uint32_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    return _sg_gl_state_hash_u32(hash, bits);
+}
+
+_SOKOL_PRIVATE void _sg_gl_init_state_hashes(_sg_pipeline_t* pip) {
+    const uint64_t basis = 14695981039346656037u;
+    _sg_gl_state_hashes_t* h = &pip->gl.hashes;
+
+    const sg_depth_state* ds = &pip->gl.depth;
+    h->depth = _sg_gl_state_hash_u32(basis, (uint32_t)ds->compare);
+    h->depth = _sg_gl_state_hash_u32(h->depth, ds->write_enabled ? 1 : 0);
+    h->depth = _sg_gl_state_hash_f32(h->depth, ds->bias);
+    h->depth = _sg_gl_state_hash_f32(h->depth, ds->bias_slope_scale);
+
+    const sg_stencil_state* ss = &pip->gl.stencil;
+    h->stencil = _sg_gl_state_hash_u32(basis, ss->enabled ? 1 : 0);
+    h->stencil = _sg_gl_state_hash_u32(h->stencil, ss->write_mask);
+    h->stencil = _sg_gl_state_hash_u32(h->stencil, ss->read_mask);
+    h->stencil = _sg_gl_state_hash_u32(h->stencil, ss->ref);
+    for (int i = 0; i < 2; i++) {
+        const sg_stencil_face_state* sfs = (i==0)? &ss->front : &ss->back;
+        h->stencil = _sg_gl_state_hash_u32(h->stencil, (uint32_t)sfs->compare);
+        h->stencil = _sg_gl_state_hash_u32(h->stencil, (uint32_t)sfs->fail_op);
+        h->stencil = _sg_gl_state_hash_u32(h->stencil, (uint32_t)sfs->depth_fail_op);
+        h->stencil = _sg_gl_state_hash_u32(h->stencil, (uint32_t)sfs->pass_op);
+    }
+
+    const sg_blend_state* bs = &pip->gl.blend;
+    h->blend = _sg_gl_state_hash_u32(basis, bs->enabled ? 1 : 0);
+    h->blend = _sg_gl_state_hash_u32(h->blend, (uint32_t)bs->src_factor_rgb);
+    h->blend = _sg_gl_state_hash_u32(h->blend, (uint32_t)bs->dst_factor_rgb);
+    h->blend = _sg_gl_state_hash_u32(h->blend, (uint32_t)bs->op_rgb);
+    h->blend = _sg_gl_state_hash_u32(h->blend, (uint32_t)bs->src_factor_alpha);
+    h->blend = _sg_gl_state_hash_u32(h->blend, (uint32_t)bs->dst_factor_alpha);
+    h->blend = _sg_gl_state_hash_u32(h->blend, (uint32_t)bs->op_alpha);
+    h->blend = _sg_gl_state_hash_u32(h->blend, (uint32_t)pip->cmn.color_count);
+    for (int i = 0; i < pip->cmn.color_count; i++) {
+        h->blend = _sg_gl_state_hash_u32(h->blend, (uint32_t)pip->gl.color_write_mask[i]);
+    }
+    h->blend = _sg_gl_state_hash_f32(h->blend, pip->cmn.blend_color.r);
+    h->blend = _sg_gl_state_hash_f32(h->blend, pip->cmn.blend_color.g);
+    h->blend = _sg_gl_state_hash_f32(h->blend, pip->cmn.blend_color.b);
+    h->blend = _sg_gl_state_hash_f32(h->blend, pip->cmn.blend_color.a);
+
+    h->raster = _sg_gl_state_hash_u32(basis, (uint32_t)pip->gl.cull_mode);
+    h->raster = _sg_gl_state_hash_u32(h->raster, (uint32_t)pip->gl.face_winding);
+    h->raster = _sg_gl_state_hash_u32(h->raster, pip->gl.alpha_to_coverage_enabled ? 1 : 0);
+    h->raster = _sg_gl_state_hash_u32(h->raster, (uint32_t)pip->gl.sample_count);
+}
+
 _SOKOL_PRIVATE sg_resource_state _sg_gl_create_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_pipeline_desc* desc) {
     SOKOL_ASSERT(pip && shd && desc);
     SOKOL_ASSERT(!pip->shader && pip->cmn.shader_id.id == SG_INVALID_ID);
@@ -7302,6 +9115,7 @@ _SOKOL_PRIVATE sg_resource_state _sg_gl_create_pipeline(_sg_pipeline_t* pip, _sg
     pip->gl.face_winding = desc->face_winding;
     pip->gl.sample_count = desc->sample_count;
     pip->gl.alpha_to_coverage_enabled = desc->alpha_to_coverage_enabled;
+    _sg_gl_init_state_hashes(pip);
 
     /* resolve vertex attributes */
     for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
@@ -7582,6 +9396,7 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
                 need_pip_cache_flush = true;
                 need_color_mask_flush = true;
                 _sg.gl.cache.color_write_mask[i] = SG_COLORMASK_RGBA;
+                _sg.gl.cache.hashes.blend = 0;
             }
         }
         if (need_color_mask_flush) {
@@ -7592,11 +9407,13 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
         if (!_sg.gl.cache.depth.write_enabled) {
             need_pip_cache_flush = true;
             _sg.gl.cache.depth.write_enabled = true;
+            _sg.gl.cache.hashes.depth = 0;
             glDepthMask(GL_TRUE);
         }
         if (_sg.gl.cache.depth.compare != SG_COMPAREFUNC_ALWAYS) {
             need_pip_cache_flush = true;
             _sg.gl.cache.depth.compare = SG_COMPAREFUNC_ALWAYS;
+            _sg.gl.cache.hashes.depth = 0;
             glDepthFunc(GL_ALWAYS);
         }
     }
@@ -7604,6 +9421,7 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
         if (_sg.gl.cache.stencil.write_mask != 0xFF) {
             need_pip_cache_flush = true;
             _sg.gl.cache.stencil.write_mask = 0xFF;
+            _sg.gl.cache.hashes.stencil = 0;
             glStencilMask(0xFF);
         }
     }
@@ -7638,6 +9456,88 @@ _SOKOL_PRIVATE void _sg_gl_begin_pass(_sg_pass_t* pass, const sg_pass_action* ac
     _SG_GL_CHECK_ERROR();
 }
 
+/* memory size of one pass attachment in bytes, only used for the frame stats */
+_SOKOL_PRIVATE uint32_t _sg_gl_attachment_size(sg_pixel_format fmt, int width, int height, int sample_count, GLenum gl_att) {
+    int bytes_per_sample;
+    if (gl_att == GL_STENCIL_ATTACHMENT) {
+        bytes_per_sample = 1;
+    } else if (gl_att == GL_DEPTH_ATTACHMENT) {
+        bytes_per_sample = (fmt == SG_PIXELFORMAT_DEPTH_STENCIL) ? 3 : 4;
+    } else {
+        bytes_per_sample = _sg_pixelformat_bytesize(fmt);
+    }
+    return (uint32_t)(width * height * _sg_max(sample_count, 1) * bytes_per_sample);
+}
+
+/*
+    discard attachments with SG_STOREACTION_DONTCARE at the end of a pass,
+    expects the pass framebuffer to be bound, this tells tile-based and
+    software drivers that the content doesn't need to be written back
+*/
+_SOKOL_PRIVATE void _sg_gl_invalidate_attachments(void) {
+    #if defined(_SOKOL_GL_HAS_INVALIDATE_FRAMEBUFFER)
+    if (!_sg.gl.ext_invalidate_framebuffer) {
+        return;
+    }
+    GLenum invalidate_atts[SG_MAX_COLOR_ATTACHMENTS + 2] = { 0 };
+    int att_index = 0;
+    uint32_t size = 0;
+    const _sg_pass_t* pass = _sg.gl.cur_pass;
+    if (pass) {
+        for (int i = 0; i < pass->cmn.num_color_atts; i++) {
+            if (_sg.gl.color_store_actions[i] == SG_STOREACTION_DONTCARE) {
+                const _sg_image_t* img = pass->gl.color_atts[i].image;
+                const int mip_level = pass->cmn.color_atts[i].mip_level;
+                invalidate_atts[att_index++] = (GLenum)(GL_COLOR_ATTACHMENT0 + i);
+                size += _sg_gl_attachment_size(img->cmn.pixel_format,
+                    _sg_max(img->cmn.width >> mip_level, 1), _sg_max(img->cmn.height >> mip_level, 1),
+                    img->cmn.sample_count, GL_COLOR_ATTACHMENT0);
+            }
+        }
+        const _sg_image_t* ds_img = pass->gl.ds_att.image;
+        if (ds_img) {
+            const int mip_level = pass->cmn.ds_att.mip_level;
+            const int w = _sg_max(ds_img->cmn.width >> mip_level, 1);
+            const int h = _sg_max(ds_img->cmn.height >> mip_level, 1);
+            if (_sg.gl.depth_store_action == SG_STOREACTION_DONTCARE) {
+                invalidate_atts[att_index++] = GL_DEPTH_ATTACHMENT;
+                size += _sg_gl_attachment_size(ds_img->cmn.pixel_format, w, h, ds_img->cmn.sample_count, GL_DEPTH_ATTACHMENT);
+            }
+            if ((_sg.gl.stencil_store_action == SG_STOREACTION_DONTCARE) && (ds_img->cmn.pixel_format == SG_PIXELFORMAT_DEPTH_STENCIL)) {
+                invalidate_atts[att_index++] = GL_STENCIL_ATTACHMENT;
+                size += _sg_gl_attachment_size(ds_img->cmn.pixel_format, w, h, ds_img->cmn.sample_count, GL_STENCIL_ATTACHMENT);
+            }
+        }
+    } else {
+        /* the default framebuffer uses different attachment names if it's the window system framebuffer */
+        SOKOL_ASSERT(_sg.gl.cur_context);
+        const bool window_fb = (0 == _sg.gl.cur_context->default_framebuffer);
+        const int w = _sg.gl.cur_pass_width;
+        const int h = _sg.gl.cur_pass_height;
+        const int sample_count = _sg.desc.context.sample_count;
+        if (_sg.gl.color_store_actions[0] == SG_STOREACTION_DONTCARE) {
+            invalidate_atts[att_index++] = window_fb ? GL_COLOR : GL_COLOR_ATTACHMENT0;
+            size += _sg_gl_attachment_size(_sg.desc.context.color_format, w, h, sample_count, GL_COLOR_ATTACHMENT0);
+        }
+        if (_sg.desc.context.depth_format != SG_PIXELFORMAT_NONE) {
+            if (_sg.gl.depth_store_action == SG_STOREACTION_DONTCARE) {
+                invalidate_atts[att_index++] = window_fb ? GL_DEPTH : GL_DEPTH_ATTACHMENT;
+                size += _sg_gl_attachment_size(_sg.desc.context.depth_format, w, h, sample_count, GL_DEPTH_ATTACHMENT);
+            }
+            if ((_sg.gl.stencil_store_action == SG_STOREACTION_DONTCARE) && (_sg.desc.context.depth_format == SG_PIXELFORMAT_DEPTH_STENCIL)) {
+                invalidate_atts[att_index++] = window_fb ? GL_STENCIL : GL_STENCIL_ATTACHMENT;
+                size += _sg_gl_attachment_size(_sg.desc.context.depth_format, w, h, sample_count, GL_STENCIL_ATTACHMENT);
+            }
+        }
+    }
+    if (att_index > 0) {
+        glInvalidateFramebuffer(GL_FRAMEBUFFER, att_index, invalidate_atts);
+        _sg_stats_add(gl.num_invalidate_attachment, (uint32_t)att_index);
+        _sg_stats_add(gl.size_invalidate_attachment, size);
+    }
+    #endif
+}
+
 _SOKOL_PRIVATE void _sg_gl_end_pass(void) {
     SOKOL_ASSERT(_sg.gl.in_pass);
     _SG_GL_CHECK_ERROR();
@@ -7663,26 +9563,12 @@ _SOKOL_PRIVATE void _sg_gl_end_pass(void) {
             }
         }
 
-        // invalidate framebuffers
-        #if defined(SOKOL_GLES3)
-        GLenum invalidate_atts[SG_MAX_COLOR_ATTACHMENTS + 2] = { 0 };
-        int att_index = 0;
-        for (int i = 0; i < num_atts; i++) {
-            if (_sg.gl.color_store_actions[i] == SG_STOREACTION_DONTCARE) {
-                invalidate_atts[att_index++] = (GLenum)(GL_COLOR_ATTACHMENT0 + i);
-            }
+        // rebind the pass framebuffer after MSAA resolves, invalidating also discards the multisampled source
+        if (fb_bound) {
+            glBindFramebuffer(GL_FRAMEBUFFER, pass->gl.fb);
         }
-        if (_sg.gl.depth_store_action == SG_STOREACTION_DONTCARE) {
-            invalidate_atts[att_index++] = GL_DEPTH_ATTACHMENT;
-        }
-        if (_sg.gl.stencil_store_action == SG_STOREACTION_DONTCARE) {
-            invalidate_atts[att_index++] = GL_STENCIL_ATTACHMENT;
-        }
-        if (att_index > 0) {
-            glInvalidateFramebuffer(GL_FRAMEBUFFER, att_index, invalidate_atts);
-        }
-        #endif
     }
+    _sg_gl_invalidate_attachments();
 
     _sg.gl.cur_pass = 0;
     _sg.gl.cur_pass_id.id = SG_INVALID_ID;
@@ -7707,6 +9593,67 @@ _SOKOL_PRIVATE void _sg_gl_apply_scissor_rect(int x, int y, int w, int h, bool o
     glScissor(x, y, w, h);
 }
 
+/* a matching state hash could still be a collision, so before a render state
+   block is skipped, the values which went into the hash are compared with
+   the cache (with the same float tolerance as the update code below)
+*/
+_SOKOL_PRIVATE bool _sg_gl_depth_state_cached(const _sg_pipeline_t* pip) {
+    const sg_depth_state* a = &pip->gl.depth;
+    const sg_depth_state* b = &_sg.gl.cache.depth;
+    return (a->compare == b->compare) &&
+           (a->write_enabled == b->write_enabled) &&
+           _sg_fequal(a->bias, b->bias, 0.000001f) &&
+           _sg_fequal(a->bias_slope_scale, b->bias_slope_scale, 0.000001f);
+}
+
+_SOKOL_PRIVATE bool _sg_gl_stencil_state_cached(const _sg_pipeline_t* pip) {
+    const sg_stencil_state* a = &pip->gl.stencil;
+    const sg_stencil_state* b = &_sg.gl.cache.stencil;
+    bool eq = (a->enabled == b->enabled) &&
+              (a->write_mask == b->write_mask) &&
+              (a->read_mask == b->read_mask) &&
+              (a->ref == b->ref);
+    for (int i = 0; eq && (i < 2); i++) {
+        const sg_stencil_face_state* fa = (i==0)? &a->front : &a->back;
+        const sg_stencil_face_state* fb = (i==0)? &b->front : &b->back;
+        eq = (fa->compare == fb->compare) &&
+             (fa->fail_op == fb->fail_op) &&
+             (fa->depth_fail_op == fb->depth_fail_op) &&
+             (fa->pass_op == fb->pass_op);
+    }
+    return eq;
+}
+
+_SOKOL_PRIVATE bool _sg_gl_blend_state_cached(const _sg_pipeline_t* pip) {
+    const sg_blend_state* a = &pip->gl.blend;
+    const sg_blend_state* b = &_sg.gl.cache.blend;
+    bool eq = (a->enabled == b->enabled) &&
+              (a->src_factor_rgb == b->src_factor_rgb) &&
+              (a->dst_factor_rgb == b->dst_factor_rgb) &&
+              (a->op_rgb == b->op_rgb) &&
+              (a->src_factor_alpha == b->src_factor_alpha) &&
+              (a->dst_factor_alpha == b->dst_factor_alpha) &&
+              (a->op_alpha == b->op_alpha);
+    for (int i = 0; eq && (i < pip->cmn.color_count); i++) {
+        eq = pip->gl.color_write_mask[i] == _sg.gl.cache.color_write_mask[i];
+    }
+    return eq &&
+           _sg_fequal(pip->cmn.blend_color.r, _sg.gl.cache.blend_color.r, 0.0001f) &&
+           _sg_fequal(pip->cmn.blend_color.g, _sg.gl.cache.blend_color.g, 0.0001f) &&
+           _sg_fequal(pip->cmn.blend_color.b, _sg.gl.cache.blend_color.b, 0.0001f) &&
+           _sg_fequal(pip->cmn.blend_color.a, _sg.gl.cache.blend_color.a, 0.0001f);
+}
+
+_SOKOL_PRIVATE bool _sg_gl_raster_state_cached(const _sg_pipeline_t* pip) {
+    return (pip->gl.cull_mode == _sg.gl.cache.cull_mode) &&
+           (pip->gl.face_winding == _sg.gl.cache.face_winding) &&
+           (pip->gl.alpha_to_coverage_enabled == _sg.gl.cache.alpha_to_coverage_enabled)
+           #ifdef SOKOL_GLCORE33
+           && (pip->gl.sample_count == _sg.gl.cache.sample_count)
+           #endif
+           ;
+}
+
 _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
     SOKOL_ASSERT(pip);
     SOKOL_ASSERT(pip->shader && (pip->cmn.shader_id.id == pip->shader->slot.id));
@@ -7717,17 +9664,29 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
         _sg.gl.cache.cur_primitive_type = _sg_gl_primitive_type(pip->gl.primitive_type);
         _sg.gl.cache.cur_index_type = _sg_gl_index_type(pip->cmn.index_type);
 
+        /* each render state block is only updated field by field when its
+           signature differs from the state in the cache, or when a matching
+           signature turns out to be a collision
+        */
+        const _sg_gl_state_hashes_t* pip_hashes = &pip->gl.hashes;
+        _sg_gl_state_hashes_t* cache_hashes = &_sg.gl.cache.hashes;
+
         /* update depth state */
-        {
+        if ((pip_hashes->depth == cache_hashes->depth) && _sg_gl_depth_state_cached(pip)) {
+            _sg_stats_add(gl.num_render_state_skipped, 1);
+        } else {
+            cache_hashes->depth = pip_hashes->depth;
             const sg_depth_state* state_ds = &pip->gl.depth;
             sg_depth_state* cache_ds = &_sg.gl.cache.depth;
             if (state_ds->compare != cache_ds->compare) {
                 cache_ds->compare = state_ds->compare;
                 glDepthFunc(_sg_gl_compare_func(state_ds->compare));
+                _sg_stats_add(gl.num_render_state, 1);
             }
             if (state_ds->write_enabled != cache_ds->write_enabled) {
                 cache_ds->write_enabled = state_ds->write_enabled;
                 glDepthMask(state_ds->write_enabled);
+                _sg_stats_add(gl.num_render_state, 1);
             }
             if (!_sg_fequal(state_ds->bias, cache_ds->bias, 0.000001f) ||
                 !_sg_fequal(state_ds->bias_slope_scale, cache_ds->bias_slope_scale, 0.000001f))
@@ -7740,6 +9699,7 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
                 cache_ds->bias = state_ds->bias;
                 cache_ds->bias_slope_scale = state_ds->bias_slope_scale;
                 glPolygonOffset(state_ds->bias_slope_scale, state_ds->bias);
+                _sg_stats_add(gl.num_render_state, 1);
                 bool po_enabled = true;
                 if (_sg_fequal(state_ds->bias, 0.0f, 0.000001f) &&
                     _sg_fequal(state_ds->bias_slope_scale, 0.0f, 0.000001f))
@@ -7750,28 +9710,36 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
                     _sg.gl.cache.polygon_offset_enabled = po_enabled;
                     if (po_enabled) {
                         glEnable(GL_POLYGON_OFFSET_FILL);
+                        _sg_stats_add(gl.num_render_state, 1);
                     } else {
                         glDisable(GL_POLYGON_OFFSET_FILL);
+                        _sg_stats_add(gl.num_render_state, 1);
                     }
                 }
             }
         }
 
         /* update stencil state */
-        {
+        if ((pip_hashes->stencil == cache_hashes->stencil) && _sg_gl_stencil_state_cached(pip)) {
+            _sg_stats_add(gl.num_render_state_skipped, 1);
+        } else {
+            cache_hashes->stencil = pip_hashes->stencil;
             const sg_stencil_state* state_ss = &pip->gl.stencil;
             sg_stencil_state* cache_ss = &_sg.gl.cache.stencil;
             if (state_ss->enabled != cache_ss->enabled) {
                 cache_ss->enabled = state_ss->enabled;
                 if (state_ss->enabled) {
                     glEnable(GL_STENCIL_TEST);
+                    _sg_stats_add(gl.num_render_state, 1);
                 } else {
                     glDisable(GL_STENCIL_TEST);
+                    _sg_stats_add(gl.num_render_state, 1);
                 }
             }
             if (state_ss->write_mask != cache_ss->write_mask) {
                 cache_ss->write_mask = state_ss->write_mask;
                 glStencilMask(state_ss->write_mask);
+                _sg_stats_add(gl.num_render_state, 1);
             }
             for (int i = 0; i < 2; i++) {
                 const sg_stencil_face_state* state_sfs = (i==0)? &state_ss->front : &state_ss->back;
@@ -7786,6 +9754,7 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
                         _sg_gl_compare_func(state_sfs->compare),
                         state_ss->ref,
                         state_ss->read_mask);
+                    _sg_stats_add(gl.num_render_state, 1);
                 }
                 if ((state_sfs->fail_op != cache_sfs->fail_op) ||
                     (state_sfs->depth_fail_op != cache_sfs->depth_fail_op) ||
@@ -7798,24 +9767,30 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
                         _sg_gl_stencil_op(state_sfs->fail_op),
                         _sg_gl_stencil_op(state_sfs->depth_fail_op),
                         _sg_gl_stencil_op(state_sfs->pass_op));
+                    _sg_stats_add(gl.num_render_state, 1);
                 }
             }
             cache_ss->read_mask = state_ss->read_mask;
             cache_ss->ref = state_ss->ref;
         }
 
-        /* update blend state
+        /* update blend state, blend color and color write masks
             FIXME: separate blend state per color attachment not support, needs GL4
         */
-        {
+        if ((pip_hashes->blend == cache_hashes->blend) && _sg_gl_blend_state_cached(pip)) {
+            _sg_stats_add(gl.num_render_state_skipped, 1);
+        } else {
+            cache_hashes->blend = pip_hashes->blend;
             const sg_blend_state* state_bs = &pip->gl.blend;
             sg_blend_state* cache_bs = &_sg.gl.cache.blend;
             if (state_bs->enabled != cache_bs->enabled) {
                 cache_bs->enabled = state_bs->enabled;
                 if (state_bs->enabled) {
                     glEnable(GL_BLEND);
+                    _sg_stats_add(gl.num_render_state, 1);
                 } else {
                     glDisable(GL_BLEND);
+                    _sg_stats_add(gl.num_render_state, 1);
                 }
             }
             if ((state_bs->src_factor_rgb != cache_bs->src_factor_rgb) ||
@@ -7831,84 +9806,106 @@ _SOKOL_PRIVATE void _sg_gl_apply_pipeline(_sg_pipeline_t* pip) {
                     _sg_gl_blend_factor(state_bs->dst_factor_rgb),
                     _sg_gl_blend_factor(state_bs->src_factor_alpha),
                     _sg_gl_blend_factor(state_bs->dst_factor_alpha));
+                _sg_stats_add(gl.num_render_state, 1);
             }
             if ((state_bs->op_rgb != cache_bs->op_rgb) || (state_bs->op_alpha != cache_bs->op_alpha)) {
                 cache_bs->op_rgb = state_bs->op_rgb;
                 cache_bs->op_alpha = state_bs->op_alpha;
                 glBlendEquationSeparate(_sg_gl_blend_op(state_bs->op_rgb), _sg_gl_blend_op(state_bs->op_alpha));
+                _sg_stats_add(gl.num_render_state, 1);
             }
-        }
-
-        /* standalone state */
-        for (GLuint i = 0; i < (GLuint)pip->cmn.color_count; i++) {
-            if (pip->gl.color_write_mask[i] != _sg.gl.cache.color_write_mask[i]) {
-                const sg_color_mask cm = pip->gl.color_write_mask[i];
-                _sg.gl.cache.color_write_mask[i] = cm;
-                #ifdef SOKOL_GLCORE33
-                    glColorMaski(i,
-                                (cm & SG_COLORMASK_R) != 0,
-                                (cm & SG_COLORMASK_G) != 0,
-                                (cm & SG_COLORMASK_B) != 0,
-                                (cm & SG_COLORMASK_A) != 0);
-                #else
-                    if (0 == i) {
-                        glColorMask((cm & SG_COLORMASK_R) != 0,
+            for (GLuint i = 0; i < (GLuint)pip->cmn.color_count; i++) {
+                if (pip->gl.color_write_mask[i] != _sg.gl.cache.color_write_mask[i]) {
+                    const sg_color_mask cm = pip->gl.color_write_mask[i];
+                    _sg.gl.cache.color_write_mask[i] = cm;
+                    #ifdef SOKOL_GLCORE33
+                        glColorMaski(i,
+                                    (cm & SG_COLORMASK_R) != 0,
                                     (cm & SG_COLORMASK_G) != 0,
                                     (cm & SG_COLORMASK_B) != 0,
                                     (cm & SG_COLORMASK_A) != 0);
-                    }
-                #endif
+                    #else
+                        if (0 == i) {
+                            glColorMask((cm & SG_COLORMASK_R) != 0,
+                                        (cm & SG_COLORMASK_G) != 0,
+                                        (cm & SG_COLORMASK_B) != 0,
+                                        (cm & SG_COLORMASK_A) != 0);
+                        }
+                    #endif
+                    _sg_stats_add(gl.num_render_state, 1);
+                }
             }
-        }
 
-        if (!_sg_fequal(pip->cmn.blend_color.r, _sg.gl.cache.blend_color.r, 0.0001f) ||
-            !_sg_fequal(pip->cmn.blend_color.g, _sg.gl.cache.blend_color.g, 0.0001f) ||
-            !_sg_fequal(pip->cmn.blend_color.b, _sg.gl.cache.blend_color.b, 0.0001f) ||
-            !_sg_fequal(pip->cmn.blend_color.a, _sg.gl.cache.blend_color.a, 0.0001f))
-        {
-            sg_color c = pip->cmn.blend_color;
-            _sg.gl.cache.blend_color = c;
-            glBlendColor(c.r, c.g, c.b, c.a);
-        }
-        if (pip->gl.cull_mode != _sg.gl.cache.cull_mode) {
-            _sg.gl.cache.cull_mode = pip->gl.cull_mode;
-            if (SG_CULLMODE_NONE == pip->gl.cull_mode) {
-                glDisable(GL_CULL_FACE);
-            } else {
-                glEnable(GL_CULL_FACE);
-                GLenum gl_mode = (SG_CULLMODE_FRONT == pip->gl.cull_mode) ? GL_FRONT : GL_BACK;
-                glCullFace(gl_mode);
+            if (!_sg_fequal(pip->cmn.blend_color.r, _sg.gl.cache.blend_color.r, 0.0001f) ||
+                !_sg_fequal(pip->cmn.blend_color.g, _sg.gl.cache.blend_color.g, 0.0001f) ||
+                !_sg_fequal(pip->cmn.blend_color.b, _sg.gl.cache.blend_color.b, 0.0001f) ||
+                !_sg_fequal(pip->cmn.blend_color.a, _sg.gl.cache.blend_color.a, 0.0001f))
+            {
+                sg_color c = pip->cmn.blend_color;
+                _sg.gl.cache.blend_color = c;
+                glBlendColor(c.r, c.g, c.b, c.a);
+                _sg_stats_add(gl.num_render_state, 1);
             }
         }
-        if (pip->gl.face_winding != _sg.gl.cache.face_winding) {
-            _sg.gl.cache.face_winding = pip->gl.face_winding;
-            GLenum gl_winding = (SG_FACEWINDING_CW == pip->gl.face_winding) ? GL_CW : GL_CCW;
-            glFrontFace(gl_winding);
-        }
-        if (pip->gl.alpha_to_coverage_enabled != _sg.gl.cache.alpha_to_coverage_enabled) {
-            _sg.gl.cache.alpha_to_coverage_enabled = pip->gl.alpha_to_coverage_enabled;
-            if (pip->gl.alpha_to_coverage_enabled) {
-                glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-            } else {
-                glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+
+        /* update rasterizer state */
+        if ((pip_hashes->raster == cache_hashes->raster) && _sg_gl_raster_state_cached(pip)) {
+            _sg_stats_add(gl.num_render_state_skipped, 1);
+        } else {
+            cache_hashes->raster = pip_hashes->raster;
+            if (pip->gl.cull_mode != _sg.gl.cache.cull_mode) {
+                _sg.gl.cache.cull_mode = pip->gl.cull_mode;
+                if (SG_CULLMODE_NONE == pip->gl.cull_mode) {
+                    glDisable(GL_CULL_FACE);
+                    _sg_stats_add(gl.num_render_state, 1);
+                } else {
+                    glEnable(GL_CULL_FACE);
+                    _sg_stats_add(gl.num_render_state, 1);
+                    GLenum gl_mode = (SG_CULLMODE_FRONT == pip->gl.cull_mode) ? GL_FRONT : GL_BACK;
+                    glCullFace(gl_mode);
+                    _sg_stats_add(gl.num_render_state, 1);
+                }
             }
-        }
-        #ifdef SOKOL_GLCORE33
-        if (pip->gl.sample_count != _sg.gl.cache.sample_count) {
-            _sg.gl.cache.sample_count = pip->gl.sample_count;
-            if (pip->gl.sample_count > 1) {
-                glEnable(GL_MULTISAMPLE);
-            } else {
-                glDisable(GL_MULTISAMPLE);
+            if (pip->gl.face_winding != _sg.gl.cache.face_winding) {
+                _sg.gl.cache.face_winding = pip->gl.face_winding;
+                GLenum gl_winding = (SG_FACEWINDING_CW == pip->gl.face_winding) ? GL_CW : GL_CCW;
+                glFrontFace(gl_winding);
+                _sg_stats_add(gl.num_render_state, 1);
             }
+            if (pip->gl.alpha_to_coverage_enabled != _sg.gl.cache.alpha_to_coverage_enabled) {
+                _sg.gl.cache.alpha_to_coverage_enabled = pip->gl.alpha_to_coverage_enabled;
+                if (pip->gl.alpha_to_coverage_enabled) {
+                    glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+                    _sg_stats_add(gl.num_render_state, 1);
+                } else {
+                    glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+                    _sg_stats_add(gl.num_render_state, 1);
+                }
+            }
+            #ifdef SOKOL_GLCORE33
+            if (pip->gl.sample_count != _sg.gl.cache.sample_count) {
+                _sg.gl.cache.sample_count = pip->gl.sample_count;
+                if (pip->gl.sample_count > 1) {
+                    glEnable(GL_MULTISAMPLE);
+                    _sg_stats_add(gl.num_render_state, 1);
+                } else {
+                    glDisable(GL_MULTISAMPLE);
+                    _sg_stats_add(gl.num_render_state, 1);
+                }
+            }
+            #endif
         }
-        #endif
 
         /* bind shader program */
         if (pip->shader->gl.prog != _sg.gl.cache.prog) {
             _sg.gl.cache.prog = pip->shader->gl.prog;
             glUseProgram(pip->shader->gl.prog);
+            _sg_stats_add(gl.num_use_program, 1);
+        } else {
+            _sg_stats_add(gl.num_use_program_skipped, 1);
         }
+    } else {
+        _sg_stats_add(gl.num_apply_pipeline_skipped, 1);
     }
     _SG_GL_CHECK_ERROR();
 }
@@ -7923,7 +9920,6 @@ _SOKOL_PRIVATE void _sg_gl_apply_bindings(
     SOKOL_ASSERT(pip);
     _SOKOL_UNUSED(num_fs_imgs);
     _SOKOL_UNUSED(num_vs_imgs);
-    _SOKOL_UNUSED(num_vbs);
     _SG_GL_CHECK_ERROR();
 
     // bind textures
@@ -7942,65 +9938,119 @@ _SOKOL_PRIVATE void _sg_gl_apply_bindings(
                 const GLuint gl_tex = img->gl.tex[img->cmn.active_slot];
                 SOKOL_ASSERT((gl_shd_img->gl_tex_slot != -1) && gl_tex);
                 _sg_gl_cache_bind_texture(gl_shd_img->gl_tex_slot, img->gl.target, gl_tex);
+                _sg_gl_cache_bind_sampler(gl_shd_img->gl_tex_slot, img->gl.sampler);
             }
         }
     }
     _SG_GL_CHECK_ERROR();
 
+    // vertex array object, one per pipeline and vertex buffer combination
+    _sg_gl_vao_key_t key;
+    _sg_clear(&key, sizeof(key));
+    key.pip_id = pip->slot.id;
+    for (int vb_index = 0; vb_index < num_vbs; vb_index++) {
+        _sg_buffer_t* vb = vbs[vb_index];
+        SOKOL_ASSERT(vb);
+        key.vbufs[vb_index] = vb->gl.buf[vb->cmn.active_slot];
+    }
+    bool vao_hit = false;
+    _sg_gl_vao_cache_item_t* vao_item = _sg_gl_vao_cache_lookup(&key, &vao_hit);
+    _sg_gl_cache_bind_vao(vao_item);
+
     // index buffer (can be 0)
     const GLuint gl_ib = ib ? ib->gl.buf[ib->cmn.active_slot] : 0;
-    _sg_gl_cache_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, gl_ib);
+    if (!vao_hit) {
+        // the element buffer binding of a recycled VAO is unknown
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gl_ib);
+        _sg.gl.cache.index_buffer = gl_ib;
+        _sg_stats_add(gl.num_bind_buffer, 1);
+    } else {
+        _sg_gl_cache_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, gl_ib);
+    }
     _sg.gl.cache.cur_ib_offset = ib_offset;
 
-    // vertex attributes
-    for (GLuint attr_index = 0; attr_index < (GLuint)_sg.limits.max_vertex_attrs; attr_index++) {
-        _sg_gl_attr_t* attr = &pip->gl.attrs[attr_index];
-        _sg_gl_cache_attr_t* cache_attr = &_sg.gl.cache.attrs[attr_index];
-        bool cache_attr_dirty = false;
-        int vb_offset = 0;
-        GLuint gl_vb = 0;
-        if (attr->vb_index >= 0) {
-            // attribute is enabled
-            SOKOL_ASSERT(attr->vb_index < num_vbs);
-            _sg_buffer_t* vb = vbs[attr->vb_index];
-            SOKOL_ASSERT(vb);
-            gl_vb = vb->gl.buf[vb->cmn.active_slot];
-            vb_offset = vb_offsets[attr->vb_index] + attr->offset;
-            if ((gl_vb != cache_attr->gl_vbuf) ||
-                (attr->size != cache_attr->gl_attr.size) ||
-                (attr->type != cache_attr->gl_attr.type) ||
-                (attr->normalized != cache_attr->gl_attr.normalized) ||
-                (attr->stride != cache_attr->gl_attr.stride) ||
-                (vb_offset != cache_attr->gl_attr.offset) ||
-                (cache_attr->gl_attr.divisor != attr->divisor))
-            {
+    // vertex attributes, only need to be specified when the VAO is new or recycled,
+    // when only vertex buffer offsets have changed the affected attributes are re-pointed
+    if (vao_hit) {
+        for (GLuint attr_index = 0; attr_index < (GLuint)_sg.limits.max_vertex_attrs; attr_index++) {
+            const _sg_gl_attr_t* attr = &pip->gl.attrs[attr_index];
+            if ((attr->vb_index >= 0) && (vao_item->vb_offsets[attr->vb_index] != vb_offsets[attr->vb_index])) {
+                SOKOL_ASSERT(attr->vb_index < num_vbs);
+                const int vb_offset = vb_offsets[attr->vb_index] + attr->offset;
+                _sg_gl_cache_bind_buffer(GL_ARRAY_BUFFER, key.vbufs[attr->vb_index]);
+                glVertexAttribPointer(attr_index, attr->size, attr->type,
+                    attr->normalized, attr->stride,
+                    (const GLvoid*)(GLintptr)vb_offset);
+                _sg_stats_add(gl.num_vertex_attrib, 1);
+            } else {
+                _sg_stats_add(gl.num_vertex_attrib_skipped, 1);
+            }
+        }
+    } else {
+        for (GLuint attr_index = 0; attr_index < (GLuint)_sg.limits.max_vertex_attrs; attr_index++) {
+            const _sg_gl_attr_t* attr = &pip->gl.attrs[attr_index];
+            if (attr->vb_index >= 0) {
+                // attribute is enabled
+                SOKOL_ASSERT(attr->vb_index < num_vbs);
+                const GLuint gl_vb = key.vbufs[attr->vb_index];
+                const int vb_offset = vb_offsets[attr->vb_index] + attr->offset;
                 _sg_gl_cache_bind_buffer(GL_ARRAY_BUFFER, gl_vb);
                 glVertexAttribPointer(attr_index, attr->size, attr->type,
                     attr->normalized, attr->stride,
                     (const GLvoid*)(GLintptr)vb_offset);
                 glVertexAttribDivisor(attr_index, (GLuint)attr->divisor);
-                cache_attr_dirty = true;
-            }
-            if (cache_attr->gl_attr.vb_index == -1) {
                 glEnableVertexAttribArray(attr_index);
-                cache_attr_dirty = true;
-            }
-        } else {
-            // attribute is disabled
-            if (cache_attr->gl_attr.vb_index != -1) {
+                _sg_stats_add(gl.num_vertex_attrib, 3);
+            } else {
+                // attribute is disabled
                 glDisableVertexAttribArray(attr_index);
-                cache_attr_dirty = true;
+                _sg_stats_add(gl.num_vertex_attrib, 1);
             }
         }
-        if (cache_attr_dirty) {
-            cache_attr->gl_attr = *attr;
-            cache_attr->gl_attr.offset = vb_offset;
-            cache_attr->gl_vbuf = gl_vb;
-        }
+    }
+    for (int vb_index = 0; vb_index < num_vbs; vb_index++) {
+        vao_item->vb_offsets[vb_index] = vb_offsets[vb_index];
     }
     _SG_GL_CHECK_ERROR();
 }
 
+/* copy uniform data into the current frame's uniform buffer and bind the range */
+_SOKOL_PRIVATE void _sg_gl_ub_update(GLuint gl_binding, const sg_range* data) {
+    if (0 == _sg.gl.ub.buf[0]) {
+        /* uniform buffers are created on demand, so that they don't take up
+           memory when only glUniform*() updates are used
+        */
+        GLint gl_align = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &gl_align);
+        _sg.gl.ub.align = (gl_align > 0) ? gl_align : 256;
+        glGenBuffers(SG_NUM_INFLIGHT_FRAMES, _sg.gl.ub.buf);
+        for (int i = 0; i < SG_NUM_INFLIGHT_FRAMES; i++) {
+            glBindBuffer(GL_UNIFORM_BUFFER, _sg.gl.ub.buf[i]);
+            glBufferData(GL_UNIFORM_BUFFER, _sg.gl.ub.size, 0, GL_STREAM_DRAW);
+        }
+        _SG_GL_CHECK_ERROR();
+    }
+    if (data->size > (size_t)_sg.gl.ub.size) {
+        /* would write past the end of the buffer, shaders with such blocks fail to create */
+        _SG_ERROR(GL_UNIFORMBLOCK_TOO_BIG);
+        return;
+    }
+    int offset = _sg_roundup(_sg.gl.ub.cur_offset, _sg.gl.ub.align);
+    if ((offset + (int)data->size) > _sg.gl.ub.size) {
+        /* wrapping around is still correct, but may cause the driver to stall */
+        if (!_sg.gl.ub.overflow) {
+            _SG_WARN(GL_UNIFORMBUFFER_OVERFLOW);
+            _sg.gl.ub.overflow = true;
+        }
+        offset = 0;
+    }
+    const GLuint gl_buf = _sg.gl.ub.buf[_sg.gl.ub.cur_slot];
+    glBindBufferRange(GL_UNIFORM_BUFFER, gl_binding, gl_buf, offset, (GLsizeiptr)data->size);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, (GLsizeiptr)data->size, data->ptr);
+    _sg.gl.ub.cur_offset = offset + (int)data->size;
+    _sg_stats_add(gl.num_uniform_buffer_update, 1);
+}
+
 _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_index, const sg_range* data) {
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline);
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline->slot.id == _sg.gl.cache.cur_pipeline_id.id);
@@ -8009,12 +10059,22 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline->shader->cmn.stage[stage_index].uniform_blocks[ub_index].size == data->size);
     const _sg_gl_shader_stage_t* gl_stage = &_sg.gl.cache.cur_pipeline->shader->gl.stage[stage_index];
     const _sg_gl_uniform_block_t* gl_ub = &gl_stage->uniform_blocks[ub_index];
+    if (gl_ub->use_ubo) {
+        /* the validation layer may be disabled, never upload more than the block size */
+        if (data->size > _sg.gl.cache.cur_pipeline->shader->cmn.stage[stage_index].uniform_blocks[ub_index].size) {
+            _SG_ERROR(GL_UNIFORMBLOCK_TOO_BIG);
+            return;
+        }
+        _sg_gl_ub_update(_sg_gl_ub_binding(stage_index, ub_index), data);
+        return;
+    }
     for (int u_index = 0; u_index < gl_ub->num_uniforms; u_index++) {
         const _sg_gl_uniform_t* u = &gl_ub->uniforms[u_index];
         SOKOL_ASSERT(u->type != SG_UNIFORMTYPE_INVALID);
         if (u->gl_loc == -1) {
             continue;
         }
+        _sg_stats_add(gl.num_uniform, 1);
         GLfloat* fptr = (GLfloat*) (((uint8_t*)data->ptr) + u->offset);
         GLint* iptr = (GLint*) (((uint8_t*)data->ptr) + u->offset);
         switch (u->type) {
@@ -8054,6 +10114,80 @@ _SOKOL_PRIVATE void _sg_gl_apply_uniforms(sg_shader_stage stage_index, int ub_in
     }
 }
 
+#if defined(SOKOL_GLCORE33)
+/* draw up to _SG_GL_DRAW_BATCH_SIZE non-instanced items with a single multi-draw call */
+_SOKOL_PRIVATE void _sg_gl_multi_draw(const sg_draw_item* items, int num_items) {
+    SOKOL_ASSERT(items && (num_items > 0) && (num_items <= _SG_GL_DRAW_BATCH_SIZE));
+    const GLenum i_type = _sg.gl.cache.cur_index_type;
+    const GLenum p_type = _sg.gl.cache.cur_primitive_type;
+    GLsizei counts[_SG_GL_DRAW_BATCH_SIZE];
+    for (int i = 0; i < num_items; i++) {
+        counts[i] = (items[i].num_instances > 0) ? items[i].num_elements : 0;
+    }
+    if (0 != i_type) {
+        const int i_size = (i_type == GL_UNSIGNED_SHORT) ? 2 : 4;
+        const int ib_offset = _sg.gl.cache.cur_ib_offset;
+        const GLvoid* indices[_SG_GL_DRAW_BATCH_SIZE];
+        GLint base_vertices[_SG_GL_DRAW_BATCH_SIZE];
+        for (int i = 0; i < num_items; i++) {
+            indices[i] = (const GLvoid*)(GLintptr)(items[i].base_element*i_size+ib_offset);
+            base_vertices[i] = items[i].base_vertex;
+        }
+        glMultiDrawElementsBaseVertex(p_type, counts, i_type, indices, num_items, base_vertices);
+    } else {
+        GLint firsts[_SG_GL_DRAW_BATCH_SIZE];
+        for (int i = 0; i < num_items; i++) {
+            firsts[i] = items[i].base_element + items[i].base_vertex;
+        }
+        glMultiDrawArrays(p_type, firsts, counts, num_items);
+    }
+}
+
+/* draw up to _SG_GL_DRAW_BATCH_SIZE instanced items with a single indirect multi-draw call */
+_SOKOL_PRIVATE void _sg_gl_multi_draw_indirect(const sg_draw_item* items, int num_items) {
+    SOKOL_ASSERT(items && (num_items > 0) && (num_items <= _SG_GL_DRAW_BATCH_SIZE));
+    SOKOL_ASSERT(_sg.gl.ext_multi_draw_indirect);
+    #if defined(_SOKOL_GL_HAS_MULTI_DRAW_INDIRECT)
+        const GLenum i_type = _sg.gl.cache.cur_index_type;
+        const GLenum p_type = _sg.gl.cache.cur_primitive_type;
+        if (0 == _sg.gl.indirect_buf) {
+            glGenBuffers(1, &_sg.gl.indirect_buf);
+            SOKOL_ASSERT(_sg.gl.indirect_buf);
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _sg.gl.indirect_buf);
+        if (0 != i_type) {
+            const int i_size = (i_type == GL_UNSIGNED_SHORT) ? 2 : 4;
+            const int ib_offset = _sg.gl.cache.cur_ib_offset;
+            SOKOL_ASSERT((ib_offset % i_size) == 0);
+            _sg_gl_draw_elements_indirect_t cmds[_SG_GL_DRAW_BATCH_SIZE];
+            for (int i = 0; i < num_items; i++) {
+                cmds[i].count = (GLuint)items[i].num_elements;
+                cmds[i].instance_count = (GLuint)items[i].num_instances;
+                cmds[i].first_index = (GLuint)(items[i].base_element + ib_offset / i_size);
+                cmds[i].base_vertex = items[i].base_vertex;
+                cmds[i].base_instance = 0;
+            }
+            /* orphan and refill the indirect buffer for each chunk */
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, (GLsizeiptr)(num_items * (int)sizeof(cmds[0])), cmds, GL_STREAM_DRAW);
+            glMultiDrawElementsIndirect(p_type, i_type, 0, num_items, 0);
+        } else {
+            _sg_gl_draw_arrays_indirect_t cmds[_SG_GL_DRAW_BATCH_SIZE];
+            for (int i = 0; i < num_items; i++) {
+                cmds[i].count = (GLuint)items[i].num_elements;
+                cmds[i].instance_count = (GLuint)items[i].num_instances;
+                cmds[i].first = (GLuint)(items[i].base_element + items[i].base_vertex);
+                cmds[i].base_instance = 0;
+            }
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, (GLsizeiptr)(num_items * (int)sizeof(cmds[0])), cmds, GL_STREAM_DRAW);
+            glMultiDrawArraysIndirect(p_type, 0, num_items, 0);
+        }
+    #else
+        _SOKOL_UNUSED(items);
+        _SOKOL_UNUSED(num_items);
+    #endif
+}
+#endif
+
 _SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_instances) {
     SOKOL_ASSERT(_sg.gl.cache.cur_pipeline);
     const GLenum i_type = _sg.gl.cache.cur_index_type;
@@ -8078,26 +10212,200 @@ _SOKOL_PRIVATE void _sg_gl_draw(int base_element, int num_elements, int num_inst
     }
 }
 
+_SOKOL_PRIVATE void _sg_gl_draw_batch(const sg_draw_item* items, int num_items) {
+    SOKOL_ASSERT(_sg.gl.cache.cur_pipeline);
+    SOKOL_ASSERT(items && (num_items > 0));
+    #if defined(SOKOL_GLCORE33)
+        bool has_instances = false;
+        if (_sg.gl.cache.cur_pipeline->cmn.use_instanced_draw) {
+            for (int i = 0; i < num_items; i++) {
+                if (items[i].num_instances != 1) {
+                    has_instances = true;
+                    break;
+                }
+            }
+        }
+        if (has_instances && !_sg.gl.ext_multi_draw_indirect) {
+            /* no multi-draw for instanced rendering without indirect draws */
+            const GLenum i_type = _sg.gl.cache.cur_index_type;
+            const GLenum p_type = _sg.gl.cache.cur_primitive_type;
+            const int i_size = (i_type == GL_UNSIGNED_SHORT) ? 2 : 4;
+            for (int i = 0; i < num_items; i++) {
+                const sg_draw_item* item = &items[i];
+                if ((0 == item->num_elements) || (0 == item->num_instances)) {
+                    continue;
+                }
+                if (0 != i_type) {
+                    const GLvoid* indices = (const GLvoid*)(GLintptr)(item->base_element*i_size+_sg.gl.cache.cur_ib_offset);
+                    glDrawElementsInstancedBaseVertex(p_type, item->num_elements, i_type, indices, item->num_instances, item->base_vertex);
+                } else {
+                    glDrawArraysInstanced(p_type, item->base_element + item->base_vertex, item->num_elements, item->num_instances);
+                }
+            }
+            return;
+        }
+        for (int base = 0; base < num_items; base += _SG_GL_DRAW_BATCH_SIZE) {
+            const int num = _sg_min(num_items - base, _SG_GL_DRAW_BATCH_SIZE);
+            if (has_instances) {
+                _sg_gl_multi_draw_indirect(&items[base], num);
+            } else {
+                _sg_gl_multi_draw(&items[base], num);
+            }
+        }
+    #else
+        for (int i = 0; i < num_items; i++) {
+            const sg_draw_item* item = &items[i];
+            SOKOL_ASSERT(0 == item->base_vertex);
+            _sg_gl_draw(item->base_element, item->num_elements, item->num_instances);
+        }
+    #endif
+}
+
+/*-- frame fences for persistently mapped buffers ----------------------------*/
+#if defined(_SOKOL_GL_HAS_BUFFER_STORAGE)
+_SOKOL_PRIVATE void _sg_gl_wait_fence(int fence_index) {
+    SOKOL_ASSERT((fence_index >= 0) && (fence_index < _SG_GL_NUM_FRAME_FENCES));
+    GLsync sync = _sg.gl.fences.sync[fence_index];
+    SOKOL_ASSERT(sync);
+    GLenum res;
+    do {
+        res = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    } while (res == GL_TIMEOUT_EXPIRED);
+    SOKOL_ASSERT(res != GL_WAIT_FAILED);
+    glDeleteSync(sync);
+    _sg.gl.fences.sync[fence_index] = 0;
+    if (_sg.gl.fences.frame_index[fence_index] > _sg.gl.fences.completed_frame_index) {
+        _sg.gl.fences.completed_frame_index = _sg.gl.fences.frame_index[fence_index];
+    }
+}
+#endif
+
+/* block until the GPU has finished all commands up to and including a frame */
+_SOKOL_PRIVATE void _sg_gl_wait_frame(uint32_t frame_index) {
+    if (frame_index <= _sg.gl.fences.completed_frame_index) {
+        return;
+    }
+    #if defined(_SOKOL_GL_HAS_BUFFER_STORAGE)
+        /* find the oldest fence which was inserted after that frame */
+        int fence_index = -1;
+        for (int i = 0; i < _SG_GL_NUM_FRAME_FENCES; i++) {
+            if (_sg.gl.fences.sync[i] && (_sg.gl.fences.frame_index[i] >= frame_index)) {
+                if ((fence_index < 0) || (_sg.gl.fences.frame_index[i] < _sg.gl.fences.frame_index[fence_index])) {
+                    fence_index = i;
+                }
+            }
+        }
+        if (fence_index >= 0) {
+            _sg_gl_wait_fence(fence_index);
+            return;
+        }
+    #endif
+    glFinish();
+    _sg.gl.fences.completed_frame_index = frame_index;
+}
+
+_SOKOL_PRIVATE void _sg_gl_insert_frame_fence(void) {
+    #if defined(_SOKOL_GL_HAS_BUFFER_STORAGE)
+        const int fence_index = (int)(_sg.frame_index % _SG_GL_NUM_FRAME_FENCES);
+        if (_sg.gl.fences.sync[fence_index]) {
+            /* also keeps the CPU from running too far ahead of the GPU */
+            _sg_gl_wait_fence(fence_index);
+        }
+        _sg.gl.fences.sync[fence_index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        _sg.gl.fences.frame_index[fence_index] = _sg.frame_index;
+    #endif
+}
+
+/* rotate a buffer to its next slot, a mapped slot may only be written once the GPU is done with it */
+_SOKOL_PRIVATE void _sg_gl_next_buffer_slot(_sg_buffer_t* buf) {
+    buf->gl.retire_frame_index[buf->cmn.active_slot] = _sg.frame_index;
+    if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
+        buf->cmn.active_slot = 0;
+    }
+    if (buf->gl.mapped[buf->cmn.active_slot]) {
+        _sg_gl_wait_frame(buf->gl.retire_frame_index[buf->cmn.active_slot]);
+    }
+}
+
+/* timestamp queries for sg_desc.gpu_timings, 'slot' is the frame in the query ring */
+_SOKOL_PRIVATE void _sg_gl_write_timestamp(int slot, int index) {
+    #if defined(_SOKOL_GL_HAS_TIMER_QUERY)
+    SOKOL_ASSERT(_sg.gl.timer_queries[slot][index]);
+    glQueryCounter(_sg.gl.timer_queries[slot][index], GL_TIMESTAMP);
+    _SG_GL_CHECK_ERROR();
+    #else
+    _SOKOL_UNUSED(slot);
+    _SOKOL_UNUSED(index);
+    #endif
+}
+
+/* false if the GPU hasn't reached the timestamp yet, doesn't wait */
+_SOKOL_PRIVATE bool _sg_gl_read_timestamp(int slot, int index, uint64_t* out_ns) {
+    #if defined(_SOKOL_GL_HAS_TIMER_QUERY)
+    const GLuint query = _sg.gl.timer_queries[slot][index];
+    GLint available = 0;
+    glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        return false;
+    }
+    GLuint64 ns = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+    _SG_GL_CHECK_ERROR();
+    *out_ns = (uint64_t) ns;
+    return true;
+    #else
+    _SOKOL_UNUSED(slot);
+    _SOKOL_UNUSED(index);
+    _SOKOL_UNUSED(out_ns);
+    return false;
+    #endif
+}
+
 _SOKOL_PRIVATE void _sg_gl_commit(void) {
     SOKOL_ASSERT(!_sg.gl.in_pass);
     /* "soft" clear bindings (only those that are actually bound) */
     _sg_gl_cache_clear_buffer_bindings(false);
     _sg_gl_cache_clear_texture_bindings(false);
+    if (_sg.gl.fences.num_mapped_buffers > 0) {
+        _sg_gl_insert_frame_fence();
+    }
+    /* rotate the uniform buffer ring */
+    if (++_sg.gl.ub.cur_slot >= SG_NUM_INFLIGHT_FRAMES) {
+        _sg.gl.ub.cur_slot = 0;
+    }
+    _sg.gl.ub.cur_offset = 0;
+    _sg.gl.ub.overflow = false;
+    /* rotate the pixel unpack buffer ring, the region is reused once this frame's fence has signalled */
+    if (_sg.gl.unpack.mapped) {
+        _sg.gl.unpack.retire_frame_index[_sg.gl.unpack.cur_slot] = _sg.frame_index;
+        if (++_sg.gl.unpack.cur_slot >= SG_NUM_INFLIGHT_FRAMES) {
+            _sg.gl.unpack.cur_slot = 0;
+        }
+        _sg.gl.unpack.cur_offset = 0;
+        _sg.gl.unpack.overflow = false;
+    }
 }
 
 _SOKOL_PRIVATE void _sg_gl_update_buffer(_sg_buffer_t* buf, const sg_range* data) {
     SOKOL_ASSERT(buf && data && data->ptr && (data->size > 0));
     /* only one update per buffer per frame allowed */
-    if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
-        buf->cmn.active_slot = 0;
+    _sg_gl_next_buffer_slot(buf);
+    SOKOL_ASSERT(buf->cmn.active_slot < _SG_GL_MAX_BUFFER_SLOTS);
+    uint8_t* mapped = buf->gl.mapped[buf->cmn.active_slot];
+    if (mapped) {
+        memcpy(mapped, data->ptr, data->size);
+        return;
     }
     GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
-    SOKOL_ASSERT(buf->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES);
     GLuint gl_buf = buf->gl.buf[buf->cmn.active_slot];
     SOKOL_ASSERT(gl_buf);
     _SG_GL_CHECK_ERROR();
     _sg_gl_cache_store_buffer_binding(gl_tgt);
     _sg_gl_cache_bind_buffer(gl_tgt, gl_buf);
+    if ((buf->cmn.usage == SG_USAGE_STREAM) && !buf->gl.ext_buffers) {
+        /* orphan the old buffer storage so the driver doesn't need to sync with the GPU */
+        glBufferData(gl_tgt, buf->cmn.size, 0, GL_STREAM_DRAW);
+    }
     glBufferSubData(gl_tgt, 0, (GLsizeiptr)data->size, data->ptr);
     _sg_gl_cache_restore_buffer_binding(gl_tgt);
     _SG_GL_CHECK_ERROR();
@@ -8106,24 +10414,91 @@ _SOKOL_PRIVATE void _sg_gl_update_buffer(_sg_buffer_t* buf, const sg_range* data
 _SOKOL_PRIVATE int _sg_gl_append_buffer(_sg_buffer_t* buf, const sg_range* data, bool new_frame) {
     SOKOL_ASSERT(buf && data && data->ptr && (data->size > 0));
     if (new_frame) {
-        if (++buf->cmn.active_slot >= buf->cmn.num_slots) {
-            buf->cmn.active_slot = 0;
-        }
+        _sg_gl_next_buffer_slot(buf);
+    }
+    SOKOL_ASSERT(buf->cmn.active_slot < _SG_GL_MAX_BUFFER_SLOTS);
+    uint8_t* mapped = buf->gl.mapped[buf->cmn.active_slot];
+    if (mapped) {
+        memcpy(mapped + buf->cmn.append_pos, data->ptr, data->size);
+    } else {
+        GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
+        GLuint gl_buf = buf->gl.buf[buf->cmn.active_slot];
+        SOKOL_ASSERT(gl_buf);
+        _SG_GL_CHECK_ERROR();
+        _sg_gl_cache_store_buffer_binding(gl_tgt);
+        _sg_gl_cache_bind_buffer(gl_tgt, gl_buf);
+        if (new_frame && (buf->cmn.usage == SG_USAGE_STREAM) && !buf->gl.ext_buffers) {
+            /* orphan the old buffer storage on the first append in a frame */
+            glBufferData(gl_tgt, buf->cmn.size, 0, GL_STREAM_DRAW);
+        }
+        glBufferSubData(gl_tgt, buf->cmn.append_pos, (GLsizeiptr)data->size, data->ptr);
+        _sg_gl_cache_restore_buffer_binding(gl_tgt);
+        _SG_GL_CHECK_ERROR();
     }
-    GLenum gl_tgt = _sg_gl_buffer_target(buf->cmn.type);
-    SOKOL_ASSERT(buf->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES);
-    GLuint gl_buf = buf->gl.buf[buf->cmn.active_slot];
-    SOKOL_ASSERT(gl_buf);
-    _SG_GL_CHECK_ERROR();
-    _sg_gl_cache_store_buffer_binding(gl_tgt);
-    _sg_gl_cache_bind_buffer(gl_tgt, gl_buf);
-    glBufferSubData(gl_tgt, buf->cmn.append_pos, (GLsizeiptr)data->size, data->ptr);
-    _sg_gl_cache_restore_buffer_binding(gl_tgt);
-    _SG_GL_CHECK_ERROR();
     /* NOTE: this is a requirement from WebGPU, but we want identical behaviour across all backend */
     return _sg_roundup((int)data->size, 4);
 }
 
+/* create the persistently mapped pixel unpack buffer ring on first use */
+_SOKOL_PRIVATE bool _sg_gl_unpack_buffer_available(void) {
+    if (_sg.gl.unpack.mapped) {
+        return true;
+    }
+    if (_sg.gl.unpack.disabled) {
+        return false;
+    }
+    _sg.gl.unpack.disabled = true;
+    #if defined(_SOKOL_GL_HAS_BUFFER_STORAGE)
+        if (_sg.gl.ext_buffer_storage && (_sg.gl.unpack.size > 0)) {
+            _SG_GL_CHECK_ERROR();
+            glGenBuffers(1, &_sg.gl.unpack.buf);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _sg.gl.unpack.buf);
+            _sg.gl.unpack.mapped = _sg_gl_map_buffer_storage(GL_PIXEL_UNPACK_BUFFER, _sg.gl.unpack.size * SG_NUM_INFLIGHT_FRAMES);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            _SG_GL_CHECK_ERROR();
+            if (_sg.gl.unpack.mapped) {
+                _sg.gl.unpack.disabled = false;
+                _sg.gl.fences.num_mapped_buffers++;
+            } else {
+                _SG_WARN(GL_UNPACK_BUFFER_MAP_FAILED);
+                glDeleteBuffers(1, &_sg.gl.unpack.buf);
+                _sg.gl.unpack.buf = 0;
+            }
+        }
+    #endif
+    return !_sg.gl.unpack.disabled;
+}
+
+/* reserve space for all surfaces of an update in this frame's unpack buffer region,
+   returns the buffer offset or -1 if the data must be uploaded from client memory
+*/
+_SOKOL_PRIVATE int _sg_gl_unpack_buffer_alloc(const _sg_image_t* img, const sg_image_data* data) {
+    if (!_sg_gl_unpack_buffer_available()) {
+        return -1;
+    }
+    const int num_faces = img->cmn.type == SG_IMAGETYPE_CUBE ? 6 : 1;
+    int size = 0;
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < img->cmn.num_mipmaps; mip_index++) {
+            size += _sg_roundup((int)data->subimage[face_index][mip_index].size, 16);
+        }
+    }
+    if ((_sg.gl.unpack.cur_offset + size) > _sg.gl.unpack.size) {
+        if (!_sg.gl.unpack.overflow) {
+            _SG_WARN(GL_UNPACK_BUFFER_FULL);
+            _sg.gl.unpack.overflow = true;
+        }
+        return -1;
+    }
+    if (0 == _sg.gl.unpack.cur_offset) {
+        /* first update this frame, the GPU may still read from this region */
+        _sg_gl_wait_frame(_sg.gl.unpack.retire_frame_index[_sg.gl.unpack.cur_slot]);
+    }
+    const int offset = _sg.gl.unpack.cur_slot * _sg.gl.unpack.size + _sg.gl.unpack.cur_offset;
+    _sg.gl.unpack.cur_offset += size;
+    return offset;
+}
+
 _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* data) {
     SOKOL_ASSERT(img && data);
     /* only one update per image per frame allowed */
@@ -8132,6 +10507,14 @@ _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* d
     }
     SOKOL_ASSERT(img->cmn.active_slot < SG_NUM_INFLIGHT_FRAMES);
     SOKOL_ASSERT(0 != img->gl.tex[img->cmn.active_slot]);
+    /* with a mapped pixel unpack buffer, the data is copied into the current
+       frame's region and glTexSubImage*() reads from there asynchronously,
+       otherwise the driver copies from client memory before returning
+    */
+    int unpack_offset = _sg_gl_unpack_buffer_alloc(img, data);
+    if (unpack_offset >= 0) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _sg.gl.unpack.buf);
+    }
     _sg_gl_cache_store_texture_binding(0);
     _sg_gl_cache_bind_texture(0, img->gl.target, img->gl.tex[img->cmn.active_slot]);
     const GLenum gl_img_format = _sg_gl_teximage_format(img->cmn.pixel_format);
@@ -8144,7 +10527,17 @@ _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* d
             if (SG_IMAGETYPE_CUBE == img->cmn.type) {
                 gl_img_target = _sg_gl_cubeface_target(face_index);
             }
-            const GLvoid* data_ptr = data->subimage[face_index][mip_index].ptr;
+            const sg_range* subimage = &data->subimage[face_index][mip_index];
+            const GLvoid* data_ptr = subimage->ptr;
+            if (unpack_offset >= 0) {
+                memcpy(_sg.gl.unpack.mapped + unpack_offset, subimage->ptr, subimage->size);
+                data_ptr = (const GLvoid*)(uintptr_t)unpack_offset;
+                unpack_offset += _sg_roundup((int)subimage->size, 16);
+                _sg_stats_add(gl.num_image_upload_staged, 1);
+                _sg_stats_add(gl.size_image_upload_staged, (uint32_t)subimage->size);
+            } else {
+                _sg_stats_add(gl.num_image_upload_direct, 1);
+            }
             int mip_width = img->cmn.width >> mip_index;
             if (mip_width == 0) {
                 mip_width = 1;
@@ -8174,6 +10567,10 @@ _SOKOL_PRIVATE void _sg_gl_update_image(_sg_image_t* img, const sg_image_data* d
         }
     }
     _sg_gl_cache_restore_texture_binding(0);
+    if (_sg.gl.unpack.buf) {
+        /* all other texture uploads expect client memory pointers */
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
 }
 
 // ██████  ██████  ██████   ██  ██     ██████   █████   ██████ ██   ██ ███████ ███    ██ ██████
@@ -10459,8 +12856,41 @@ _SOKOL_PRIVATE void _sg_mtl_destroy_pool(void) {
     _SG_OBJC_RELEASE(_sg.mtl.idpool.pool);
 }
 
+/* double the number of slots when the free queue is exhausted (this may
+   happen because the sokol_gfx resource pools grow on demand), the
+   circular release queue is unwrapped into the new memory block
+*/
+_SOKOL_PRIVATE void _sg_mtl_grow_pool(void) {
+    const int old_num_slots = _sg.mtl.idpool.num_slots;
+    const int new_num_slots = old_num_slots * 2;
+    NSNull* null = [NSNull null];
+    for (int i = old_num_slots; i < new_num_slots; i++) {
+        [_sg.mtl.idpool.pool addObject:null];
+    }
+    int* free_queue = (int*)_sg_malloc_clear((size_t)new_num_slots * sizeof(int));
+    memcpy(free_queue, _sg.mtl.idpool.free_queue, (size_t)_sg.mtl.idpool.free_queue_top * sizeof(int));
+    _sg_free(_sg.mtl.idpool.free_queue);
+    _sg.mtl.idpool.free_queue = free_queue;
+    for (int i = new_num_slots-1; i >= old_num_slots; i--) {
+        _sg.mtl.idpool.free_queue[_sg.mtl.idpool.free_queue_top++] = i;
+    }
+    _sg_mtl_release_item_t* release_queue = (_sg_mtl_release_item_t*)_sg_malloc_clear((size_t)new_num_slots * sizeof(_sg_mtl_release_item_t));
+    int num_release_items = 0;
+    for (int i = _sg.mtl.idpool.release_queue_back; i != _sg.mtl.idpool.release_queue_front; i = (i + 1) % old_num_slots) {
+        release_queue[num_release_items++] = _sg.mtl.idpool.release_queue[i];
+    }
+    _sg_free(_sg.mtl.idpool.release_queue);
+    _sg.mtl.idpool.release_queue = release_queue;
+    _sg.mtl.idpool.release_queue_back = 0;
+    _sg.mtl.idpool.release_queue_front = num_release_items;
+    _sg.mtl.idpool.num_slots = new_num_slots;
+}
+
 /* get a new free resource pool slot */
 _SOKOL_PRIVATE int _sg_mtl_alloc_pool_slot(void) {
+    if (0 == _sg.mtl.idpool.free_queue_top) {
+        _sg_mtl_grow_pool();
+    }
     SOKOL_ASSERT(_sg.mtl.idpool.free_queue_top > 0);
     const int slot_index = _sg.mtl.idpool.free_queue[--_sg.mtl.idpool.free_queue_top];
     SOKOL_ASSERT((slot_index > 0) && (slot_index < _sg.mtl.idpool.num_slots));
@@ -13713,6 +16143,17 @@ static inline void _sg_discard_shader(_sg_shader_t* shd) {
     #endif
 }
 
+/* only the GL backends create shaders in the PENDING state */
+static inline sg_resource_state _sg_poll_shader(_sg_shader_t* shd) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_poll_shader(shd);
+    #else
+    _SOKOL_UNUSED(shd);
+    SOKOL_UNREACHABLE;
+    return SG_RESOURCESTATE_FAILED;
+    #endif
+}
+
 static inline sg_resource_state _sg_create_pipeline(_sg_pipeline_t* pip, _sg_shader_t* shd, const sg_pipeline_desc* desc) {
     #if defined(_SOKOL_ANY_GL)
     return _sg_gl_create_pipeline(pip, shd, desc);
@@ -13959,6 +16400,21 @@ static inline void _sg_draw(int base_element, int num_elements, int num_instance
     #endif
 }
 
+static inline void _sg_draw_batch(const sg_draw_item* items, int num_items) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_draw_batch(items, num_items);
+    #else
+    /* only the GL backend has a native batched draw path */
+    for (int i = 0; i < num_items; i++) {
+        const sg_draw_item* item = &items[i];
+        SOKOL_ASSERT(0 == item->base_vertex);
+        if ((item->num_elements > 0) && (item->num_instances > 0)) {
+            _sg_draw(item->base_element, item->num_elements, item->num_instances);
+        }
+    }
+    #endif
+}
+
 static inline void _sg_commit(void) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_commit();
@@ -13975,6 +16431,36 @@ static inline void _sg_commit(void) {
     #endif
 }
 
+static inline bool _sg_gpu_timer_supported(void) {
+    #if defined(_SOKOL_GL_HAS_TIMER_QUERY)
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+static inline void _sg_write_timestamp(int slot, int index) {
+    #if defined(_SOKOL_ANY_GL)
+    _sg_gl_write_timestamp(slot, index);
+    #else
+    _SOKOL_UNUSED(slot);
+    _SOKOL_UNUSED(index);
+    SOKOL_UNREACHABLE;
+    #endif
+}
+
+static inline bool _sg_read_timestamp(int slot, int index, uint64_t* out_ns) {
+    #if defined(_SOKOL_ANY_GL)
+    return _sg_gl_read_timestamp(slot, index, out_ns);
+    #else
+    _SOKOL_UNUSED(slot);
+    _SOKOL_UNUSED(index);
+    _SOKOL_UNUSED(out_ns);
+    SOKOL_UNREACHABLE;
+    return false;
+    #endif
+}
+
 static inline void _sg_update_buffer(_sg_buffer_t* buf, const sg_range* data) {
     #if defined(_SOKOL_ANY_GL)
     _sg_gl_update_buffer(buf, data);
@@ -14030,20 +16516,127 @@ static inline void _sg_update_image(_sg_image_t* img, const sg_image_data* data)
 // ██       ██████   ██████  ███████
 //
 // >>pool
-_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num) {
-    SOKOL_ASSERT(pool && (num >= 1));
-    /* slot 0 is reserved for the 'invalid id', so bump the pool size by 1 */
-    pool->size = num + 1;
-    pool->queue_top = 0;
-    /* generation counters indexable by pool slot index, slot 0 is reserved */
-    size_t gen_ctrs_size = sizeof(uint32_t) * (size_t)pool->size;
-    pool->gen_ctrs = (uint32_t*)_sg_malloc_clear(gen_ctrs_size);
-    /* it's not a bug to only reserve 'num' here */
-    pool->free_queue = (int*) _sg_malloc_clear(sizeof(int) * (size_t)num);
-    /* never allocate the zero-th pool item since the invalid id is 0 */
-    for (int i = pool->size-1; i >= 1; i--) {
-        pool->free_queue[pool->queue_top++] = i;
+_SOKOL_PRIVATE void _sg_spinlock_lock(_sg_spinlock_t* lock) {
+    #if defined(_WIN32)
+        while (InterlockedExchange(lock, 1) != 0) {
+            YieldProcessor();
+        }
+    #else
+        while (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE) != 0) {
+            // spin on a plain load until the lock looks free, so that the
+            // cache line isn't hammered with exchanges while it is held
+            while (__atomic_load_n(lock, __ATOMIC_RELAXED) != 0) {
+                #if defined(__i386__) || defined(__x86_64__)
+                    __builtin_ia32_pause();
+                #elif defined(__aarch64__) || defined(__arm__)
+                    __asm__ __volatile__("yield");
+                #endif
+            }
+        }
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_spinlock_unlock(_sg_spinlock_t* lock) {
+    #if defined(_WIN32)
+        InterlockedExchange(lock, 0);
+    #else
+        __atomic_store_n(lock, 0, __ATOMIC_RELEASE);
+    #endif
+}
+
+/* acquire/release helpers for the pool chunk pointers and size, a chunk
+   may be added on any thread while the render thread looks up items
+*/
+_SOKOL_PRIVATE void* _sg_atomic_load_ptr(void* const* ptr) {
+    #if defined(_WIN32)
+        void* val = *(void* const volatile*)ptr;
+        MemoryBarrier();
+        return val;
+    #else
+        return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_atomic_store_ptr(void** ptr, void* val) {
+    #if defined(_WIN32)
+        MemoryBarrier();
+        *(void* volatile*)ptr = val;
+    #else
+        __atomic_store_n(ptr, val, __ATOMIC_RELEASE);
+    #endif
+}
+
+_SOKOL_PRIVATE void _sg_atomic_store_int(int* ptr, int val) {
+    #if defined(_WIN32)
+        MemoryBarrier();
+        *(volatile int*)ptr = val;
+    #else
+        __atomic_store_n(ptr, val, __ATOMIC_RELEASE);
+    #endif
+}
+
+/* add a chunk of slots to the pool and push the new slot indices onto the
+   free queue, existing chunks are never moved, must be called WITHOUT the
+   pool lock held: the user allocator is called outside the lock, if another
+   thread added a chunk in the meantime the new allocations are dropped and
+   true is returned so that the caller retries popping a free slot
+*/
+_SOKOL_PRIVATE bool _sg_pool_grow(_sg_pool_t* pool) {
+    SOKOL_ASSERT(pool && (pool->chunk_size > 0) && (pool->item_size > 0));
+    _sg_spinlock_lock(&pool->lock);
+    const int chunk_index = pool->num_chunks;
+    const int old_size = pool->size;
+    const bool exhausted = (chunk_index >= _SG_MAX_POOL_CHUNKS) || ((old_size + pool->chunk_size) > _SG_MAX_POOL_SIZE);
+    _sg_spinlock_unlock(&pool->lock);
+    if (exhausted) {
+        return false;
     }
+    const int new_size = old_size + pool->chunk_size;
+    void* items = _sg_malloc_clear(pool->item_size * (size_t)pool->chunk_size);
+    void* gen_ctrs = _sg_malloc_clear(sizeof(uint32_t) * (size_t)pool->chunk_size);
+    /* the free queue never needs to hold the reserved slot 0 */
+    int* free_queue = (int*) _sg_malloc_clear(sizeof(int) * (size_t)(new_size - 1));
+
+    _sg_spinlock_lock(&pool->lock);
+    int* old_free_queue = 0;
+    const bool lost_race = pool->num_chunks != chunk_index;
+    if (!lost_race) {
+        if (pool->free_queue) {
+            SOKOL_ASSERT(pool->queue_top <= (new_size - 1));
+            memcpy(free_queue, pool->free_queue, sizeof(int) * (size_t)pool->queue_top);
+            old_free_queue = pool->free_queue;
+        }
+        pool->free_queue = free_queue;
+        /* publish the chunk before the size which makes its slots reachable */
+        _sg_atomic_store_ptr(&pool->items[chunk_index], items);
+        _sg_atomic_store_ptr(&pool->gen_ctrs[chunk_index], gen_ctrs);
+        /* never allocate the zero-th pool item since the invalid id is 0 */
+        for (int i = new_size-1; i >= _sg_max(old_size, 1); i--) {
+            pool->free_queue[pool->queue_top++] = i;
+        }
+        pool->num_chunks = chunk_index + 1;
+        _sg_atomic_store_int(&pool->size, new_size);
+    }
+    _sg_spinlock_unlock(&pool->lock);
+
+    if (lost_race) {
+        _sg_free(items);
+        _sg_free(gen_ctrs);
+        _sg_free(free_queue);
+    } else if (old_free_queue) {
+        _sg_free(old_free_queue);
+    }
+    return true;
+}
+
+_SOKOL_PRIVATE void _sg_init_pool(_sg_pool_t* pool, int num, size_t item_size) {
+    SOKOL_ASSERT(pool && (num >= 1) && (item_size > 0));
+    _sg_clear(pool, sizeof(_sg_pool_t));
+    /* slot 0 is reserved for the 'invalid id', so bump the chunk size by 1 */
+    pool->chunk_size = num + 1;
+    pool->item_size = item_size;
+    bool grown = _sg_pool_grow(pool);
+    SOKOL_ASSERT(grown); _SOKOL_UNUSED(grown);
 }
 
 _SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
@@ -14051,31 +16644,59 @@ _SOKOL_PRIVATE void _sg_discard_pool(_sg_pool_t* pool) {
     SOKOL_ASSERT(pool->free_queue);
     _sg_free(pool->free_queue);
     pool->free_queue = 0;
-    SOKOL_ASSERT(pool->gen_ctrs);
-    _sg_free(pool->gen_ctrs);
-    pool->gen_ctrs = 0;
+    for (int i = 0; i < pool->num_chunks; i++) {
+        _sg_free(pool->items[i]);
+        pool->items[i] = 0;
+        _sg_free(pool->gen_ctrs[i]);
+        pool->gen_ctrs[i] = 0;
+    }
+    pool->num_chunks = 0;
     pool->size = 0;
     pool->queue_top = 0;
 }
 
+/* returns pointer to the pool item at slot_index */
+_SOKOL_PRIVATE void* _sg_pool_item(const _sg_pool_t* pool, int slot_index) {
+    SOKOL_ASSERT(pool && (slot_index >= 0) && (slot_index < pool->size));
+    const int chunk_index = slot_index / pool->chunk_size;
+    const int item_index = slot_index - (chunk_index * pool->chunk_size);
+    return (uint8_t*)_sg_atomic_load_ptr(&pool->items[chunk_index]) + (size_t)item_index * pool->item_size;
+}
+
+_SOKOL_PRIVATE uint32_t* _sg_pool_gen_ctr(const _sg_pool_t* pool, int slot_index) {
+    SOKOL_ASSERT(pool && (slot_index >= 0) && (slot_index < pool->size));
+    const int chunk_index = slot_index / pool->chunk_size;
+    return (uint32_t*)_sg_atomic_load_ptr(&pool->gen_ctrs[chunk_index]) + (slot_index - (chunk_index * pool->chunk_size));
+}
+
 _SOKOL_PRIVATE int _sg_pool_alloc_index(_sg_pool_t* pool) {
     SOKOL_ASSERT(pool);
     SOKOL_ASSERT(pool->free_queue);
-    if (pool->queue_top > 0) {
-        int slot_index = pool->free_queue[--pool->queue_top];
-        SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
-        return slot_index;
-    }
-    else {
-        /* pool exhausted */
-        return _SG_INVALID_SLOT_INDEX;
+    int slot_index = _SG_INVALID_SLOT_INDEX;
+    for (;;) {
+        _sg_spinlock_lock(&pool->lock);
+        if (pool->queue_top > 0) {
+            slot_index = pool->free_queue[--pool->queue_top];
+            SOKOL_ASSERT((slot_index > 0) && (slot_index < pool->size));
+            pool->num_used++;
+            if (pool->num_used > pool->high_water_mark) {
+                pool->high_water_mark = pool->num_used;
+            }
+        }
+        _sg_spinlock_unlock(&pool->lock);
+        /* grow outside the lock and retry, unless the pool is exhausted */
+        if ((slot_index != _SG_INVALID_SLOT_INDEX) || !_sg_pool_grow(pool)) {
+            break;
+        }
     }
+    return slot_index;
 }
 
 _SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index) {
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
     SOKOL_ASSERT(pool);
     SOKOL_ASSERT(pool->free_queue);
+    _sg_spinlock_lock(&pool->lock);
     SOKOL_ASSERT(pool->queue_top < pool->size);
     #ifdef SOKOL_DEBUG
     /* debug check against double-free */
@@ -14085,6 +16706,9 @@ _SOKOL_PRIVATE void _sg_pool_free_index(_sg_pool_t* pool, int slot_index) {
     #endif
     pool->free_queue[pool->queue_top++] = slot_index;
     SOKOL_ASSERT(pool->queue_top <= (pool->size-1));
+    SOKOL_ASSERT(pool->num_used > 0);
+    pool->num_used--;
+    _sg_spinlock_unlock(&pool->lock);
 }
 
 _SOKOL_PRIVATE void _sg_reset_slot(_sg_slot_t* slot) {
@@ -14145,45 +16769,31 @@ _SOKOL_PRIVATE void _sg_setup_pools(_sg_pools_t* p, const sg_desc* desc) {
     SOKOL_ASSERT(desc);
     /* note: the pools here will have an additional item, since slot 0 is reserved */
     SOKOL_ASSERT((desc->buffer_pool_size > 0) && (desc->buffer_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size);
-    size_t buffer_pool_byte_size = sizeof(_sg_buffer_t) * (size_t)p->buffer_pool.size;
-    p->buffers = (_sg_buffer_t*) _sg_malloc_clear(buffer_pool_byte_size);
+    _sg_init_pool(&p->buffer_pool, desc->buffer_pool_size, sizeof(_sg_buffer_t));
 
     SOKOL_ASSERT((desc->image_pool_size > 0) && (desc->image_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->image_pool, desc->image_pool_size);
-    size_t image_pool_byte_size = sizeof(_sg_image_t) * (size_t)p->image_pool.size;
-    p->images = (_sg_image_t*) _sg_malloc_clear(image_pool_byte_size);
+    _sg_init_pool(&p->image_pool, desc->image_pool_size, sizeof(_sg_image_t));
 
     SOKOL_ASSERT((desc->shader_pool_size > 0) && (desc->shader_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->shader_pool, desc->shader_pool_size);
-    size_t shader_pool_byte_size = sizeof(_sg_shader_t) * (size_t)p->shader_pool.size;
-    p->shaders = (_sg_shader_t*) _sg_malloc_clear(shader_pool_byte_size);
+    _sg_init_pool(&p->shader_pool, desc->shader_pool_size, sizeof(_sg_shader_t));
 
     SOKOL_ASSERT((desc->pipeline_pool_size > 0) && (desc->pipeline_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size);
-    size_t pipeline_pool_byte_size = sizeof(_sg_pipeline_t) * (size_t)p->pipeline_pool.size;
-    p->pipelines = (_sg_pipeline_t*) _sg_malloc_clear(pipeline_pool_byte_size);
+    _sg_init_pool(&p->pipeline_pool, desc->pipeline_pool_size, sizeof(_sg_pipeline_t));
 
     SOKOL_ASSERT((desc->pass_pool_size > 0) && (desc->pass_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->pass_pool, desc->pass_pool_size);
-    size_t pass_pool_byte_size = sizeof(_sg_pass_t) * (size_t)p->pass_pool.size;
-    p->passes = (_sg_pass_t*) _sg_malloc_clear(pass_pool_byte_size);
+    _sg_init_pool(&p->pass_pool, desc->pass_pool_size, sizeof(_sg_pass_t));
+
+    SOKOL_ASSERT((desc->binding_set_pool_size > 0) && (desc->binding_set_pool_size < _SG_MAX_POOL_SIZE));
+    _sg_init_pool(&p->binding_set_pool, desc->binding_set_pool_size, sizeof(_sg_binding_set_t));
 
     SOKOL_ASSERT((desc->context_pool_size > 0) && (desc->context_pool_size < _SG_MAX_POOL_SIZE));
-    _sg_init_pool(&p->context_pool, desc->context_pool_size);
-    size_t context_pool_byte_size = sizeof(_sg_context_t) * (size_t)p->context_pool.size;
-    p->contexts = (_sg_context_t*) _sg_malloc_clear(context_pool_byte_size);
+    _sg_init_pool(&p->context_pool, desc->context_pool_size, sizeof(_sg_context_t));
 }
 
 _SOKOL_PRIVATE void _sg_discard_pools(_sg_pools_t* p) {
     SOKOL_ASSERT(p);
-    _sg_free(p->contexts);    p->contexts = 0;
-    _sg_free(p->passes);      p->passes = 0;
-    _sg_free(p->pipelines);   p->pipelines = 0;
-    _sg_free(p->shaders);     p->shaders = 0;
-    _sg_free(p->images);      p->images = 0;
-    _sg_free(p->buffers);     p->buffers = 0;
     _sg_discard_pool(&p->context_pool);
+    _sg_discard_pool(&p->binding_set_pool);
     _sg_discard_pool(&p->pass_pool);
     _sg_discard_pool(&p->pipeline_pool);
     _sg_discard_pool(&p->shader_pool);
@@ -14198,15 +16808,17 @@ _SOKOL_PRIVATE void _sg_discard_pools(_sg_pools_t* p) {
     - set the slot's state to ALLOC
     - return the resource id
 */
-_SOKOL_PRIVATE uint32_t _sg_slot_alloc(_sg_pool_t* pool, _sg_slot_t* slot, int slot_index) {
+_SOKOL_PRIVATE uint32_t _sg_slot_alloc(_sg_pool_t* pool, int slot_index) {
     /* FIXME: add handling for an overflowing generation counter,
        for now, just overflow (another option is to disable
        the slot)
     */
-    SOKOL_ASSERT(pool && pool->gen_ctrs);
+    SOKOL_ASSERT(pool && (pool->num_chunks > 0));
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < pool->size));
+    /* all resource structs start with an _sg_slot_t */
+    _sg_slot_t* slot = (_sg_slot_t*) _sg_pool_item(pool, slot_index);
     SOKOL_ASSERT((slot->state == SG_RESOURCESTATE_INITIAL) && (slot->id == SG_INVALID_ID));
-    uint32_t ctr = ++pool->gen_ctrs[slot_index];
+    uint32_t ctr = ++(*_sg_pool_gen_ctr(pool, slot_index));
     slot->id = (ctr<<_SG_SLOT_SHIFT)|(slot_index & _SG_SLOT_MASK);
     slot->state = SG_RESOURCESTATE_ALLOC;
     return slot->id;
@@ -14224,42 +16836,49 @@ _SOKOL_PRIVATE _sg_buffer_t* _sg_buffer_at(const _sg_pools_t* p, uint32_t buf_id
     SOKOL_ASSERT(p && (SG_INVALID_ID != buf_id));
     int slot_index = _sg_slot_index(buf_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->buffer_pool.size));
-    return &p->buffers[slot_index];
+    return (_sg_buffer_t*) _sg_pool_item(&p->buffer_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_image_t* _sg_image_at(const _sg_pools_t* p, uint32_t img_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != img_id));
     int slot_index = _sg_slot_index(img_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->image_pool.size));
-    return &p->images[slot_index];
+    return (_sg_image_t*) _sg_pool_item(&p->image_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_shader_t* _sg_shader_at(const _sg_pools_t* p, uint32_t shd_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != shd_id));
     int slot_index = _sg_slot_index(shd_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->shader_pool.size));
-    return &p->shaders[slot_index];
+    return (_sg_shader_t*) _sg_pool_item(&p->shader_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_pipeline_t* _sg_pipeline_at(const _sg_pools_t* p, uint32_t pip_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != pip_id));
     int slot_index = _sg_slot_index(pip_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pipeline_pool.size));
-    return &p->pipelines[slot_index];
+    return (_sg_pipeline_t*) _sg_pool_item(&p->pipeline_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_pass_t* _sg_pass_at(const _sg_pools_t* p, uint32_t pass_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != pass_id));
     int slot_index = _sg_slot_index(pass_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->pass_pool.size));
-    return &p->passes[slot_index];
+    return (_sg_pass_t*) _sg_pool_item(&p->pass_pool, slot_index);
+}
+
+_SOKOL_PRIVATE _sg_binding_set_t* _sg_binding_set_at(const _sg_pools_t* p, uint32_t bset_id) {
+    SOKOL_ASSERT(p && (SG_INVALID_ID != bset_id));
+    int slot_index = _sg_slot_index(bset_id);
+    SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->binding_set_pool.size));
+    return (_sg_binding_set_t*) _sg_pool_item(&p->binding_set_pool, slot_index);
 }
 
 _SOKOL_PRIVATE _sg_context_t* _sg_context_at(const _sg_pools_t* p, uint32_t context_id) {
     SOKOL_ASSERT(p && (SG_INVALID_ID != context_id));
     int slot_index = _sg_slot_index(context_id);
     SOKOL_ASSERT((slot_index > _SG_INVALID_SLOT_INDEX) && (slot_index < p->context_pool.size));
-    return &p->contexts[slot_index];
+    return (_sg_context_t*) _sg_pool_item(&p->context_pool, slot_index);
 }
 
 /* returns pointer to resource with matching id check, may return 0 */
@@ -14316,6 +16935,17 @@ _SOKOL_PRIVATE _sg_pass_t* _sg_lookup_pass(const _sg_pools_t* p, uint32_t pass_i
     return 0;
 }
 
+_SOKOL_PRIVATE _sg_binding_set_t* _sg_lookup_binding_set(const _sg_pools_t* p, uint32_t bset_id) {
+    SOKOL_ASSERT(p);
+    if (SG_INVALID_ID != bset_id) {
+        _sg_binding_set_t* bset = _sg_binding_set_at(p, bset_id);
+        if (bset->slot.id == bset_id) {
+            return bset;
+        }
+    }
+    return 0;
+}
+
 _SOKOL_PRIVATE _sg_context_t* _sg_lookup_context(const _sg_pools_t* p, uint32_t ctx_id) {
     SOKOL_ASSERT(p);
     if (SG_INVALID_ID != ctx_id) {
@@ -14327,6 +16957,37 @@ _SOKOL_PRIVATE _sg_context_t* _sg_lookup_context(const _sg_pools_t* p, uint32_t
     return 0;
 }
 
+/* check that all resources referenced by a binding set are still alive and
+   VALID, a destroyed resource has a cleared slot id, a destroyed-and-recreated
+   resource in the same pool slot has a new generation counter in its id, and
+   an uninitialized resource is in the ALLOC state until it is initialized again,
+   as long as no buffer or image has been uninitialized since the last successful
+   check, the resources can't have changed and the check is skipped
+*/
+_SOKOL_PRIVATE bool _sg_binding_set_resources_valid(_sg_binding_set_t* bset) {
+    SOKOL_ASSERT(bset && (bset->slot.state == SG_RESOURCESTATE_VALID));
+    if (bset->checked_epoch == _sg.resource_epoch) {
+        return true;
+    }
+    bool valid = true;
+    for (int i = 0; i < bset->num_vbs; i++) {
+        valid &= (bset->vbs[i]->slot.id == bset->vb_ids[i]) && (bset->vbs[i]->slot.state == SG_RESOURCESTATE_VALID);
+    }
+    if (bset->ib) {
+        valid &= (bset->ib->slot.id == bset->ib_id) && (bset->ib->slot.state == SG_RESOURCESTATE_VALID);
+    }
+    for (int i = 0; i < bset->num_vs_imgs; i++) {
+        valid &= (bset->vs_imgs[i]->slot.id == bset->vs_img_ids[i]) && (bset->vs_imgs[i]->slot.state == SG_RESOURCESTATE_VALID);
+    }
+    for (int i = 0; i < bset->num_fs_imgs; i++) {
+        valid &= (bset->fs_imgs[i]->slot.id == bset->fs_img_ids[i]) && (bset->fs_imgs[i]->slot.state == SG_RESOURCESTATE_VALID);
+    }
+    if (valid) {
+        bset->checked_epoch = _sg.resource_epoch;
+    }
+    return valid;
+}
+
 _SOKOL_PRIVATE void _sg_discard_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
     /*  this is a bit dumb since it loops over all pool slots to
         find the occupied slots, on the other hand it is only ever
@@ -14336,45 +16997,70 @@ _SOKOL_PRIVATE void _sg_discard_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
               and the resource slots not be cleared!
     */
     for (int i = 1; i < p->buffer_pool.size; i++) {
-        if (p->buffers[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->buffers[i].slot.state;
+        _sg_buffer_t* buf = (_sg_buffer_t*) _sg_pool_item(&p->buffer_pool, i);
+        if (buf->slot.ctx_id == ctx_id) {
+            sg_resource_state state = buf->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_discard_buffer(&p->buffers[i]);
+                _sg_discard_buffer(buf);
             }
         }
     }
     for (int i = 1; i < p->image_pool.size; i++) {
-        if (p->images[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->images[i].slot.state;
+        _sg_image_t* img = (_sg_image_t*) _sg_pool_item(&p->image_pool, i);
+        if (img->slot.ctx_id == ctx_id) {
+            sg_resource_state state = img->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_discard_image(&p->images[i]);
+                _sg_discard_image(img);
             }
         }
     }
     for (int i = 1; i < p->shader_pool.size; i++) {
-        if (p->shaders[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->shaders[i].slot.state;
-            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_discard_shader(&p->shaders[i]);
+        _sg_shader_t* shd = (_sg_shader_t*) _sg_pool_item(&p->shader_pool, i);
+        if (shd->slot.ctx_id == ctx_id) {
+            sg_resource_state state = shd->slot.state;
+            if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED) || (state == SG_RESOURCESTATE_PENDING)) {
+                _sg_discard_shader(shd);
+            }
+            /* stop _sg_process_pending_resources() from waiting for the program */
+            if (state == SG_RESOURCESTATE_PENDING) {
+                shd->slot.state = SG_RESOURCESTATE_FAILED;
+                _sg.num_pending_shaders--;
             }
         }
     }
     for (int i = 1; i < p->pipeline_pool.size; i++) {
-        if (p->pipelines[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->pipelines[i].slot.state;
+        _sg_pipeline_t* pip = (_sg_pipeline_t*) _sg_pool_item(&p->pipeline_pool, i);
+        if (pip->slot.ctx_id == ctx_id) {
+            sg_resource_state state = pip->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_discard_pipeline(&p->pipelines[i]);
+                _sg_discard_pipeline(pip);
+            }
+            else if (state == SG_RESOURCESTATE_PENDING) {
+                _sg_free(pip->cmn.pending_desc);
+                pip->cmn.pending_desc = 0;
+                pip->slot.state = SG_RESOURCESTATE_FAILED;
+                _sg.num_pending_pipelines--;
             }
         }
     }
     for (int i = 1; i < p->pass_pool.size; i++) {
-        if (p->passes[i].slot.ctx_id == ctx_id) {
-            sg_resource_state state = p->passes[i].slot.state;
+        _sg_pass_t* pass = (_sg_pass_t*) _sg_pool_item(&p->pass_pool, i);
+        if (pass->slot.ctx_id == ctx_id) {
+            sg_resource_state state = pass->slot.state;
             if ((state == SG_RESOURCESTATE_VALID) || (state == SG_RESOURCESTATE_FAILED)) {
-                _sg_discard_pass(&p->passes[i]);
+                _sg_discard_pass(pass);
             }
         }
     }
+    /* binding sets have no backend objects, but the resources they point to
+       are gone now, even though their slots are not cleared
+    */
+    for (int i = 1; i < p->binding_set_pool.size; i++) {
+        _sg_binding_set_t* bset = (_sg_binding_set_t*) _sg_pool_item(&p->binding_set_pool, i);
+        if ((bset->slot.ctx_id == ctx_id) && (bset->slot.state == SG_RESOURCESTATE_VALID)) {
+            bset->slot.state = SG_RESOURCESTATE_FAILED;
+        }
+    }
 }
 
 // ██    ██  █████  ██      ██ ██████   █████  ████████ ██  ██████  ███    ██
@@ -14386,11 +17072,11 @@ _SOKOL_PRIVATE void _sg_discard_all_resources(_sg_pools_t* p, uint32_t ctx_id) {
 // >>validation
 #if defined(SOKOL_DEBUG)
 _SOKOL_PRIVATE void _sg_validate_begin(void) {
-    _sg.validate_error = SG_LOGITEM_OK;
+    _sg_validate_error = SG_LOGITEM_OK;
 }
 
 _SOKOL_PRIVATE bool _sg_validate_end(void) {
-    if (_sg.validate_error != SG_LOGITEM_OK) {
+    if (_sg_validate_error != SG_LOGITEM_OK) {
         #if !defined(SOKOL_VALIDATE_NON_FATAL)
             _SG_PANIC(VALIDATION_FAILED);
             return false;
@@ -14482,6 +17168,7 @@ _SOKOL_PRIVATE bool _sg_validate_image_desc(const sg_image_desc* desc) {
         }
         if (desc->render_target) {
             SOKOL_ASSERT(((int)fmt >= 0) && ((int)fmt < _SG_PIXELFORMAT_NUM));
+            _SG_VALIDATE(desc->generate_mipmaps == SG_MIPMAPGEN_NONE, VALIDATE_IMAGEDESC_MIPMAPGEN_IMMUTABLE);
             _SG_VALIDATE(_sg.formats[fmt].render, VALIDATE_IMAGEDESC_RT_PIXELFORMAT);
             _SG_VALIDATE(usage == SG_USAGE_IMMUTABLE, VALIDATE_IMAGEDESC_RT_IMMUTABLE);
             _SG_VALIDATE(desc->data.subimage[0][0].ptr==0, VALIDATE_IMAGEDESC_RT_NO_DATA);
@@ -14499,14 +17186,20 @@ _SOKOL_PRIVATE bool _sg_validate_image_desc(const sg_image_desc* desc) {
             if (is_compressed) {
                 _SG_VALIDATE(is_immutable, VALIDATE_IMAGEDESC_COMPRESSED_IMMUTABLE);
             }
+            const bool gen_mipmaps = desc->generate_mipmaps != SG_MIPMAPGEN_NONE;
+            if (gen_mipmaps) {
+                _SG_VALIDATE(is_immutable && !injected, VALIDATE_IMAGEDESC_MIPMAPGEN_IMMUTABLE);
+                _SG_VALIDATE((desc->type == SG_IMAGETYPE_2D) || (desc->type == SG_IMAGETYPE_CUBE), VALIDATE_IMAGEDESC_MIPMAPGEN_TYPE);
+                _SG_VALIDATE(_sg_is_mipmap_gen_format(fmt), VALIDATE_IMAGEDESC_MIPMAPGEN_PIXELFORMAT);
+            }
             if (!injected && is_immutable) {
-                // image desc must have valid data
+                // image desc must have valid data, only the top level with generated mipmaps
                 _sg_validate_image_data(&desc->data,
                     desc->pixel_format,
                     desc->width,
                     desc->height,
                     (desc->type == SG_IMAGETYPE_CUBE) ? 6 : 1,
-                    desc->num_mipmaps,
+                    gen_mipmaps ? 1 : desc->num_mipmaps,
                     desc->num_slices);
             } else {
                 // image desc must not have data
@@ -14612,8 +17305,15 @@ _SOKOL_PRIVATE bool _sg_validate_shader_desc(const sg_shader_desc* desc) {
                     if (ub_desc->layout == SG_UNIFORMLAYOUT_STD140) {
                         uniform_offset = _sg_align_u32(uniform_offset, 16);
                     }
-                    _SG_VALIDATE((size_t)uniform_offset == ub_desc->size, VALIDATE_SHADERDESC_UB_SIZE_MISMATCH);
-                    _SG_VALIDATE(num_uniforms > 0, VALIDATE_SHADERDESC_NO_UB_MEMBERS);
+                    if (ub_desc->name) {
+                        // uniform buffer updates don't need the uniform block members
+                        _SG_VALIDATE(ub_desc->layout == SG_UNIFORMLAYOUT_STD140, VALIDATE_SHADERDESC_UB_NAME_STD140);
+                    } else {
+                        _SG_VALIDATE(num_uniforms > 0, VALIDATE_SHADERDESC_NO_UB_MEMBERS);
+                    }
+                    if (num_uniforms > 0) {
+                        _SG_VALIDATE((size_t)uniform_offset == ub_desc->size, VALIDATE_SHADERDESC_UB_SIZE_MISMATCH);
+                    }
                     #endif
                 }
                 else {
@@ -14659,7 +17359,7 @@ _SOKOL_PRIVATE bool _sg_validate_pipeline_desc(const sg_pipeline_desc* desc) {
         const _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, desc->shader.id);
         _SG_VALIDATE(0 != shd, VALIDATE_PIPELINEDESC_SHADER);
         if (shd) {
-            _SG_VALIDATE(shd->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_PIPELINEDESC_SHADER);
+            _SG_VALIDATE((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_PENDING), VALIDATE_PIPELINEDESC_SHADER);
             bool attrs_cont = true;
             for (int attr_index = 0; attr_index < SG_MAX_VERTEX_ATTRIBUTES; attr_index++) {
                 const sg_vertex_attr_desc* a_desc = &desc->layout.attrs[attr_index];
@@ -14785,36 +17485,119 @@ _SOKOL_PRIVATE bool _sg_validate_pass_desc(const sg_pass_desc* desc) {
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_begin_pass(_sg_pass_t* pass) {
+_SOKOL_PRIVATE bool _sg_validate_begin_pass(_sg_pass_t* pass) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(pass);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _SG_VALIDATE(pass->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_BEGINPASS_PASS);
+
+        for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
+            const _sg_pass_attachment_t* color_att = &pass->cmn.color_atts[i];
+            const _sg_image_t* color_img = _sg_pass_color_image(pass, i);
+            if (color_img) {
+                _SG_VALIDATE(color_img->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_BEGINPASS_COLOR_ATTACHMENT_IMAGE);
+                _SG_VALIDATE(color_img->slot.id == color_att->image_id.id, VALIDATE_BEGINPASS_COLOR_ATTACHMENT_IMAGE);
+            }
+            const _sg_pass_attachment_t* resolve_att = &pass->cmn.resolve_atts[i];
+            const _sg_image_t* resolve_img = _sg_pass_resolve_image(pass, i);
+            if (resolve_img) {
+                _SG_VALIDATE(resolve_img->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_BEGINPASS_RESOLVE_ATTACHMENT_IMAGE);
+                _SG_VALIDATE(resolve_img->slot.id == resolve_att->image_id.id, VALIDATE_BEGINPASS_RESOLVE_ATTACHMENT_IMAGE);
+            }
+        }
+        const _sg_image_t* ds_img = _sg_pass_ds_image(pass);
+        if (ds_img) {
+            const _sg_pass_attachment_t* att = &pass->cmn.ds_att;
+            _SG_VALIDATE(ds_img->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_BEGINPASS_DEPTHSTENCIL_ATTACHMENT_IMAGE);
+            _SG_VALIDATE(ds_img->slot.id == att->image_id.id, VALIDATE_BEGINPASS_DEPTHSTENCIL_ATTACHMENT_IMAGE);
+        }
+        return _sg_validate_end();
+    #endif
+}
+
+#if defined(SOKOL_DEBUG)
+/* the pipeline object must be alive and valid, returns false if the pass checks don't apply */
+_SOKOL_PRIVATE bool _sg_validate_pipeline_object(sg_pipeline pip_id, const _sg_pipeline_t* pip) {
+    _SG_VALIDATE(pip_id.id != SG_INVALID_ID, VALIDATE_APIP_PIPELINE_VALID_ID);
+    _SG_VALIDATE(pip != 0, VALIDATE_APIP_PIPELINE_EXISTS);
+    if (!pip) {
+        return false;
+    }
+    /* a pending pipeline is skipped until its shader is ready */
+    if (pip->slot.state == SG_RESOURCESTATE_PENDING) {
+        return false;
+    }
+    _SG_VALIDATE(pip->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_APIP_PIPELINE_VALID);
+    /* the pipeline's shader must be alive and valid */
+    SOKOL_ASSERT(pip->shader);
+    _SG_VALIDATE(pip->shader->slot.id == pip->cmn.shader_id.id, VALIDATE_APIP_SHADER_EXISTS);
+    _SG_VALIDATE(pip->shader->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_APIP_SHADER_VALID);
+    return true;
+}
+
+/* check that pipeline attributes match current pass attributes */
+_SOKOL_PRIVATE void _sg_validate_pipeline_pass(const _sg_pipeline_t* pip) {
+    const _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, _sg.cur_pass.id);
+    if (pass) {
+        /* an offscreen pass */
+        _SG_VALIDATE(pip->cmn.color_count == pass->cmn.num_color_atts, VALIDATE_APIP_ATT_COUNT);
+        for (int i = 0; i < pip->cmn.color_count; i++) {
+            const _sg_image_t* att_img = _sg_pass_color_image(pass, i);
+            _SG_VALIDATE(pip->cmn.colors[i].pixel_format == att_img->cmn.pixel_format, VALIDATE_APIP_COLOR_FORMAT);
+            _SG_VALIDATE(pip->cmn.sample_count == att_img->cmn.sample_count, VALIDATE_APIP_SAMPLE_COUNT);
+        }
+        const _sg_image_t* att_dsimg = _sg_pass_ds_image(pass);
+        if (att_dsimg) {
+            _SG_VALIDATE(pip->cmn.depth.pixel_format == att_dsimg->cmn.pixel_format, VALIDATE_APIP_DEPTH_FORMAT);
+        }
+        else {
+            _SG_VALIDATE(pip->cmn.depth.pixel_format == SG_PIXELFORMAT_NONE, VALIDATE_APIP_DEPTH_FORMAT);
+        }
+    }
+    else {
+        /* default pass */
+        _SG_VALIDATE(pip->cmn.color_count == 1, VALIDATE_APIP_ATT_COUNT);
+        _SG_VALIDATE(pip->cmn.colors[0].pixel_format == _sg.desc.context.color_format, VALIDATE_APIP_COLOR_FORMAT);
+        _SG_VALIDATE(pip->cmn.depth.pixel_format == _sg.desc.context.depth_format, VALIDATE_APIP_DEPTH_FORMAT);
+        _SG_VALIDATE(pip->cmn.sample_count == _sg.desc.context.sample_count, VALIDATE_APIP_SAMPLE_COUNT);
+    }
+}
+#endif
+
+/* command lists check the pipeline object while recording, and the pass when submitted */
+_SOKOL_PRIVATE bool _sg_validate_cmd_apply_pipeline(sg_pipeline pip_id) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(pip_id);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _sg_validate_pipeline_object(pip_id, _sg_lookup_pipeline(&_sg.pools, pip_id.id));
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_submit_pipeline(uint32_t pip_id, const _sg_pipeline_t* pip) {
     #if !defined(SOKOL_DEBUG)
-        _SOKOL_UNUSED(pass);
+        _SOKOL_UNUSED(pip_id);
+        _SOKOL_UNUSED(pip);
         return true;
     #else
         if (_sg.desc.disable_validation) {
             return true;
         }
+        SOKOL_ASSERT(pip);
         _sg_validate_begin();
-        _SG_VALIDATE(pass->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_BEGINPASS_PASS);
-
-        for (int i = 0; i < SG_MAX_COLOR_ATTACHMENTS; i++) {
-            const _sg_pass_attachment_t* color_att = &pass->cmn.color_atts[i];
-            const _sg_image_t* color_img = _sg_pass_color_image(pass, i);
-            if (color_img) {
-                _SG_VALIDATE(color_img->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_BEGINPASS_COLOR_ATTACHMENT_IMAGE);
-                _SG_VALIDATE(color_img->slot.id == color_att->image_id.id, VALIDATE_BEGINPASS_COLOR_ATTACHMENT_IMAGE);
-            }
-            const _sg_pass_attachment_t* resolve_att = &pass->cmn.resolve_atts[i];
-            const _sg_image_t* resolve_img = _sg_pass_resolve_image(pass, i);
-            if (resolve_img) {
-                _SG_VALIDATE(resolve_img->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_BEGINPASS_RESOLVE_ATTACHMENT_IMAGE);
-                _SG_VALIDATE(resolve_img->slot.id == resolve_att->image_id.id, VALIDATE_BEGINPASS_RESOLVE_ATTACHMENT_IMAGE);
-            }
-        }
-        const _sg_image_t* ds_img = _sg_pass_ds_image(pass);
-        if (ds_img) {
-            const _sg_pass_attachment_t* att = &pass->cmn.ds_att;
-            _SG_VALIDATE(ds_img->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_BEGINPASS_DEPTHSTENCIL_ATTACHMENT_IMAGE);
-            _SG_VALIDATE(ds_img->slot.id == att->image_id.id, VALIDATE_BEGINPASS_DEPTHSTENCIL_ATTACHMENT_IMAGE);
+        _SG_VALIDATE(pip->slot.id == pip_id, VALIDATE_APIP_PIPELINE_EXISTS);
+        if ((pip->slot.id == pip_id) && (pip->slot.state == SG_RESOURCESTATE_VALID)) {
+            _sg_validate_pipeline_pass(pip);
         }
         return _sg_validate_end();
     #endif
@@ -14829,49 +17612,18 @@ _SOKOL_PRIVATE bool _sg_validate_apply_pipeline(sg_pipeline pip_id) {
             return true;
         }
         _sg_validate_begin();
-        /* the pipeline object must be alive and valid */
-        _SG_VALIDATE(pip_id.id != SG_INVALID_ID, VALIDATE_APIP_PIPELINE_VALID_ID);
         const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
-        _SG_VALIDATE(pip != 0, VALIDATE_APIP_PIPELINE_EXISTS);
-        if (!pip) {
-            return _sg_validate_end();
-        }
-        _SG_VALIDATE(pip->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_APIP_PIPELINE_VALID);
-        /* the pipeline's shader must be alive and valid */
-        SOKOL_ASSERT(pip->shader);
-        _SG_VALIDATE(pip->shader->slot.id == pip->cmn.shader_id.id, VALIDATE_APIP_SHADER_EXISTS);
-        _SG_VALIDATE(pip->shader->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_APIP_SHADER_VALID);
-        /* check that pipeline attributes match current pass attributes */
-        const _sg_pass_t* pass = _sg_lookup_pass(&_sg.pools, _sg.cur_pass.id);
-        if (pass) {
-            /* an offscreen pass */
-            _SG_VALIDATE(pip->cmn.color_count == pass->cmn.num_color_atts, VALIDATE_APIP_ATT_COUNT);
-            for (int i = 0; i < pip->cmn.color_count; i++) {
-                const _sg_image_t* att_img = _sg_pass_color_image(pass, i);
-                _SG_VALIDATE(pip->cmn.colors[i].pixel_format == att_img->cmn.pixel_format, VALIDATE_APIP_COLOR_FORMAT);
-                _SG_VALIDATE(pip->cmn.sample_count == att_img->cmn.sample_count, VALIDATE_APIP_SAMPLE_COUNT);
-            }
-            const _sg_image_t* att_dsimg = _sg_pass_ds_image(pass);
-            if (att_dsimg) {
-                _SG_VALIDATE(pip->cmn.depth.pixel_format == att_dsimg->cmn.pixel_format, VALIDATE_APIP_DEPTH_FORMAT);
-            }
-            else {
-                _SG_VALIDATE(pip->cmn.depth.pixel_format == SG_PIXELFORMAT_NONE, VALIDATE_APIP_DEPTH_FORMAT);
-            }
-        }
-        else {
-            /* default pass */
-            _SG_VALIDATE(pip->cmn.color_count == 1, VALIDATE_APIP_ATT_COUNT);
-            _SG_VALIDATE(pip->cmn.colors[0].pixel_format == _sg.desc.context.color_format, VALIDATE_APIP_COLOR_FORMAT);
-            _SG_VALIDATE(pip->cmn.depth.pixel_format == _sg.desc.context.depth_format, VALIDATE_APIP_DEPTH_FORMAT);
-            _SG_VALIDATE(pip->cmn.sample_count == _sg.desc.context.sample_count, VALIDATE_APIP_SAMPLE_COUNT);
+        if (_sg_validate_pipeline_object(pip_id, pip)) {
+            _sg_validate_pipeline_pass(pip);
         }
         return _sg_validate_end();
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
+/* pip_id is the applied pipeline, or the one recorded before the bindings in a command list */
+_SOKOL_PRIVATE bool _sg_validate_apply_bindings(uint32_t pip_id, const sg_bindings* bindings) {
     #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(pip_id);
         _SOKOL_UNUSED(bindings);
         return true;
     #else
@@ -14881,8 +17633,8 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
         _sg_validate_begin();
 
         // a pipeline object must have been applied
-        _SG_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, VALIDATE_ABND_PIPELINE);
-        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
+        _SG_VALIDATE(pip_id != SG_INVALID_ID, VALIDATE_ABND_PIPELINE);
+        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id);
         _SG_VALIDATE(pip != 0, VALIDATE_ABND_PIPELINE_EXISTS);
         if (!pip) {
             return _sg_validate_end();
@@ -14962,8 +17714,94 @@ _SOKOL_PRIVATE bool _sg_validate_apply_bindings(const sg_bindings* bindings) {
     #endif
 }
 
-_SOKOL_PRIVATE bool _sg_validate_apply_uniforms(sg_shader_stage stage_index, int ub_index, const sg_range* data) {
+_SOKOL_PRIVATE bool _sg_validate_binding_set_desc(const sg_bindings* bindings) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(bindings);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        SOKOL_ASSERT(bindings);
+        _sg_validate_begin();
+        _SG_VALIDATE(bindings->_start_canary == 0, VALIDATE_BSETDESC_CANARY);
+        _SG_VALIDATE(bindings->_end_canary == 0, VALIDATE_BSETDESC_CANARY);
+        // NOTE: resources which don't exist or are not valid put the binding set into FAILED state
+        for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+            const _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
+            if (buf && (buf->slot.state == SG_RESOURCESTATE_VALID)) {
+                _SG_VALIDATE(SG_BUFFERTYPE_VERTEXBUFFER == buf->cmn.type, VALIDATE_BSETDESC_VB_TYPE);
+            }
+        }
+        const _sg_buffer_t* ib = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
+        if (ib && (ib->slot.state == SG_RESOURCESTATE_VALID)) {
+            _SG_VALIDATE(SG_BUFFERTYPE_INDEXBUFFER == ib->cmn.type, VALIDATE_BSETDESC_IB_TYPE);
+        }
+        for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+            for (int stage_index = 0; stage_index < SG_NUM_SHADER_STAGES; stage_index++) {
+                const sg_image img_id = (stage_index == SG_SHADERSTAGE_VS) ? bindings->vs_images[i] : bindings->fs_images[i];
+                const _sg_image_t* img = _sg_lookup_image(&_sg.pools, img_id.id);
+                if (img && (img->slot.state == SG_RESOURCESTATE_VALID)) {
+                    _SG_VALIDATE(img->cmn.sample_count == 1, VALIDATE_BSETDESC_IMG_MSAA);
+                    _SG_VALIDATE(!_sg_is_depth_or_depth_stencil_format(img->cmn.pixel_format), VALIDATE_BSETDESC_IMG_DEPTH);
+                }
+            }
+        }
+        return _sg_validate_end();
+    #endif
+}
+
+/* checks the binding set against the current pipeline, resource types have
+   already been checked when the binding set was created
+*/
+_SOKOL_PRIVATE bool _sg_validate_apply_binding_set(sg_binding_set bset_id) {
+    #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(bset_id);
+        return true;
+    #else
+        if (_sg.desc.disable_validation) {
+            return true;
+        }
+        _sg_validate_begin();
+        _sg_binding_set_t* bset = _sg_lookup_binding_set(&_sg.pools, bset_id.id);
+        _SG_VALIDATE(bset != 0, VALIDATE_ABSET_EXISTS);
+        _SG_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, VALIDATE_ABND_PIPELINE);
+        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
+        _SG_VALIDATE(pip != 0, VALIDATE_ABND_PIPELINE_EXISTS);
+        if (!(bset && pip)) {
+            return _sg_validate_end();
+        }
+        _SG_VALIDATE(pip->slot.state == SG_RESOURCESTATE_VALID, VALIDATE_ABND_PIPELINE_VALID);
+        if ((bset->slot.state != SG_RESOURCESTATE_VALID) || !_sg_binding_set_resources_valid(bset)) {
+            // draw calls are skipped, the referenced resources may no longer exist
+            return _sg_validate_end();
+        }
+        SOKOL_ASSERT(pip->shader && (pip->cmn.shader_id.id == pip->shader->slot.id));
+        for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+            _SG_VALIDATE(pip->cmn.vertex_layout_valid[i] == (i < bset->num_vbs), VALIDATE_ABND_VBS);
+        }
+        if (pip->cmn.index_type == SG_INDEXTYPE_NONE) {
+            _SG_VALIDATE(bset->ib == 0, VALIDATE_ABND_IB);
+        } else {
+            _SG_VALIDATE(bset->ib != 0, VALIDATE_ABND_NO_IB);
+        }
+        const _sg_shader_stage_t* vs_stage = &pip->shader->cmn.stage[SG_SHADERSTAGE_VS];
+        _SG_VALIDATE(bset->num_vs_imgs == vs_stage->num_images, VALIDATE_ABND_VS_IMGS);
+        for (int i = 0; i < _sg_min(bset->num_vs_imgs, vs_stage->num_images); i++) {
+            _SG_VALIDATE(bset->vs_imgs[i]->cmn.type == vs_stage->images[i].image_type, VALIDATE_ABND_VS_IMG_TYPES);
+        }
+        const _sg_shader_stage_t* fs_stage = &pip->shader->cmn.stage[SG_SHADERSTAGE_FS];
+        _SG_VALIDATE(bset->num_fs_imgs == fs_stage->num_images, VALIDATE_ABND_FS_IMGS);
+        for (int i = 0; i < _sg_min(bset->num_fs_imgs, fs_stage->num_images); i++) {
+            _SG_VALIDATE(bset->fs_imgs[i]->cmn.type == fs_stage->images[i].image_type, VALIDATE_ABND_FS_IMG_TYPES);
+        }
+        return _sg_validate_end();
+    #endif
+}
+
+_SOKOL_PRIVATE bool _sg_validate_apply_uniforms(uint32_t pip_id, sg_shader_stage stage_index, int ub_index, const sg_range* data) {
     #if !defined(SOKOL_DEBUG)
+        _SOKOL_UNUSED(pip_id);
         _SOKOL_UNUSED(stage_index);
         _SOKOL_UNUSED(ub_index);
         _SOKOL_UNUSED(data);
@@ -14975,9 +17813,12 @@ _SOKOL_PRIVATE bool _sg_validate_apply_uniforms(sg_shader_stage stage_index, int
         SOKOL_ASSERT((stage_index == SG_SHADERSTAGE_VS) || (stage_index == SG_SHADERSTAGE_FS));
         SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
         _sg_validate_begin();
-        _SG_VALIDATE(_sg.cur_pipeline.id != SG_INVALID_ID, VALIDATE_AUB_NO_PIPELINE);
-        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
-        SOKOL_ASSERT(pip && (pip->slot.id == _sg.cur_pipeline.id));
+        _SG_VALIDATE(pip_id != SG_INVALID_ID, VALIDATE_AUB_NO_PIPELINE);
+        const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id);
+        _SG_VALIDATE(pip != 0, VALIDATE_AUB_NO_PIPELINE);
+        if (!pip) {
+            return _sg_validate_end();
+        }
         SOKOL_ASSERT(pip->shader && (pip->shader->slot.id == pip->cmn.shader_id.id));
 
         /* check that there is a uniform block at 'stage' and 'ub_index' */
@@ -15076,6 +17917,10 @@ _SOKOL_PRIVATE sg_image_desc _sg_image_desc_defaults(const sg_image_desc* desc)
     sg_image_desc def = *desc;
     def.type = _sg_def(def.type, SG_IMAGETYPE_2D);
     def.num_slices = _sg_def(def.num_slices, 1);
+    def.generate_mipmaps = _sg_def(def.generate_mipmaps, SG_MIPMAPGEN_NONE);
+    if (def.generate_mipmaps != SG_MIPMAPGEN_NONE) {
+        def.num_mipmaps = _sg_def(def.num_mipmaps, _sg_full_mipmap_count(def.width, def.height));
+    }
     def.num_mipmaps = _sg_def(def.num_mipmaps, 1);
     def.usage = _sg_def(def.usage, SG_USAGE_IMMUTABLE);
     if (desc->render_target) {
@@ -15231,7 +18076,7 @@ _SOKOL_PRIVATE sg_buffer _sg_alloc_buffer(void) {
     sg_buffer res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.buffer_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, &_sg.pools.buffers[slot_index].slot, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.buffer_pool, slot_index);
     }
     else {
         res.id = SG_INVALID_ID;
@@ -15245,7 +18090,7 @@ _SOKOL_PRIVATE sg_image _sg_alloc_image(void) {
     sg_image res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.image_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.image_pool, &_sg.pools.images[slot_index].slot, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.image_pool, slot_index);
     }
     else {
         res.id = SG_INVALID_ID;
@@ -15259,7 +18104,7 @@ _SOKOL_PRIVATE sg_shader _sg_alloc_shader(void) {
     sg_shader res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.shader_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, &_sg.pools.shaders[slot_index].slot, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.shader_pool, slot_index);
     }
     else {
         res.id = SG_INVALID_ID;
@@ -15273,7 +18118,7 @@ _SOKOL_PRIVATE sg_pipeline _sg_alloc_pipeline(void) {
     sg_pipeline res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.pipeline_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id =_sg_slot_alloc(&_sg.pools.pipeline_pool, &_sg.pools.pipelines[slot_index].slot, slot_index);
+        res.id =_sg_slot_alloc(&_sg.pools.pipeline_pool, slot_index);
     }
     else {
         res.id = SG_INVALID_ID;
@@ -15287,7 +18132,7 @@ _SOKOL_PRIVATE sg_pass _sg_alloc_pass(void) {
     sg_pass res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.pass_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, &_sg.pools.passes[slot_index].slot, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.pass_pool, slot_index);
     }
     else {
         res.id = SG_INVALID_ID;
@@ -15297,40 +18142,178 @@ _SOKOL_PRIVATE sg_pass _sg_alloc_pass(void) {
     return res;
 }
 
+_SOKOL_PRIVATE sg_binding_set _sg_alloc_binding_set(void) {
+    sg_binding_set res;
+    int slot_index = _sg_pool_alloc_index(&_sg.pools.binding_set_pool);
+    if (_SG_INVALID_SLOT_INDEX != slot_index) {
+        res.id = _sg_slot_alloc(&_sg.pools.binding_set_pool, slot_index);
+    }
+    else {
+        res.id = SG_INVALID_ID;
+        _SG_ERROR(BINDING_SET_POOL_EXHAUSTED);
+        _SG_TRACE_NOARGS(err_binding_set_pool_exhausted);
+    }
+    return res;
+}
+
+/* the slot is reset before its index goes back to the pool, where another thread may take it right away */
 _SOKOL_PRIVATE void _sg_dealloc_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf && (buf->slot.state == SG_RESOURCESTATE_ALLOC) && (buf->slot.id != SG_INVALID_ID));
-    _sg_pool_free_index(&_sg.pools.buffer_pool, _sg_slot_index(buf->slot.id));
+    const int slot_index = _sg_slot_index(buf->slot.id);
     _sg_reset_slot(&buf->slot);
+    _sg_pool_free_index(&_sg.pools.buffer_pool, slot_index);
 }
 
 _SOKOL_PRIVATE void _sg_dealloc_image(_sg_image_t* img) {
     SOKOL_ASSERT(img && (img->slot.state == SG_RESOURCESTATE_ALLOC) && (img->slot.id != SG_INVALID_ID));
-    _sg_pool_free_index(&_sg.pools.image_pool, _sg_slot_index(img->slot.id));
+    const int slot_index = _sg_slot_index(img->slot.id);
     _sg_reset_slot(&img->slot);
+    _sg_pool_free_index(&_sg.pools.image_pool, slot_index);
 }
 
 _SOKOL_PRIVATE void _sg_dealloc_shader(_sg_shader_t* shd) {
     SOKOL_ASSERT(shd && (shd->slot.state == SG_RESOURCESTATE_ALLOC) && (shd->slot.id != SG_INVALID_ID));
-    _sg_pool_free_index(&_sg.pools.shader_pool, _sg_slot_index(shd->slot.id));
+    const int slot_index = _sg_slot_index(shd->slot.id);
     _sg_reset_slot(&shd->slot);
+    _sg_pool_free_index(&_sg.pools.shader_pool, slot_index);
 }
 
 _SOKOL_PRIVATE void _sg_dealloc_pipeline(_sg_pipeline_t* pip) {
     SOKOL_ASSERT(pip && (pip->slot.state == SG_RESOURCESTATE_ALLOC) && (pip->slot.id != SG_INVALID_ID));
-    _sg_pool_free_index(&_sg.pools.pipeline_pool, _sg_slot_index(pip->slot.id));
+    const int slot_index = _sg_slot_index(pip->slot.id);
     _sg_reset_slot(&pip->slot);
+    _sg_pool_free_index(&_sg.pools.pipeline_pool, slot_index);
 }
 
 _SOKOL_PRIVATE void _sg_dealloc_pass(_sg_pass_t* pass) {
     SOKOL_ASSERT(pass && (pass->slot.state == SG_RESOURCESTATE_ALLOC) && (pass->slot.id != SG_INVALID_ID));
-    _sg_pool_free_index(&_sg.pools.pass_pool, _sg_slot_index(pass->slot.id));
+    const int slot_index = _sg_slot_index(pass->slot.id);
     _sg_reset_slot(&pass->slot);
+    _sg_pool_free_index(&_sg.pools.pass_pool, slot_index);
+}
+
+_SOKOL_PRIVATE void _sg_dealloc_binding_set(_sg_binding_set_t* bset) {
+    SOKOL_ASSERT(bset && (bset->slot.id != SG_INVALID_ID));
+    const int slot_index = _sg_slot_index(bset->slot.id);
+    _sg_clear(bset, sizeof(_sg_binding_set_t));
+    _sg_pool_free_index(&_sg.pools.binding_set_pool, slot_index);
+}
+
+/*-- draw merging (sg_desc.merge_draws) ---------------------------------------*/
+
+/* issue the held back draw, must be called before anything touches backend state */
+_SOKOL_PRIVATE void _sg_merge_flush(void) {
+    if (_sg.merge.pending) {
+        _sg.merge.pending = false;
+        _sg_draw(_sg.merge.base_element, _sg.merge.num_elements, _sg.merge.num_instances);
+    }
+}
+
+/* hold back a draw or extend the pending draw with it, false if merging is disabled */
+_SOKOL_PRIVATE bool _sg_merge_draw(int base_element, int num_elements, int num_instances) {
+    if (!_sg.desc.merge_draws) {
+        return false;
+    }
+    _sg_draw_merge_t* m = &_sg.merge;
+    if (!m->list_primitives) {
+        _sg_merge_flush();
+        return false;
+    }
+    if (m->pending && (m->num_instances == num_instances) && ((m->base_element + m->num_elements) == base_element)) {
+        m->num_elements += num_elements;
+        _sg_stats_add(num_draw_merged, 1);
+        return true;
+    }
+    _sg_merge_flush();
+    m->pending = true;
+    m->base_element = base_element;
+    m->num_elements = num_elements;
+    m->num_instances = num_instances;
+    return true;
+}
+
+/* the following record the applied state and issue the pending draw when it changes,
+   the backend calls themselves still happen, since they only re-apply identical state
+*/
+_SOKOL_PRIVATE void _sg_merge_apply_pipeline(sg_pipeline pip_id) {
+    if (!_sg.desc.merge_draws) {
+        return;
+    }
+    if (_sg.merge.pending && (pip_id.id != _sg.cur_pipeline.id)) {
+        _sg_merge_flush();
+    }
+    const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+    if (pip) {
+        const sg_primitive_type prim_type = pip->cmn.primitive_type;
+        _sg.merge.list_primitives = (prim_type == SG_PRIMITIVETYPE_TRIANGLES) ||
+                                    (prim_type == SG_PRIMITIVETYPE_LINES) ||
+                                    (prim_type == SG_PRIMITIVETYPE_POINTS);
+    }
+    else {
+        _sg.merge.list_primitives = false;
+    }
+}
+
+_SOKOL_PRIVATE void _sg_merge_apply_bindings(const sg_bindings* bindings, sg_binding_set bset_id) {
+    if (!_sg.desc.merge_draws) {
+        return;
+    }
+    _sg_draw_merge_t* m = &_sg.merge;
+    bool same;
+    if (bindings) {
+        same = (0 == m->binding_set_id) && (0 == memcmp(&m->bindings, bindings, sizeof(sg_bindings)));
+    }
+    else {
+        same = (m->binding_set_id == bset_id.id);
+    }
+    if (!same) {
+        _sg_merge_flush();
+        if (bindings) {
+            m->bindings = *bindings;
+            m->binding_set_id = 0;
+        }
+        else {
+            _sg_clear(&m->bindings, sizeof(m->bindings));
+            m->binding_set_id = bset_id.id;
+        }
+    }
+}
+
+_SOKOL_PRIVATE void _sg_merge_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data) {
+    if (!_sg.desc.merge_draws) {
+        return;
+    }
+    size_t* size = &_sg.merge.uniform_size[stage][ub_index];
+    uint8_t* dst = _sg.merge.uniform_data[stage][ub_index];
+    if (data->size > _SG_MERGE_MAX_UNIFORM_SIZE) {
+        _sg_merge_flush();
+        *size = 0;
+    }
+    else if ((*size != data->size) || (0 != memcmp(dst, data->ptr, data->size))) {
+        _sg_merge_flush();
+        memcpy(dst, data->ptr, data->size);
+        *size = data->size;
+    }
+}
+
+/* forget the recorded state after the backend state was changed behind its back (sg_submit_commands) */
+_SOKOL_PRIVATE void _sg_merge_invalidate(void) {
+    SOKOL_ASSERT(!_sg.merge.pending);
+    _sg_draw_merge_t* m = &_sg.merge;
+    m->list_primitives = false;
+    m->binding_set_id = 0xFFFFFFFF;     // matches neither plain bindings nor a binding set
+    for (int stage = 0; stage < SG_NUM_SHADER_STAGES; stage++) {
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            m->uniform_size[stage][ub_index] = SIZE_MAX;
+        }
+    }
 }
 
 _SOKOL_PRIVATE void _sg_init_buffer(_sg_buffer_t* buf, const sg_buffer_desc* desc) {
     SOKOL_ASSERT(buf && (buf->slot.state == SG_RESOURCESTATE_ALLOC));
     SOKOL_ASSERT(desc);
     buf->slot.ctx_id = _sg.active_context.id;
+    _sg_merge_flush();
     if (_sg_validate_buffer_desc(desc)) {
         buf->slot.state = _sg_create_buffer(buf, desc);
     }
@@ -15340,12 +18323,282 @@ _SOKOL_PRIVATE void _sg_init_buffer(_sg_buffer_t* buf, const sg_buffer_desc* des
     SOKOL_ASSERT((buf->slot.state == SG_RESOURCESTATE_VALID)||(buf->slot.state == SG_RESOURCESTATE_FAILED));
 }
 
+/*-- GPU timings (sg_desc.gpu_timings) ---------------------------------------*/
+_SOKOL_PRIVATE void _sg_setup_gpu_timer(const sg_desc* desc) {
+    if (!desc->gpu_timings) {
+        return;
+    }
+    if (!_sg_gpu_timer_supported()) {
+        _SG_WARN(GPU_TIMINGS_NOT_SUPPORTED);
+        return;
+    }
+    _sg.gpu_timer.enabled = true;
+    _sg.gpu_timer.frames[0].frame_index = _sg.frame_index;
+}
+
+/* start measuring a pass or debug group, nests into the currently open group */
+_SOKOL_PRIVATE void _sg_gpu_timer_begin(const char* name) {
+    _sg_gpu_timer_t* t = &_sg.gpu_timer;
+    if (!t->enabled) {
+        return;
+    }
+    /* a held back draw belongs to the enclosing group */
+    _sg_merge_flush();
+    _sg_gpu_timer_frame_t* frame = &t->frames[t->cur_slot];
+    const int parent = (t->stack_depth > 0) ? t->stack[t->stack_depth - 1] : -1;
+    const bool parent_dropped = (t->stack_depth > 0) && (parent < 0);
+    int index = -1;
+    if ((t->stack_depth < _SG_GPU_TIMER_MAX_DEPTH) && !parent_dropped && (frame->num_groups < SG_MAX_GPU_TIMINGS)) {
+        index = frame->num_groups++;
+        _sg_gpu_timer_group_t* group = &frame->groups[index];
+        int i = 0;
+        for (; name[i] && (i < (_SG_GPU_TIMER_NAME_SIZE - 1)); i++) {
+            group->name[i] = name[i];
+        }
+        group->name[i] = 0;
+        group->parent = parent;
+        group->depth = t->stack_depth;
+        _sg_write_timestamp(t->cur_slot, 2 * index);
+    }
+    else {
+        frame->num_dropped++;
+    }
+    if (t->stack_depth < _SG_GPU_TIMER_MAX_DEPTH) {
+        t->stack[t->stack_depth] = index;
+    }
+    t->stack_depth++;
+}
+
+_SOKOL_PRIVATE void _sg_gpu_timer_end(void) {
+    _sg_gpu_timer_t* t = &_sg.gpu_timer;
+    if (!t->enabled || (t->stack_depth == 0)) {
+        return;
+    }
+    _sg_merge_flush();
+    t->stack_depth--;
+    if (t->stack_depth < _SG_GPU_TIMER_MAX_DEPTH) {
+        const int index = t->stack[t->stack_depth];
+        if (index >= 0) {
+            _sg_write_timestamp(t->cur_slot, 2 * index + 1);
+        }
+    }
+}
+
+/* copy the results of a finished frame into _sg.gpu_timer.results, false if the GPU isn't done yet */
+_SOKOL_PRIVATE bool _sg_gpu_timer_read_frame(int slot) {
+    _sg_gpu_timer_t* t = &_sg.gpu_timer;
+    const _sg_gpu_timer_frame_t* frame = &t->frames[slot];
+    uint64_t ts[2 * SG_MAX_GPU_TIMINGS];
+    /* the last timestamp is usually the last one to become available */
+    for (int i = (2 * frame->num_groups) - 1; i >= 0; i--) {
+        if (!_sg_read_timestamp(slot, i, &ts[i])) {
+            return false;
+        }
+    }
+    sg_gpu_timings* res = &t->results;
+    res->valid = true;
+    res->frame_index = frame->frame_index;
+    res->frame_time_ns = 0;
+    res->num_dropped = frame->num_dropped;
+    res->num_timings = frame->num_groups;
+    uint64_t first = 0;
+    uint64_t last = 0;
+    for (int i = 0; i < frame->num_groups; i++) {
+        const _sg_gpu_timer_group_t* group = &frame->groups[i];
+        const uint64_t t0 = ts[2 * i];
+        const uint64_t t1 = ts[2 * i + 1];
+        memcpy(t->names[i], group->name, _SG_GPU_TIMER_NAME_SIZE);
+        sg_gpu_timing* item = &res->timings[i];
+        item->name = t->names[i];
+        item->parent = group->parent;
+        item->depth = group->depth;
+        item->time_ns = (t1 > t0) ? (t1 - t0) : 0;
+        if ((i == 0) || (t0 < first)) {
+            first = t0;
+        }
+        if (t1 > last) {
+            last = t1;
+        }
+    }
+    if (last > first) {
+        res->frame_time_ns = last - first;
+    }
+    return true;
+}
+
+/* called from sg_commit(), closes the current frame and reads back completed frames without waiting */
+_SOKOL_PRIVATE void _sg_gpu_timer_commit(void) {
+    _sg_gpu_timer_t* t = &_sg.gpu_timer;
+    if (!t->enabled) {
+        return;
+    }
+    while (t->stack_depth > 0) {
+        _sg_gpu_timer_end();
+    }
+    t->frames[t->cur_slot].pending = (t->frames[t->cur_slot].num_groups > 0);
+    /* frames complete in order, start with the oldest one */
+    for (int i = 1; i <= _SG_GPU_TIMER_NUM_FRAMES; i++) {
+        _sg_gpu_timer_frame_t* frame = &t->frames[(t->cur_slot + i) % _SG_GPU_TIMER_NUM_FRAMES];
+        if (frame->pending) {
+            if (!_sg_gpu_timer_read_frame((t->cur_slot + i) % _SG_GPU_TIMER_NUM_FRAMES)) {
+                break;
+            }
+            frame->pending = false;
+        }
+    }
+    t->cur_slot = (t->cur_slot + 1) % _SG_GPU_TIMER_NUM_FRAMES;
+    _sg_gpu_timer_frame_t* next = &t->frames[t->cur_slot];
+    if (next->pending) {
+        t->results.num_frames_lost++;
+    }
+    next->pending = false;
+    next->frame_index = _sg.frame_index + 1;
+    next->num_groups = 0;
+    next->num_dropped = 0;
+}
+
+/*-- mipmap generation on the CPU --------------------------------------------*/
+_SOKOL_PRIVATE bool _sg_needs_cpu_mipmap_gen(const sg_image_desc* desc) {
+    if (desc->num_mipmaps <= 1) {
+        return false;
+    }
+    #if defined(_SOKOL_ANY_GL)
+    return desc->generate_mipmaps == SG_MIPMAPGEN_CPU;
+    #else
+    return desc->generate_mipmaps != SG_MIPMAPGEN_NONE;
+    #endif
+}
+
+/* sRGB 8-bit -> linear 12-bit, round(srgb_to_linear(i / 255) * 4095) */
+static const uint16_t _sg_srgb_to_linear12[256] = {
+    0, 1, 2, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, 16, 18, 20,
+    21, 23, 25, 27, 29, 31, 33, 35, 37, 40, 42, 45, 48, 50, 53, 56,
+    59, 62, 66, 69, 72, 76, 79, 83, 87, 91, 95, 99, 103, 107, 112, 116,
+    121, 126, 131, 136, 141, 146, 151, 156, 162, 168, 173, 179, 185, 191, 197, 204,
+    210, 216, 223, 230, 237, 244, 251, 258, 265, 273, 280, 288, 296, 304, 312, 320,
+    329, 337, 346, 354, 363, 372, 381, 390, 400, 409, 419, 428, 438, 448, 458, 469,
+    479, 490, 500, 511, 522, 533, 544, 555, 567, 578, 590, 602, 614, 626, 639, 651,
+    664, 676, 689, 702, 715, 728, 742, 755, 769, 783, 797, 811, 825, 840, 854, 869,
+    884, 899, 914, 929, 945, 960, 976, 992, 1008, 1024, 1041, 1057, 1074, 1091, 1108, 1125,
+    1142, 1159, 1177, 1195, 1213, 1231, 1249, 1267, 1286, 1304, 1323, 1342, 1361, 1381, 1400, 1420,
+    1440, 1459, 1480, 1500, 1520, 1541, 1562, 1582, 1603, 1625, 1646, 1668, 1689, 1711, 1733, 1755,
+    1778, 1800, 1823, 1846, 1869, 1892, 1916, 1939, 1963, 1987, 2011, 2035, 2059, 2084, 2109, 2133,
+    2159, 2184, 2209, 2235, 2260, 2286, 2312, 2339, 2365, 2392, 2419, 2446, 2473, 2500, 2527, 2555,
+    2583, 2611, 2639, 2668, 2696, 2725, 2754, 2783, 2812, 2841, 2871, 2901, 2931, 2961, 2991, 3022,
+    3052, 3083, 3114, 3146, 3177, 3209, 3240, 3272, 3304, 3337, 3369, 3402, 3435, 3468, 3501, 3535,
+    3568, 3602, 3636, 3670, 3705, 3739, 3774, 3809, 3844, 3879, 3915, 3950, 3986, 4022, 4059, 4095
+};
+/* smallest linear 12-bit value which rounds to sRGB 8-bit value i */
+static const uint16_t _sg_srgb_from_linear12[256] = {
+    0, 1, 2, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, 16, 18, 19,
+    21, 23, 24, 26, 28, 30, 32, 34, 37, 39, 42, 44, 47, 49, 52, 55,
+    58, 61, 64, 68, 71, 74, 78, 82, 85, 89, 93, 97, 102, 106, 110, 115,
+    119, 124, 129, 134, 139, 144, 149, 154, 160, 165, 171, 177, 183, 189, 195, 201,
+    207, 214, 220, 227, 234, 241, 248, 255, 262, 270, 277, 285, 293, 300, 308, 317,
+    325, 333, 342, 350, 359, 368, 377, 386, 395, 405, 414, 424, 434, 444, 454, 464,
+    474, 485, 495, 506, 517, 528, 539, 550, 562, 573, 585, 597, 609, 621, 633, 645,
+    658, 670, 683, 696, 709, 722, 736, 749, 763, 777, 790, 805, 819, 833, 848, 862,
+    877, 892, 907, 922, 938, 953, 969, 985, 1001, 1017, 1033, 1049, 1066, 1083, 1100, 1117,
+    1134, 1151, 1169, 1186, 1204, 1222, 1240, 1259, 1277, 1296, 1314, 1333, 1352, 1372, 1391, 1410,
+    1430, 1450, 1470, 1490, 1510, 1531, 1552, 1572, 1593, 1615, 1636, 1657, 1679, 1701, 1723, 1745,
+    1767, 1790, 1812, 1835, 1858, 1881, 1904, 1928, 1951, 1975, 1999, 2023, 2048, 2072, 2097, 2122,
+    2146, 2172, 2197, 2222, 2248, 2274, 2300, 2326, 2352, 2379, 2406, 2433, 2460, 2487, 2514, 2542,
+    2570, 2597, 2626, 2654, 2682, 2711, 2740, 2769, 2798, 2827, 2857, 2886, 2916, 2946, 2977, 3007,
+    3038, 3068, 3099, 3130, 3162, 3193, 3225, 3257, 3289, 3321, 3354, 3386, 3419, 3452, 3485, 3518,
+    3552, 3586, 3620, 3654, 3688, 3722, 3757, 3792, 3827, 3862, 3897, 3933, 3969, 4005, 4041, 4077
+};
+
+/* 2x2 box filter, odd source sizes drop the last row/column like the 3D APIs' mipmap sizes do */
+_SOKOL_PRIVATE void _sg_downsample(const uint8_t* src, int src_w, int src_h, uint8_t* dst, int dst_w, int dst_h, int bpp, const uint16_t* to_linear, const uint8_t* to_srgb) {
+    const int src_pitch = src_w * bpp;
+    for (int y = 0; y < dst_h; y++) {
+        const uint8_t* row0 = src + _sg_min(2 * y, src_h - 1) * src_pitch;
+        const uint8_t* row1 = src + _sg_min(2 * y + 1, src_h - 1) * src_pitch;
+        uint8_t* out = dst + y * dst_w * bpp;
+        if (to_linear) {
+            SOKOL_ASSERT(4 == bpp);
+            for (int x = 0; x < dst_w; x++) {
+                const int i0 = _sg_min(2 * x, src_w - 1) * 4;
+                const int i1 = _sg_min(2 * x + 1, src_w - 1) * 4;
+                for (int c = 0; c < 3; c++) {
+                    const int sum = to_linear[row0[i0 + c]] + to_linear[row0[i1 + c]] + to_linear[row1[i0 + c]] + to_linear[row1[i1 + c]];
+                    out[x * 4 + c] = to_srgb[(sum + 2) >> 2];
+                }
+                out[x * 4 + 3] = (uint8_t)((row0[i0 + 3] + row0[i1 + 3] + row1[i0 + 3] + row1[i1 + 3] + 2) >> 2);
+            }
+        } else if (src_w >= 2) {
+            /* the common case, a branch-free loop the compiler can vectorize */
+            for (int x = 0; x < dst_w; x++) {
+                const uint8_t* p0 = row0 + x * 2 * bpp;
+                const uint8_t* p1 = row1 + x * 2 * bpp;
+                for (int c = 0; c < bpp; c++) {
+                    out[x * bpp + c] = (uint8_t)((p0[c] + p0[c + bpp] + p1[c] + p1[c + bpp] + 2) >> 2);
+                }
+            }
+        } else {
+            for (int c = 0; c < bpp; c++) {
+                out[c] = (uint8_t)((row0[c] + row1[c] + 1) >> 1);
+            }
+        }
+    }
+}
+
+/* fill in the missing mipmap levels of an image desc, returns the memory to free after image creation */
+_SOKOL_PRIVATE void* _sg_generate_mipmaps(sg_image_desc* desc) {
+    SOKOL_ASSERT(desc && _sg_is_mipmap_gen_format(desc->pixel_format));
+    const int bpp = _sg_pixelformat_bytesize(desc->pixel_format);
+    const int num_faces = (desc->type == SG_IMAGETYPE_CUBE) ? 6 : 1;
+    size_t size = 0;
+    for (int mip_index = 1; mip_index < desc->num_mipmaps; mip_index++) {
+        size += (size_t)_sg_max(desc->width >> mip_index, 1) * (size_t)_sg_max(desc->height >> mip_index, 1) * (size_t)bpp;
+    }
+    uint8_t* mem = (uint8_t*)_sg_malloc(size * (size_t)num_faces);
+    /* sRGB colors are averaged as 12-bit linear values */
+    uint8_t to_srgb[4096];
+    const bool srgb = (desc->pixel_format == SG_PIXELFORMAT_SRGB8A8);
+    if (srgb) {
+        int c = 0;
+        for (int i = 0; i < 4096; i++) {
+            while ((c < 255) && (i >= _sg_srgb_from_linear12[c + 1])) {
+                c++;
+            }
+            to_srgb[i] = (uint8_t)c;
+        }
+    }
+    uint8_t* dst = mem;
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        const uint8_t* src = (const uint8_t*)desc->data.subimage[face_index][0].ptr;
+        for (int mip_index = 1; mip_index < desc->num_mipmaps; mip_index++) {
+            const int src_w = _sg_max(desc->width >> (mip_index - 1), 1);
+            const int src_h = _sg_max(desc->height >> (mip_index - 1), 1);
+            const int dst_w = _sg_max(desc->width >> mip_index, 1);
+            const int dst_h = _sg_max(desc->height >> mip_index, 1);
+            _sg_downsample(src, src_w, src_h, dst, dst_w, dst_h, bpp, srgb ? _sg_srgb_to_linear12 : 0, srgb ? to_srgb : 0);
+            const size_t mip_size = (size_t)(dst_w * dst_h * bpp);
+            desc->data.subimage[face_index][mip_index].ptr = dst;
+            desc->data.subimage[face_index][mip_index].size = mip_size;
+            src = dst;
+            dst += mip_size;
+        }
+    }
+    desc->generate_mipmaps = SG_MIPMAPGEN_NONE;
+    return mem;
+}
+
 _SOKOL_PRIVATE void _sg_init_image(_sg_image_t* img, const sg_image_desc* desc) {
     SOKOL_ASSERT(img && (img->slot.state == SG_RESOURCESTATE_ALLOC));
     SOKOL_ASSERT(desc);
     img->slot.ctx_id = _sg.active_context.id;
+    _sg_merge_flush();
     if (_sg_validate_image_desc(desc)) {
-        img->slot.state = _sg_create_image(img, desc);
+        if (_sg_needs_cpu_mipmap_gen(desc)) {
+            sg_image_desc gen_desc = *desc;
+            void* mem = _sg_generate_mipmaps(&gen_desc);
+            img->slot.state = _sg_create_image(img, &gen_desc);
+            _sg_free(mem);
+        } else {
+            img->slot.state = _sg_create_image(img, desc);
+        }
     }
     else {
         img->slot.state = SG_RESOURCESTATE_FAILED;
@@ -15357,24 +18610,37 @@ _SOKOL_PRIVATE void _sg_init_shader(_sg_shader_t* shd, const sg_shader_desc* des
     SOKOL_ASSERT(shd && (shd->slot.state == SG_RESOURCESTATE_ALLOC));
     SOKOL_ASSERT(desc);
     shd->slot.ctx_id = _sg.active_context.id;
+    _sg_merge_flush();
     if (_sg_validate_shader_desc(desc)) {
         shd->slot.state = _sg_create_shader(shd, desc);
+        if (shd->slot.state == SG_RESOURCESTATE_PENDING) {
+            _sg.num_pending_shaders++;
+        }
     }
     else {
         shd->slot.state = SG_RESOURCESTATE_FAILED;
     }
-    SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID)||(shd->slot.state == SG_RESOURCESTATE_FAILED));
+    SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID)||(shd->slot.state == SG_RESOURCESTATE_FAILED)||(shd->slot.state == SG_RESOURCESTATE_PENDING));
 }
 
 _SOKOL_PRIVATE void _sg_init_pipeline(_sg_pipeline_t* pip, const sg_pipeline_desc* desc) {
     SOKOL_ASSERT(pip && (pip->slot.state == SG_RESOURCESTATE_ALLOC));
     SOKOL_ASSERT(desc);
     pip->slot.ctx_id = _sg.active_context.id;
+    _sg_merge_flush();
     if (_sg_validate_pipeline_desc(desc)) {
         _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, desc->shader.id);
         if (shd && (shd->slot.state == SG_RESOURCESTATE_VALID)) {
             pip->slot.state = _sg_create_pipeline(pip, shd, desc);
         }
+        else if (shd && (shd->slot.state == SG_RESOURCESTATE_PENDING)) {
+            /* created in _sg_process_pending_resources() once the shader is ready */
+            pip->cmn.pending_desc = (sg_pipeline_desc*) _sg_malloc(sizeof(sg_pipeline_desc));
+            *pip->cmn.pending_desc = *desc;
+            pip->cmn.pending_desc->label = 0;
+            pip->slot.state = SG_RESOURCESTATE_PENDING;
+            _sg.num_pending_pipelines++;
+        }
         else {
             pip->slot.state = SG_RESOURCESTATE_FAILED;
         }
@@ -15382,13 +18648,60 @@ _SOKOL_PRIVATE void _sg_init_pipeline(_sg_pipeline_t* pip, const sg_pipeline_des
     else {
         pip->slot.state = SG_RESOURCESTATE_FAILED;
     }
-    SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID)||(pip->slot.state == SG_RESOURCESTATE_FAILED));
+    SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID)||(pip->slot.state == SG_RESOURCESTATE_FAILED)||(pip->slot.state == SG_RESOURCESTATE_PENDING));
+}
+
+/* resolve the resource pointers, all referenced resources must be valid */
+_SOKOL_PRIVATE void _sg_init_binding_set(_sg_binding_set_t* bset, const sg_bindings* bindings) {
+    SOKOL_ASSERT(bset && (bset->slot.state == SG_RESOURCESTATE_ALLOC));
+    SOKOL_ASSERT(bindings);
+    bset->slot.ctx_id = _sg.active_context.id;
+    bset->slot.state = SG_RESOURCESTATE_FAILED;
+    if (!_sg_validate_binding_set_desc(bindings)) {
+        return;
+    }
+    for (int i = 0; (i < SG_MAX_SHADERSTAGE_BUFFERS) && bindings->vertex_buffers[i].id; i++) {
+        _sg_buffer_t* buf = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
+        if (!(buf && (buf->slot.state == SG_RESOURCESTATE_VALID))) {
+            return;
+        }
+        bset->vbs[bset->num_vbs] = buf;
+        bset->vb_ids[bset->num_vbs] = buf->slot.id;
+        bset->vb_offsets[bset->num_vbs++] = bindings->vertex_buffer_offsets[i];
+    }
+    if (bindings->index_buffer.id) {
+        bset->ib = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
+        if (!(bset->ib && (bset->ib->slot.state == SG_RESOURCESTATE_VALID))) {
+            return;
+        }
+        bset->ib_id = bset->ib->slot.id;
+        bset->ib_offset = bindings->index_buffer_offset;
+    }
+    for (int i = 0; (i < SG_MAX_SHADERSTAGE_IMAGES) && bindings->vs_images[i].id; i++) {
+        _sg_image_t* img = _sg_lookup_image(&_sg.pools, bindings->vs_images[i].id);
+        if (!(img && (img->slot.state == SG_RESOURCESTATE_VALID))) {
+            return;
+        }
+        bset->vs_imgs[bset->num_vs_imgs] = img;
+        bset->vs_img_ids[bset->num_vs_imgs++] = img->slot.id;
+    }
+    for (int i = 0; (i < SG_MAX_SHADERSTAGE_IMAGES) && bindings->fs_images[i].id; i++) {
+        _sg_image_t* img = _sg_lookup_image(&_sg.pools, bindings->fs_images[i].id);
+        if (!(img && (img->slot.state == SG_RESOURCESTATE_VALID))) {
+            return;
+        }
+        bset->fs_imgs[bset->num_fs_imgs] = img;
+        bset->fs_img_ids[bset->num_fs_imgs++] = img->slot.id;
+    }
+    bset->checked_epoch = _sg.resource_epoch;
+    bset->slot.state = SG_RESOURCESTATE_VALID;
 }
 
 _SOKOL_PRIVATE void _sg_init_pass(_sg_pass_t* pass, const sg_pass_desc* desc) {
     SOKOL_ASSERT(pass && pass->slot.state == SG_RESOURCESTATE_ALLOC);
     SOKOL_ASSERT(desc);
     pass->slot.ctx_id = _sg.active_context.id;
+    _sg_merge_flush();
     if (_sg_validate_pass_desc(desc)) {
         // lookup pass attachment image pointers
         _sg_image_t* color_images[SG_MAX_COLOR_ATTACHMENTS] = { 0 };
@@ -15427,6 +18740,8 @@ _SOKOL_PRIVATE void _sg_init_pass(_sg_pass_t* pass, const sg_pass_desc* desc) {
 _SOKOL_PRIVATE void _sg_uninit_buffer(_sg_buffer_t* buf) {
     SOKOL_ASSERT(buf && ((buf->slot.state == SG_RESOURCESTATE_VALID) || (buf->slot.state == SG_RESOURCESTATE_FAILED)));
     if (buf->slot.ctx_id == _sg.active_context.id) {
+        _sg_merge_flush();
+        _sg.resource_epoch++;
         _sg_discard_buffer(buf);
         _sg_reset_buffer_to_alloc_state(buf);
     }
@@ -15439,6 +18754,8 @@ _SOKOL_PRIVATE void _sg_uninit_buffer(_sg_buffer_t* buf) {
 _SOKOL_PRIVATE void _sg_uninit_image(_sg_image_t* img) {
     SOKOL_ASSERT(img && ((img->slot.state == SG_RESOURCESTATE_VALID) || (img->slot.state == SG_RESOURCESTATE_FAILED)));
     if (img->slot.ctx_id == _sg.active_context.id) {
+        _sg_merge_flush();
+        _sg.resource_epoch++;
         _sg_discard_image(img);
         _sg_reset_image_to_alloc_state(img);
     }
@@ -15449,8 +18766,12 @@ _SOKOL_PRIVATE void _sg_uninit_image(_sg_image_t* img) {
 }
 
 _SOKOL_PRIVATE void _sg_uninit_shader(_sg_shader_t* shd) {
-    SOKOL_ASSERT(shd && ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED)));
+    SOKOL_ASSERT(shd && ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED) || (shd->slot.state == SG_RESOURCESTATE_PENDING)));
     if (shd->slot.ctx_id == _sg.active_context.id) {
+        _sg_merge_flush();
+        if (shd->slot.state == SG_RESOURCESTATE_PENDING) {
+            _sg.num_pending_shaders--;
+        }
         _sg_discard_shader(shd);
         _sg_reset_shader_to_alloc_state(shd);
     }
@@ -15461,9 +18782,17 @@ _SOKOL_PRIVATE void _sg_uninit_shader(_sg_shader_t* shd) {
 }
 
 _SOKOL_PRIVATE void _sg_uninit_pipeline(_sg_pipeline_t* pip) {
-    SOKOL_ASSERT(pip && ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED)));
+    SOKOL_ASSERT(pip && ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED) || (pip->slot.state == SG_RESOURCESTATE_PENDING)));
     if (pip->slot.ctx_id == _sg.active_context.id) {
-        _sg_discard_pipeline(pip);
+        _sg_merge_flush();
+        if (pip->slot.state == SG_RESOURCESTATE_PENDING) {
+            /* the backend pipeline hasn't been created yet */
+            _sg_free(pip->cmn.pending_desc);
+            _sg.num_pending_pipelines--;
+        }
+        else {
+            _sg_discard_pipeline(pip);
+        }
         _sg_reset_pipeline_to_alloc_state(pip);
     }
     else {
@@ -15475,6 +18804,7 @@ _SOKOL_PRIVATE void _sg_uninit_pipeline(_sg_pipeline_t* pip) {
 _SOKOL_PRIVATE void _sg_uninit_pass(_sg_pass_t* pass) {
     SOKOL_ASSERT(pass && ((pass->slot.state == SG_RESOURCESTATE_VALID) || (pass->slot.state == SG_RESOURCESTATE_FAILED)));
     if (pass->slot.ctx_id == _sg.active_context.id) {
+        _sg_merge_flush();
         _sg_discard_pass(pass);
         _sg_reset_pass_to_alloc_state(pass);
     }
@@ -15494,10 +18824,124 @@ _SOKOL_PRIVATE void _sg_setup_commit_listeners(const sg_desc* desc) {
     _sg.commit_listeners.items = (sg_commit_listener*)_sg_malloc_clear(size);
 }
 
-_SOKOL_PRIVATE void _sg_discard_commit_listeners(void) {
-    SOKOL_ASSERT(0 != _sg.commit_listeners.items);
-    _sg_free(_sg.commit_listeners.items);
-    _sg.commit_listeners.items = 0;
+_SOKOL_PRIVATE void _sg_discard_commit_listeners(void) {
+    SOKOL_ASSERT(0 != _sg.commit_listeners.items);
+    _sg_free(_sg.commit_listeners.items);
+    _sg.commit_listeners.items = 0;
+}
+
+/*-- deferred resource initialization ----------------------------------------*/
+_SOKOL_PRIVATE void _sg_setup_init_queue(const sg_desc* desc) {
+    SOKOL_ASSERT(desc->init_queue_size > 0);
+    SOKOL_ASSERT(0 == _sg.init_queue.items);
+    _sg.init_queue.size = desc->init_queue_size;
+    const size_t size = (size_t)_sg.init_queue.size * sizeof(_sg_init_item_t);
+    _sg.init_queue.items = (_sg_init_item_t*)_sg_malloc_clear(size);
+}
+
+_SOKOL_PRIVATE void _sg_discard_init_queue(void) {
+    SOKOL_ASSERT(0 != _sg.init_queue.items);
+    _sg_free(_sg.init_queue.items);
+    _sg.init_queue.items = 0;
+}
+
+/* called from any thread, copies the item into the queue */
+_SOKOL_PRIVATE bool _sg_push_init_item(const _sg_init_item_t* item) {
+    SOKOL_ASSERT(item);
+    bool res = false;
+    _sg_spinlock_lock(&_sg.init_queue.lock);
+    if (_sg.init_queue.count < _sg.init_queue.size) {
+        const int index = (_sg.init_queue.head + _sg.init_queue.count) % _sg.init_queue.size;
+        _sg.init_queue.items[index] = *item;
+        _sg.init_queue.count++;
+        res = true;
+    }
+    _sg_spinlock_unlock(&_sg.init_queue.lock);
+    return res;
+}
+
+_SOKOL_PRIVATE bool _sg_pop_init_item(_sg_init_item_t* out_item) {
+    SOKOL_ASSERT(out_item);
+    bool res = false;
+    _sg_spinlock_lock(&_sg.init_queue.lock);
+    if (_sg.init_queue.count > 0) {
+        *out_item = _sg.init_queue.items[_sg.init_queue.head];
+        _sg.init_queue.head = (_sg.init_queue.head + 1) % _sg.init_queue.size;
+        _sg.init_queue.count--;
+        res = true;
+    }
+    _sg_spinlock_unlock(&_sg.init_queue.lock);
+    return res;
+}
+
+/* called from sg_commit(), run queued init work until the time budget is used up */
+_SOKOL_PRIVATE void _sg_process_init_queue(void) {
+    // the queue may be pushed to from other threads, so don't peek at
+    // the item count outside the lock, just try to pop the first item
+    _sg_init_item_t item;
+    if (!_sg_pop_init_item(&item)) {
+        return;
+    }
+    const uint64_t start_us = _sg_time_us();
+    do {
+        if (item.type == _SG_INITITEM_BUFFER) {
+            const sg_buffer buf_id = { item.id };
+            if (sg_query_buffer_state(buf_id) == SG_RESOURCESTATE_ALLOC) {
+                sg_init_buffer(buf_id, &item.desc.buf);
+            }
+        } else {
+            const sg_image img_id = { item.id };
+            if (sg_query_image_state(img_id) == SG_RESOURCESTATE_ALLOC) {
+                sg_init_image(img_id, &item.desc.img);
+            }
+        }
+        if ((_sg_time_us() - start_us) >= (uint64_t)_sg.desc.init_queue_budget_us) {
+            break;
+        }
+    } while (_sg_pop_init_item(&item));
+}
+
+/* called from sg_commit(), finish shaders and pipelines created with sg_desc.async_shader_compile */
+_SOKOL_PRIVATE void _sg_process_pending_resources(void) {
+    if (0 == (_sg.num_pending_shaders + _sg.num_pending_pipelines)) {
+        return;
+    }
+    const uint64_t start_us = _sg_time_us();
+    _sg_pools_t* p = &_sg.pools;
+    for (int i = 1; (i < p->shader_pool.size) && (_sg.num_pending_shaders > 0); i++) {
+        _sg_shader_t* shd = (_sg_shader_t*) _sg_pool_item(&p->shader_pool, i);
+        if ((shd->slot.state != SG_RESOURCESTATE_PENDING) || (shd->slot.ctx_id != _sg.active_context.id)) {
+            continue;
+        }
+        shd->slot.state = _sg_poll_shader(shd);
+        if (shd->slot.state != SG_RESOURCESTATE_PENDING) {
+            _sg.num_pending_shaders--;
+            if ((_sg_time_us() - start_us) >= (uint64_t)_sg.desc.init_queue_budget_us) {
+                break;
+            }
+        }
+    }
+    for (int i = 1; (i < p->pipeline_pool.size) && (_sg.num_pending_pipelines > 0); i++) {
+        _sg_pipeline_t* pip = (_sg_pipeline_t*) _sg_pool_item(&p->pipeline_pool, i);
+        if ((pip->slot.state != SG_RESOURCESTATE_PENDING) || (pip->slot.ctx_id != _sg.active_context.id)) {
+            continue;
+        }
+        sg_pipeline_desc* desc = pip->cmn.pending_desc;
+        SOKOL_ASSERT(desc);
+        _sg_shader_t* shd = _sg_lookup_shader(p, desc->shader.id);
+        if (shd && (shd->slot.state == SG_RESOURCESTATE_PENDING)) {
+            continue;
+        }
+        pip->cmn.pending_desc = 0;
+        if (shd && (shd->slot.state == SG_RESOURCESTATE_VALID)) {
+            pip->slot.state = _sg_create_pipeline(pip, shd, desc);
+        }
+        else {
+            pip->slot.state = SG_RESOURCESTATE_FAILED;
+        }
+        _sg_free(desc);
+        _sg.num_pending_pipelines--;
+    }
 }
 
 _SOKOL_PRIVATE void _sg_notify_commit_listeners(void) {
@@ -15560,6 +19004,110 @@ _SOKOL_PRIVATE bool _sg_remove_commit_listener(const sg_commit_listener* listene
     return false;
 }
 
+_SOKOL_PRIVATE uint32_t _sg_image_data_size(const _sg_image_t* img, const sg_image_data* data) {
+    const int num_faces = (img->cmn.type == SG_IMAGETYPE_CUBE) ? 6 : 1;
+    size_t size = 0;
+    for (int face_index = 0; face_index < num_faces; face_index++) {
+        for (int mip_index = 0; mip_index < img->cmn.num_mipmaps; mip_index++) {
+            size += data->subimage[face_index][mip_index].size;
+        }
+    }
+    return (uint32_t)size;
+}
+
+/*-- command list recording --------------------------------------------------*/
+typedef enum {
+    _SG_CMD_APPLY_VIEWPORT,
+    _SG_CMD_APPLY_SCISSOR_RECT,
+    _SG_CMD_APPLY_PIPELINE,
+    _SG_CMD_APPLY_BINDINGS,
+    _SG_CMD_APPLY_UNIFORMS,
+    _SG_CMD_DRAW,
+    _SG_CMD_DRAW_BATCH,
+} _sg_cmd_type_t;
+
+/* each command starts with a header, payloads are 8-byte aligned */
+typedef struct {
+    uint32_t type;
+    uint32_t size;      /* size of header plus payload */
+} _sg_cmd_header_t;
+
+typedef struct {
+    int x, y, width, height;
+    bool origin_top_left;
+} _sg_cmd_rect_t;
+
+/* resources are resolved and validated while recording, replay goes straight to the backend */
+typedef struct {
+    _sg_pipeline_t* pip;
+    uint32_t pip_id;
+    bool valid;
+} _sg_cmd_pipeline_t;
+
+typedef struct {
+    sg_bindings bindings;       // for validation at replay if the pipeline was pending
+    _sg_buffer_t* vbs[SG_MAX_SHADERSTAGE_BUFFERS];
+    int vb_offsets[SG_MAX_SHADERSTAGE_BUFFERS];
+    int num_vbs;
+    _sg_buffer_t* ib;
+    int ib_offset;
+    _sg_image_t* vs_imgs[SG_MAX_SHADERSTAGE_IMAGES];
+    int num_vs_imgs;
+    _sg_image_t* fs_imgs[SG_MAX_SHADERSTAGE_IMAGES];
+    int num_fs_imgs;
+    bool checked;
+    bool valid;
+} _sg_cmd_bindings_t;
+
+typedef struct {
+    sg_shader_stage stage;
+    int ub_index;
+    size_t size;        /* uniform data follows */
+    bool checked;
+    bool valid;
+} _sg_cmd_uniforms_t;
+
+typedef struct {
+    int base_element;
+    int num_elements;
+    int num_instances;
+} _sg_cmd_draw_t;
+
+typedef struct {
+    int num_items;      /* sg_draw_item array follows */
+} _sg_cmd_draw_batch_t;
+
+/* reserve space for a command, returns a pointer to the payload or 0 on overflow */
+_SOKOL_PRIVATE void* _sg_cmd_alloc(sg_command_list* cmds, _sg_cmd_type_t type, size_t payload_size) {
+    SOKOL_ASSERT(cmds);
+    if (cmds->overflow) {
+        return 0;
+    }
+    /* payloads beyond the remaining memory would overflow the int roundup */
+    if (payload_size > (cmds->size - cmds->pos)) {
+        cmds->overflow = true;
+        return 0;
+    }
+    SOKOL_ASSERT((sizeof(_sg_cmd_header_t) + payload_size) < (size_t)(INT32_MAX - 8));
+    const size_t size = (size_t)_sg_roundup((int)(sizeof(_sg_cmd_header_t) + payload_size), 8);
+    if ((cmds->pos + size) > cmds->size) {
+        cmds->overflow = true;
+        return 0;
+    }
+    _sg_cmd_header_t* hdr = (_sg_cmd_header_t*)(cmds->ptr + cmds->pos);
+    hdr->type = (uint32_t)type;
+    hdr->size = (uint32_t)size;
+    cmds->pos += size;
+    cmds->num_commands++;
+    return hdr + 1;
+}
+
+_SOKOL_PRIVATE void _sg_update_frame_stats(void) {
+    _sg.stats.cur_frame.frame_index = _sg.frame_index;
+    _sg.stats.prev_frame = _sg.stats.cur_frame;
+    _sg_clear(&_sg.stats.cur_frame, sizeof(_sg.stats.cur_frame));
+}
+
 _SOKOL_PRIVATE sg_desc _sg_desc_defaults(const sg_desc* desc) {
     /*
         NOTE: on WebGPU, the default color pixel format MUST be provided,
@@ -15580,11 +19128,14 @@ _SOKOL_PRIVATE sg_desc _sg_desc_defaults(const sg_desc* desc) {
     res.shader_pool_size = _sg_def(res.shader_pool_size, _SG_DEFAULT_SHADER_POOL_SIZE);
     res.pipeline_pool_size = _sg_def(res.pipeline_pool_size, _SG_DEFAULT_PIPELINE_POOL_SIZE);
     res.pass_pool_size = _sg_def(res.pass_pool_size, _SG_DEFAULT_PASS_POOL_SIZE);
+    res.binding_set_pool_size = _sg_def(res.binding_set_pool_size, _SG_DEFAULT_BINDING_SET_POOL_SIZE);
     res.context_pool_size = _sg_def(res.context_pool_size, _SG_DEFAULT_CONTEXT_POOL_SIZE);
     res.uniform_buffer_size = _sg_def(res.uniform_buffer_size, _SG_DEFAULT_UB_SIZE);
     res.staging_buffer_size = _sg_def(res.staging_buffer_size, _SG_DEFAULT_STAGING_SIZE);
     res.sampler_cache_size = _sg_def(res.sampler_cache_size, _SG_DEFAULT_SAMPLER_CACHE_CAPACITY);
     res.max_commit_listeners = _sg_def(res.max_commit_listeners, _SG_DEFAULT_MAX_COMMIT_LISTENERS);
+    res.init_queue_size = _sg_def(res.init_queue_size, _SG_DEFAULT_INIT_QUEUE_SIZE);
+    res.init_queue_budget_us = _sg_def(res.init_queue_budget_us, _SG_DEFAULT_INIT_QUEUE_BUDGET_US);
     return res;
 }
 
@@ -15603,8 +19154,10 @@ SOKOL_API_IMPL void sg_setup(const sg_desc* desc) {
     _sg.desc = _sg_desc_defaults(desc);
     _sg_setup_pools(&_sg.pools, &_sg.desc);
     _sg_setup_commit_listeners(&_sg.desc);
+    _sg_setup_init_queue(&_sg.desc);
     _sg.frame_index = 1;
     _sg_setup_backend(&_sg.desc);
+    _sg_setup_gpu_timer(&_sg.desc);
     _sg.valid = true;
     sg_setup_context();
 }
@@ -15623,6 +19176,7 @@ SOKOL_API_IMPL void sg_shutdown(void) {
     }
     _sg_discard_backend();
     _sg_discard_commit_listeners();
+    _sg_discard_init_queue();
     _sg_discard_pools(&_sg.pools);
     _SG_CLEAR_ARC_STRUCT(_sg_state_t, _sg);
 }
@@ -15658,12 +19212,66 @@ SOKOL_API_IMPL sg_pixelformat_info sg_query_pixelformat(sg_pixel_format fmt) {
     return _sg.formats[fmt_index];
 }
 
+SOKOL_API_IMPL sg_frame_stats sg_query_frame_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.stats.prev_frame;
+}
+
+SOKOL_API_IMPL sg_srgb_tables sg_query_srgb_tables(void) {
+    sg_srgb_tables res;
+    res.to_linear = _sg_srgb_to_linear12;
+    res.from_linear = _sg_srgb_from_linear12;
+    return res;
+}
+
+SOKOL_API_IMPL sg_gpu_timings sg_query_gpu_timings(void) {
+    SOKOL_ASSERT(_sg.valid);
+    return _sg.gpu_timer.results;
+}
+
+_SOKOL_PRIVATE sg_pool_info _sg_pool_info(_sg_pool_t* pool) {
+    sg_pool_info res;
+    _sg_clear(&res, sizeof(res));
+    _sg_spinlock_lock(&pool->lock);
+    res.size = pool->size - 1;
+    res.num_chunks = pool->num_chunks;
+    res.num_used = pool->num_used;
+    res.high_water_mark = pool->high_water_mark;
+    _sg_spinlock_unlock(&pool->lock);
+    return res;
+}
+
+SOKOL_API_IMPL sg_pools_info sg_query_pools_info(void) {
+    SOKOL_ASSERT(_sg.valid);
+    sg_pools_info res;
+    _sg_clear(&res, sizeof(res));
+    res.buffers = _sg_pool_info(&_sg.pools.buffer_pool);
+    res.images = _sg_pool_info(&_sg.pools.image_pool);
+    res.shaders = _sg_pool_info(&_sg.pools.shader_pool);
+    res.pipelines = _sg_pool_info(&_sg.pools.pipeline_pool);
+    res.passes = _sg_pool_info(&_sg.pools.pass_pool);
+    res.binding_sets = _sg_pool_info(&_sg.pools.binding_set_pool);
+    res.contexts = _sg_pool_info(&_sg.pools.context_pool);
+    return res;
+}
+
+SOKOL_API_IMPL sg_program_cache_stats sg_query_program_cache_stats(void) {
+    SOKOL_ASSERT(_sg.valid);
+    #if defined(_SOKOL_ANY_GL)
+    return _sg.gl.program_cache.stats;
+    #else
+    sg_program_cache_stats res;
+    _sg_clear(&res, sizeof(res));
+    return res;
+    #endif
+}
+
 SOKOL_API_IMPL sg_context sg_setup_context(void) {
     SOKOL_ASSERT(_sg.valid);
     sg_context res;
     int slot_index = _sg_pool_alloc_index(&_sg.pools.context_pool);
     if (_SG_INVALID_SLOT_INDEX != slot_index) {
-        res.id = _sg_slot_alloc(&_sg.pools.context_pool, &_sg.pools.contexts[slot_index].slot, slot_index);
+        res.id = _sg_slot_alloc(&_sg.pools.context_pool, slot_index);
         _sg_context_t* ctx = _sg_context_at(&_sg.pools, res.id);
         ctx->slot.state = _sg_create_context(ctx);
         SOKOL_ASSERT(ctx->slot.state == SG_RESOURCESTATE_VALID);
@@ -15857,7 +19465,7 @@ SOKOL_API_IMPL void sg_init_shader(sg_shader shd_id, const sg_shader_desc* desc)
     if (shd) {
         if (shd->slot.state == SG_RESOURCESTATE_ALLOC) {
             _sg_init_shader(shd, &desc_def);
-            SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED));
+            SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED) || (shd->slot.state == SG_RESOURCESTATE_PENDING));
         }
         else {
             _SG_ERROR(INIT_SHADER_INVALID_STATE);
@@ -15873,7 +19481,7 @@ SOKOL_API_IMPL void sg_init_pipeline(sg_pipeline pip_id, const sg_pipeline_desc*
     if (pip) {
         if (pip->slot.state == SG_RESOURCESTATE_ALLOC) {
             _sg_init_pipeline(pip, &desc_def);
-            SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED));
+            SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED) || (pip->slot.state == SG_RESOURCESTATE_PENDING));
         }
         else {
             _SG_ERROR(INIT_PIPELINE_INVALID_STATE);
@@ -15932,7 +19540,7 @@ SOKOL_API_IMPL void sg_uninit_shader(sg_shader shd_id) {
     SOKOL_ASSERT(_sg.valid);
     _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
     if (shd) {
-        if ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED)) {
+        if ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED) || (shd->slot.state == SG_RESOURCESTATE_PENDING)) {
             _sg_uninit_shader(shd);
             SOKOL_ASSERT(shd->slot.state == SG_RESOURCESTATE_ALLOC);
         }
@@ -15947,7 +19555,7 @@ SOKOL_API_IMPL void sg_uninit_pipeline(sg_pipeline pip_id) {
     SOKOL_ASSERT(_sg.valid);
     _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
     if (pip) {
-        if ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED)) {
+        if ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED) || (pip->slot.state == SG_RESOURCESTATE_PENDING)) {
             _sg_uninit_pipeline(pip);
             SOKOL_ASSERT(pip->slot.state == SG_RESOURCESTATE_ALLOC);
         }
@@ -16049,6 +19657,30 @@ SOKOL_API_IMPL void sg_fail_pass(sg_pass pass_id) {
     _SG_TRACE_ARGS(fail_pass, pass_id);
 }
 
+SOKOL_API_IMPL bool sg_queue_init_buffer(sg_buffer buf_id, const sg_buffer_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(buf_id.id != SG_INVALID_ID);
+    SOKOL_ASSERT(desc);
+    _sg_init_item_t item;
+    _sg_clear(&item, sizeof(item));
+    item.type = _SG_INITITEM_BUFFER;
+    item.id = buf_id.id;
+    item.desc.buf = *desc;
+    return _sg_push_init_item(&item);
+}
+
+SOKOL_API_IMPL bool sg_queue_init_image(sg_image img_id, const sg_image_desc* desc) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(img_id.id != SG_INVALID_ID);
+    SOKOL_ASSERT(desc);
+    _sg_init_item_t item;
+    _sg_clear(&item, sizeof(item));
+    item.type = _SG_INITITEM_IMAGE;
+    item.id = img_id.id;
+    item.desc.img = *desc;
+    return _sg_push_init_item(&item);
+}
+
 /*-- get resource state */
 SOKOL_API_IMPL sg_resource_state sg_query_buffer_state(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
@@ -16085,6 +19717,16 @@ SOKOL_API_IMPL sg_resource_state sg_query_pass_state(sg_pass pass_id) {
     return res;
 }
 
+SOKOL_API_IMPL sg_resource_state sg_query_binding_set_state(sg_binding_set bset_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_binding_set_t* bset = _sg_lookup_binding_set(&_sg.pools, bset_id.id);
+    sg_resource_state res = bset ? bset->slot.state : SG_RESOURCESTATE_INVALID;
+    if ((res == SG_RESOURCESTATE_VALID) && !_sg_binding_set_resources_valid(bset)) {
+        res = SG_RESOURCESTATE_FAILED;
+    }
+    return res;
+}
+
 /*-- allocate and initialize resource ----------------------------------------*/
 SOKOL_API_IMPL sg_buffer sg_make_buffer(const sg_buffer_desc* desc) {
     SOKOL_ASSERT(_sg.valid);
@@ -16125,7 +19767,7 @@ SOKOL_API_IMPL sg_shader sg_make_shader(const sg_shader_desc* desc) {
         _sg_shader_t* shd = _sg_shader_at(&_sg.pools, shd_id.id);
         SOKOL_ASSERT(shd && (shd->slot.state == SG_RESOURCESTATE_ALLOC));
         _sg_init_shader(shd, &desc_def);
-        SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED));
+        SOKOL_ASSERT((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED) || (shd->slot.state == SG_RESOURCESTATE_PENDING));
     }
     _SG_TRACE_ARGS(make_shader, &desc_def, shd_id);
     return shd_id;
@@ -16140,7 +19782,7 @@ SOKOL_API_IMPL sg_pipeline sg_make_pipeline(const sg_pipeline_desc* desc) {
         _sg_pipeline_t* pip = _sg_pipeline_at(&_sg.pools, pip_id.id);
         SOKOL_ASSERT(pip && (pip->slot.state == SG_RESOURCESTATE_ALLOC));
         _sg_init_pipeline(pip, &desc_def);
-        SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED));
+        SOKOL_ASSERT((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED) || (pip->slot.state == SG_RESOURCESTATE_PENDING));
     }
     _SG_TRACE_ARGS(make_pipeline, &desc_def, pip_id);
     return pip_id;
@@ -16161,6 +19803,20 @@ SOKOL_API_IMPL sg_pass sg_make_pass(const sg_pass_desc* desc) {
     return pass_id;
 }
 
+SOKOL_API_IMPL sg_binding_set sg_make_binding_set(const sg_bindings* bindings) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(bindings);
+    sg_binding_set bset_id = _sg_alloc_binding_set();
+    if (bset_id.id != SG_INVALID_ID) {
+        _sg_binding_set_t* bset = _sg_binding_set_at(&_sg.pools, bset_id.id);
+        SOKOL_ASSERT(bset && (bset->slot.state == SG_RESOURCESTATE_ALLOC));
+        _sg_init_binding_set(bset, bindings);
+        SOKOL_ASSERT((bset->slot.state == SG_RESOURCESTATE_VALID) || (bset->slot.state == SG_RESOURCESTATE_FAILED));
+    }
+    _SG_TRACE_ARGS(make_binding_set, bindings, bset_id);
+    return bset_id;
+}
+
 /*-- destroy resource --------------------------------------------------------*/
 SOKOL_API_IMPL void sg_destroy_buffer(sg_buffer buf_id) {
     SOKOL_ASSERT(_sg.valid);
@@ -16199,7 +19855,7 @@ SOKOL_API_IMPL void sg_destroy_shader(sg_shader shd_id) {
     _SG_TRACE_ARGS(destroy_shader, shd_id);
     _sg_shader_t* shd = _sg_lookup_shader(&_sg.pools, shd_id.id);
     if (shd) {
-        if ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED)) {
+        if ((shd->slot.state == SG_RESOURCESTATE_VALID) || (shd->slot.state == SG_RESOURCESTATE_FAILED) || (shd->slot.state == SG_RESOURCESTATE_PENDING)) {
             _sg_uninit_shader(shd);
             SOKOL_ASSERT(shd->slot.state == SG_RESOURCESTATE_ALLOC);
         }
@@ -16215,7 +19871,7 @@ SOKOL_API_IMPL void sg_destroy_pipeline(sg_pipeline pip_id) {
     _SG_TRACE_ARGS(destroy_pipeline, pip_id);
     _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
     if (pip) {
-        if ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED)) {
+        if ((pip->slot.state == SG_RESOURCESTATE_VALID) || (pip->slot.state == SG_RESOURCESTATE_FAILED) || (pip->slot.state == SG_RESOURCESTATE_PENDING)) {
             _sg_uninit_pipeline(pip);
             SOKOL_ASSERT(pip->slot.state == SG_RESOURCESTATE_ALLOC);
         }
@@ -16242,6 +19898,15 @@ SOKOL_API_IMPL void sg_destroy_pass(sg_pass pass_id) {
     }
 }
 
+SOKOL_API_IMPL void sg_destroy_binding_set(sg_binding_set bset_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _SG_TRACE_ARGS(destroy_binding_set, bset_id);
+    _sg_binding_set_t* bset = _sg_lookup_binding_set(&_sg.pools, bset_id.id);
+    if (bset) {
+        _sg_dealloc_binding_set(bset);
+    }
+}
+
 SOKOL_API_IMPL void sg_begin_default_pass(const sg_pass_action* pass_action, int width, int height) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(pass_action);
@@ -16250,7 +19915,9 @@ SOKOL_API_IMPL void sg_begin_default_pass(const sg_pass_action* pass_action, int
     _sg_resolve_default_pass_action(pass_action, &pa);
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.pass_valid = true;
+    _sg_gpu_timer_begin("default pass");
     _sg_begin_pass(0, &pa, width, height);
+    _sg_stats_add(num_passes, 1);
     _SG_TRACE_ARGS(begin_default_pass, &pa, width, height);
 }
 
@@ -16272,7 +19939,9 @@ SOKOL_API_IMPL void sg_begin_pass(sg_pass pass_id, const sg_pass_action* pass_ac
         SOKOL_ASSERT(img);
         const int w = img->cmn.width;
         const int h = img->cmn.height;
+        _sg_gpu_timer_begin("pass");
         _sg_begin_pass(pass, &pa, w, h);
+        _sg_stats_add(num_passes, 1);
         _SG_TRACE_ARGS(begin_pass, pass_id, &pa);
     }
     else {
@@ -16287,6 +19956,7 @@ SOKOL_API_IMPL void sg_apply_viewport(int x, int y, int width, int height, bool
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
+    _sg_merge_flush();
     _sg_apply_viewport(x, y, width, height, origin_top_left);
     _SG_TRACE_ARGS(apply_viewport, x, y, width, height, origin_top_left);
 }
@@ -16301,6 +19971,7 @@ SOKOL_API_IMPL void sg_apply_scissor_rect(int x, int y, int width, int height, b
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
+    _sg_merge_flush();
     _sg_apply_scissor_rect(x, y, width, height, origin_top_left);
     _SG_TRACE_ARGS(apply_scissor_rect, x, y, width, height, origin_top_left);
 }
@@ -16311,7 +19982,9 @@ SOKOL_API_IMPL void sg_apply_scissor_rectf(float x, float y, float width, float
 
 SOKOL_API_IMPL void sg_apply_pipeline(sg_pipeline pip_id) {
     SOKOL_ASSERT(_sg.valid);
+    _sg_merge_apply_pipeline(pip_id);
     _sg.bindings_valid = false;
+    _sg.pipeline_pending = false;
     if (!_sg_validate_apply_pipeline(pip_id)) {
         _sg.next_draw_valid = false;
         _SG_TRACE_NOARGS(err_draw_invalid);
@@ -16324,9 +19997,16 @@ SOKOL_API_IMPL void sg_apply_pipeline(sg_pipeline pip_id) {
     _sg.cur_pipeline = pip_id;
     _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
     SOKOL_ASSERT(pip);
+    if (pip->slot.state == SG_RESOURCESTATE_PENDING) {
+        /* not an error, bindings, uniforms and draws are skipped until the shader is ready */
+        _sg.pipeline_pending = true;
+        _sg.next_draw_valid = false;
+        return;
+    }
     _sg.next_draw_valid = (SG_RESOURCESTATE_VALID == pip->slot.state);
     SOKOL_ASSERT(pip->shader && (pip->shader->slot.id == pip->cmn.shader_id.id));
     _sg_apply_pipeline(pip);
+    _sg_stats_add(num_apply_pipeline, 1);
     _SG_TRACE_ARGS(apply_pipeline, pip_id);
 }
 
@@ -16334,7 +20014,13 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(bindings);
     SOKOL_ASSERT((bindings->_start_canary == 0) && (bindings->_end_canary==0));
-    if (!_sg_validate_apply_bindings(bindings)) {
+    sg_binding_set no_bset;
+    _sg_clear(&no_bset, sizeof(no_bset));
+    _sg_merge_apply_bindings(bindings, no_bset);
+    if (_sg.pipeline_pending) {
+        return;
+    }
+    if (!_sg_validate_apply_bindings(_sg.cur_pipeline.id, bindings)) {
         _sg.next_draw_valid = false;
         _SG_TRACE_NOARGS(err_draw_invalid);
         return;
@@ -16395,6 +20081,7 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
         const int* vb_offsets = bindings->vertex_buffer_offsets;
         int ib_offset = bindings->index_buffer_offset;
         _sg_apply_bindings(pip, vbs, vb_offsets, num_vbs, ib, ib_offset, vs_imgs, num_vs_imgs, fs_imgs, num_fs_imgs);
+        _sg_stats_add(num_apply_bindings, 1);
         _SG_TRACE_ARGS(apply_bindings, bindings);
     }
     else {
@@ -16402,12 +20089,57 @@ SOKOL_API_IMPL void sg_apply_bindings(const sg_bindings* bindings) {
     }
 }
 
+SOKOL_API_IMPL void sg_apply_binding_set(sg_binding_set bset_id) {
+    SOKOL_ASSERT(_sg.valid);
+    _sg_merge_apply_bindings(0, bset_id);
+    if (_sg.pipeline_pending) {
+        return;
+    }
+    if (!_sg_validate_apply_binding_set(bset_id)) {
+        _sg.next_draw_valid = false;
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    _sg.bindings_valid = true;
+    _sg_binding_set_t* bset = _sg_lookup_binding_set(&_sg.pools, bset_id.id);
+    _sg.next_draw_valid &= (0 != bset) && (SG_RESOURCESTATE_VALID == bset->slot.state) && _sg_binding_set_resources_valid(bset);
+    if (!_sg.next_draw_valid) {
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    // stream buffers may have overflowed since the binding set was created
+    for (int i = 0; i < bset->num_vbs; i++) {
+        _sg.next_draw_valid &= !bset->vbs[i]->cmn.append_overflow;
+    }
+    if (bset->ib) {
+        _sg.next_draw_valid &= !bset->ib->cmn.append_overflow;
+    }
+    if (_sg.next_draw_valid) {
+        _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, _sg.cur_pipeline.id);
+        SOKOL_ASSERT(pip);
+        _sg_apply_bindings(pip,
+            (_sg_buffer_t**)bset->vbs, bset->vb_offsets, bset->num_vbs,
+            bset->ib, bset->ib_offset,
+            (_sg_image_t**)bset->vs_imgs, bset->num_vs_imgs,
+            (_sg_image_t**)bset->fs_imgs, bset->num_fs_imgs);
+        _sg_stats_add(num_apply_bindings, 1);
+        _SG_TRACE_ARGS(apply_binding_set, bset_id);
+    }
+    else {
+        _SG_TRACE_NOARGS(err_draw_invalid);
+    }
+}
+
 SOKOL_API_IMPL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const sg_range* data) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT((stage == SG_SHADERSTAGE_VS) || (stage == SG_SHADERSTAGE_FS));
     SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
     SOKOL_ASSERT(data && data->ptr && (data->size > 0));
-    if (!_sg_validate_apply_uniforms(stage, ub_index, data)) {
+    _sg_merge_apply_uniforms(stage, ub_index, data);
+    if (_sg.pipeline_pending) {
+        return;
+    }
+    if (!_sg_validate_apply_uniforms(_sg.cur_pipeline.id, stage, ub_index, data)) {
         _sg.next_draw_valid = false;
         _SG_TRACE_NOARGS(err_draw_invalid);
         return;
@@ -16421,6 +20153,8 @@ SOKOL_API_IMPL void sg_apply_uniforms(sg_shader_stage stage, int ub_index, const
         return;
     }
     _sg_apply_uniforms(stage, ub_index, data);
+    _sg_stats_add(num_apply_uniforms, 1);
+    _sg_stats_add(size_apply_uniforms, (uint32_t)data->size);
     _SG_TRACE_ARGS(apply_uniforms, stage, ub_index, data);
 }
 
@@ -16429,6 +20163,10 @@ SOKOL_API_IMPL void sg_draw(int base_element, int num_elements, int num_instance
     SOKOL_ASSERT(base_element >= 0);
     SOKOL_ASSERT(num_elements >= 0);
     SOKOL_ASSERT(num_instances >= 0);
+    if (_sg.pipeline_pending) {
+        _sg_stats_add(num_draw_pending, 1);
+        return;
+    }
     #if defined(SOKOL_DEBUG)
         if (!_sg.bindings_valid) {
             _SG_WARN(DRAW_WITHOUT_BINDINGS);
@@ -16453,33 +20191,360 @@ SOKOL_API_IMPL void sg_draw(int base_element, int num_elements, int num_instance
         _SG_TRACE_NOARGS(err_draw_invalid);
         return;
     }
-    _sg_draw(base_element, num_elements, num_instances);
+    if (!_sg_merge_draw(base_element, num_elements, num_instances)) {
+        _sg_draw(base_element, num_elements, num_instances);
+    }
+    _sg_stats_add(num_draw, 1);
     _SG_TRACE_ARGS(draw, base_element, num_elements, num_instances);
 }
 
+SOKOL_API_IMPL void sg_draw_batch(const sg_draw_item* items, int num_items) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(items && (num_items >= 0));
+    if (_sg.pipeline_pending) {
+        _sg_stats_add(num_draw_pending, (uint32_t)num_items);
+        return;
+    }
+    #if defined(SOKOL_DEBUG)
+        if (!_sg.bindings_valid) {
+            _SG_WARN(DRAW_WITHOUT_BINDINGS);
+        }
+        for (int i = 0; i < num_items; i++) {
+            SOKOL_ASSERT(items[i].base_element >= 0);
+            SOKOL_ASSERT(items[i].num_elements >= 0);
+            SOKOL_ASSERT(items[i].num_instances >= 0);
+            SOKOL_ASSERT(_sg.features.draw_base_vertex || (0 == items[i].base_vertex));
+        }
+    #endif
+    if (!_sg.pass_valid) {
+        _SG_TRACE_NOARGS(err_pass_invalid);
+        return;
+    }
+    if (!_sg.next_draw_valid) {
+        _SG_TRACE_NOARGS(err_draw_invalid);
+        return;
+    }
+    if (!_sg.bindings_valid) {
+        _SG_TRACE_NOARGS(err_bindings_invalid);
+        return;
+    }
+    if (0 == num_items) {
+        return;
+    }
+    _sg_merge_flush();
+    _sg_draw_batch(items, num_items);
+    _sg_stats_add(num_draw, (uint32_t)num_items);
+    _sg_stats_add(num_draw_batch, 1);
+    _SG_TRACE_ARGS(draw_batch, items, num_items);
+}
+
+SOKOL_API_IMPL sg_command_list sg_begin_commands(const sg_range* memory) {
+    SOKOL_ASSERT(memory && memory->ptr && (memory->size > 0));
+    SOKOL_ASSERT(0 == ((uintptr_t)memory->ptr & 7));
+    sg_command_list cmds;
+    _sg_clear(&cmds, sizeof(cmds));
+    cmds.ptr = (uint8_t*) memory->ptr;
+    cmds.size = memory->size;
+    return cmds;
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_viewport(sg_command_list* cmds, int x, int y, int width, int height, bool origin_top_left) {
+    _sg_cmd_rect_t* cmd = (_sg_cmd_rect_t*) _sg_cmd_alloc(cmds, _SG_CMD_APPLY_VIEWPORT, sizeof(_sg_cmd_rect_t));
+    if (cmd) {
+        cmd->x = x;
+        cmd->y = y;
+        cmd->width = width;
+        cmd->height = height;
+        cmd->origin_top_left = origin_top_left;
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_scissor_rect(sg_command_list* cmds, int x, int y, int width, int height, bool origin_top_left) {
+    _sg_cmd_rect_t* cmd = (_sg_cmd_rect_t*) _sg_cmd_alloc(cmds, _SG_CMD_APPLY_SCISSOR_RECT, sizeof(_sg_cmd_rect_t));
+    if (cmd) {
+        cmd->x = x;
+        cmd->y = y;
+        cmd->width = width;
+        cmd->height = height;
+        cmd->origin_top_left = origin_top_left;
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_pipeline(sg_command_list* cmds, sg_pipeline pip_id) {
+    _sg_cmd_pipeline_t* cmd = (_sg_cmd_pipeline_t*) _sg_cmd_alloc(cmds, _SG_CMD_APPLY_PIPELINE, sizeof(_sg_cmd_pipeline_t));
+    if (cmd) {
+        cmd->pip = _sg_lookup_pipeline(&_sg.pools, pip_id.id);
+        cmd->pip_id = pip_id.id;
+        cmd->valid = _sg_validate_cmd_apply_pipeline(pip_id) && cmd->pip &&
+            ((cmd->pip->slot.state == SG_RESOURCESTATE_VALID) || (cmd->pip->slot.state == SG_RESOURCESTATE_PENDING));
+        cmds->pipeline_id = pip_id.id;
+    }
+}
+
+/* bindings and uniforms are validated against the last recorded pipeline, unless it is still pending */
+_SOKOL_PRIVATE bool _sg_cmd_pipeline_pending(const sg_command_list* cmds) {
+    const _sg_pipeline_t* pip = _sg_lookup_pipeline(&_sg.pools, cmds->pipeline_id);
+    return pip && (pip->slot.state == SG_RESOURCESTATE_PENDING);
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_bindings(sg_command_list* cmds, const sg_bindings* bindings) {
+    SOKOL_ASSERT(bindings);
+    SOKOL_ASSERT((bindings->_start_canary == 0) && (bindings->_end_canary==0));
+    _sg_cmd_bindings_t* cmd = (_sg_cmd_bindings_t*) _sg_cmd_alloc(cmds, _SG_CMD_APPLY_BINDINGS, sizeof(_sg_cmd_bindings_t));
+    if (!cmd) {
+        return;
+    }
+    _sg_clear(cmd, sizeof(_sg_cmd_bindings_t));
+    cmd->bindings = *bindings;
+    cmd->valid = (SG_INVALID_ID != cmds->pipeline_id);
+    cmd->checked = !_sg_cmd_pipeline_pending(cmds);
+    if (cmd->checked) {
+        cmd->valid &= _sg_validate_apply_bindings(cmds->pipeline_id, bindings);
+    }
+    for (int i = 0; (i < SG_MAX_SHADERSTAGE_BUFFERS) && bindings->vertex_buffers[i].id; i++) {
+        cmd->vbs[i] = _sg_lookup_buffer(&_sg.pools, bindings->vertex_buffers[i].id);
+        cmd->vb_offsets[i] = bindings->vertex_buffer_offsets[i];
+        cmd->valid &= (0 != cmd->vbs[i]);
+        cmd->num_vbs++;
+    }
+    if (bindings->index_buffer.id) {
+        cmd->ib = _sg_lookup_buffer(&_sg.pools, bindings->index_buffer.id);
+        cmd->ib_offset = bindings->index_buffer_offset;
+        cmd->valid &= (0 != cmd->ib);
+    }
+    for (int i = 0; (i < SG_MAX_SHADERSTAGE_IMAGES) && bindings->vs_images[i].id; i++) {
+        cmd->vs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->vs_images[i].id);
+        cmd->valid &= (0 != cmd->vs_imgs[i]);
+        cmd->num_vs_imgs++;
+    }
+    for (int i = 0; (i < SG_MAX_SHADERSTAGE_IMAGES) && bindings->fs_images[i].id; i++) {
+        cmd->fs_imgs[i] = _sg_lookup_image(&_sg.pools, bindings->fs_images[i].id);
+        cmd->valid &= (0 != cmd->fs_imgs[i]);
+        cmd->num_fs_imgs++;
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_apply_uniforms(sg_command_list* cmds, sg_shader_stage stage, int ub_index, const sg_range* data) {
+    SOKOL_ASSERT((stage == SG_SHADERSTAGE_VS) || (stage == SG_SHADERSTAGE_FS));
+    SOKOL_ASSERT((ub_index >= 0) && (ub_index < SG_MAX_SHADERSTAGE_UBS));
+    SOKOL_ASSERT(data && data->ptr && (data->size > 0));
+    _sg_cmd_uniforms_t* cmd = (_sg_cmd_uniforms_t*) _sg_cmd_alloc(cmds, _SG_CMD_APPLY_UNIFORMS, sizeof(_sg_cmd_uniforms_t) + data->size);
+    if (cmd) {
+        cmd->stage = stage;
+        cmd->ub_index = ub_index;
+        cmd->size = data->size;
+        cmd->valid = (SG_INVALID_ID != cmds->pipeline_id);
+        cmd->checked = !_sg_cmd_pipeline_pending(cmds);
+        if (cmd->checked) {
+            cmd->valid &= _sg_validate_apply_uniforms(cmds->pipeline_id, stage, ub_index, data);
+        }
+        memcpy(cmd + 1, data->ptr, data->size);
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_draw(sg_command_list* cmds, int base_element, int num_elements, int num_instances) {
+    SOKOL_ASSERT(base_element >= 0);
+    SOKOL_ASSERT(num_elements >= 0);
+    SOKOL_ASSERT(num_instances >= 0);
+    _sg_cmd_draw_t* cmd = (_sg_cmd_draw_t*) _sg_cmd_alloc(cmds, _SG_CMD_DRAW, sizeof(_sg_cmd_draw_t));
+    if (cmd) {
+        cmd->base_element = base_element;
+        cmd->num_elements = num_elements;
+        cmd->num_instances = num_instances;
+    }
+}
+
+SOKOL_API_IMPL void sg_cmd_draw_batch(sg_command_list* cmds, const sg_draw_item* items, int num_items) {
+    SOKOL_ASSERT(items && (num_items >= 0));
+    #if defined(SOKOL_DEBUG)
+        for (int i = 0; i < num_items; i++) {
+            SOKOL_ASSERT(items[i].base_element >= 0);
+            SOKOL_ASSERT(items[i].num_elements >= 0);
+            SOKOL_ASSERT(items[i].num_instances >= 0);
+            SOKOL_ASSERT(_sg.features.draw_base_vertex || (0 == items[i].base_vertex));
+        }
+    #endif
+    const size_t items_size = (size_t)num_items * sizeof(sg_draw_item);
+    _sg_cmd_draw_batch_t* cmd = (_sg_cmd_draw_batch_t*) _sg_cmd_alloc(cmds, _SG_CMD_DRAW_BATCH, sizeof(_sg_cmd_draw_batch_t) + items_size);
+    if (cmd) {
+        cmd->num_items = num_items;
+        memcpy(cmd + 1, items, items_size);
+    }
+}
+
+SOKOL_API_IMPL void sg_submit_commands(const sg_command_list* cmds) {
+    SOKOL_ASSERT(_sg.valid);
+    SOKOL_ASSERT(cmds && (cmds->pos <= cmds->size));
+    if (cmds->overflow) {
+        _SG_ERROR(COMMAND_LIST_OVERFLOW);
+        return;
+    }
+    if (!_sg.pass_valid) {
+        _SG_TRACE_NOARGS(err_pass_invalid);
+        return;
+    }
+    /* replayed draws aren't merged, and the merge state no longer matches the backend afterwards */
+    _sg_merge_flush();
+    _sg_pipeline_t* pip = 0;
+    size_t pos = 0;
+    while (pos < cmds->pos) {
+        const _sg_cmd_header_t* hdr = (const _sg_cmd_header_t*)(cmds->ptr + pos);
+        const void* payload = hdr + 1;
+        SOKOL_ASSERT((hdr->size >= sizeof(_sg_cmd_header_t)) && ((pos + hdr->size) <= cmds->pos));
+        switch (hdr->type) {
+            case _SG_CMD_APPLY_VIEWPORT: {
+                const _sg_cmd_rect_t* cmd = (const _sg_cmd_rect_t*) payload;
+                _sg_apply_viewport(cmd->x, cmd->y, cmd->width, cmd->height, cmd->origin_top_left);
+            } break;
+            case _SG_CMD_APPLY_SCISSOR_RECT: {
+                const _sg_cmd_rect_t* cmd = (const _sg_cmd_rect_t*) payload;
+                _sg_apply_scissor_rect(cmd->x, cmd->y, cmd->width, cmd->height, cmd->origin_top_left);
+            } break;
+            case _SG_CMD_APPLY_PIPELINE: {
+                const _sg_cmd_pipeline_t* cmd = (const _sg_cmd_pipeline_t*) payload;
+                _sg.bindings_valid = false;
+                _sg.pipeline_pending = false;
+                _sg.next_draw_valid = false;
+                pip = 0;
+                if (!(cmd->valid && _sg_validate_submit_pipeline(cmd->pip_id, cmd->pip))) {
+                    break;
+                }
+                if (cmd->pip->slot.id != cmd->pip_id) {
+                    /* destroyed since recording */
+                    break;
+                }
+                _sg.cur_pipeline.id = cmd->pip_id;
+                if (cmd->pip->slot.state == SG_RESOURCESTATE_PENDING) {
+                    _sg.pipeline_pending = true;
+                    break;
+                }
+                if (cmd->pip->slot.state == SG_RESOURCESTATE_VALID) {
+                    pip = cmd->pip;
+                    _sg.next_draw_valid = true;
+                    _sg_apply_pipeline(pip);
+                    _sg_stats_add(num_apply_pipeline, 1);
+                }
+            } break;
+            case _SG_CMD_APPLY_BINDINGS: {
+                const _sg_cmd_bindings_t* cmd = (const _sg_cmd_bindings_t*) payload;
+                if (_sg.pipeline_pending) {
+                    break;
+                }
+                bool valid = cmd->valid && (0 != pip);
+                if (valid && !cmd->checked) {
+                    valid = _sg_validate_apply_bindings(_sg.cur_pipeline.id, &cmd->bindings);
+                }
+                if (!valid) {
+                    _sg.next_draw_valid = false;
+                    break;
+                }
+                _sg.bindings_valid = true;
+                for (int i = 0; i < cmd->num_vbs; i++) {
+                    _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == cmd->vbs[i]->slot.state);
+                    _sg.next_draw_valid &= !cmd->vbs[i]->cmn.append_overflow;
+                }
+                if (cmd->ib) {
+                    _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == cmd->ib->slot.state);
+                    _sg.next_draw_valid &= !cmd->ib->cmn.append_overflow;
+                }
+                for (int i = 0; i < cmd->num_vs_imgs; i++) {
+                    _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == cmd->vs_imgs[i]->slot.state);
+                }
+                for (int i = 0; i < cmd->num_fs_imgs; i++) {
+                    _sg.next_draw_valid &= (SG_RESOURCESTATE_VALID == cmd->fs_imgs[i]->slot.state);
+                }
+                if (_sg.next_draw_valid) {
+                    _sg_apply_bindings(pip,
+                        (_sg_buffer_t**)cmd->vbs, cmd->vb_offsets, cmd->num_vbs,
+                        cmd->ib, cmd->ib_offset,
+                        (_sg_image_t**)cmd->vs_imgs, cmd->num_vs_imgs,
+                        (_sg_image_t**)cmd->fs_imgs, cmd->num_fs_imgs);
+                    _sg_stats_add(num_apply_bindings, 1);
+                }
+            } break;
+            case _SG_CMD_APPLY_UNIFORMS: {
+                const _sg_cmd_uniforms_t* cmd = (const _sg_cmd_uniforms_t*) payload;
+                if (_sg.pipeline_pending) {
+                    break;
+                }
+                const sg_range data = { cmd + 1, cmd->size };
+                bool valid = cmd->valid && (0 != pip);
+                if (valid && !cmd->checked) {
+                    valid = _sg_validate_apply_uniforms(_sg.cur_pipeline.id, cmd->stage, cmd->ub_index, &data);
+                }
+                if (!valid) {
+                    _sg.next_draw_valid = false;
+                    break;
+                }
+                if (_sg.next_draw_valid) {
+                    _sg_apply_uniforms(cmd->stage, cmd->ub_index, &data);
+                    _sg_stats_add(num_apply_uniforms, 1);
+                    _sg_stats_add(size_apply_uniforms, (uint32_t)cmd->size);
+                }
+            } break;
+            case _SG_CMD_DRAW: {
+                const _sg_cmd_draw_t* cmd = (const _sg_cmd_draw_t*) payload;
+                if (_sg.pipeline_pending) {
+                    _sg_stats_add(num_draw_pending, 1);
+                    break;
+                }
+                if (_sg.next_draw_valid && _sg.bindings_valid && (cmd->num_elements > 0) && (cmd->num_instances > 0)) {
+                    _sg_draw(cmd->base_element, cmd->num_elements, cmd->num_instances);
+                    _sg_stats_add(num_draw, 1);
+                }
+            } break;
+            case _SG_CMD_DRAW_BATCH: {
+                const _sg_cmd_draw_batch_t* cmd = (const _sg_cmd_draw_batch_t*) payload;
+                if (_sg.pipeline_pending) {
+                    _sg_stats_add(num_draw_pending, (uint32_t)cmd->num_items);
+                    break;
+                }
+                if (_sg.next_draw_valid && _sg.bindings_valid && (cmd->num_items > 0)) {
+                    _sg_draw_batch((const sg_draw_item*)(cmd + 1), cmd->num_items);
+                    _sg_stats_add(num_draw, (uint32_t)cmd->num_items);
+                    _sg_stats_add(num_draw_batch, 1);
+                }
+            } break;
+            default:
+                SOKOL_UNREACHABLE;
+                break;
+        }
+        pos += hdr->size;
+    }
+    _sg_merge_invalidate();
+}
+
 SOKOL_API_IMPL void sg_end_pass(void) {
     SOKOL_ASSERT(_sg.valid);
     if (!_sg.pass_valid) {
         _SG_TRACE_NOARGS(err_pass_invalid);
         return;
     }
+    _sg_merge_flush();
     _sg_end_pass();
+    _sg_gpu_timer_end();
     _sg.cur_pass.id = SG_INVALID_ID;
     _sg.cur_pipeline.id = SG_INVALID_ID;
+    _sg.pipeline_pending = false;
     _sg.pass_valid = false;
     _SG_TRACE_NOARGS(end_pass);
 }
 
 SOKOL_API_IMPL void sg_commit(void) {
     SOKOL_ASSERT(_sg.valid);
+    _sg_gpu_timer_commit();
     _sg_commit();
+    _sg_process_init_queue();
+    _sg_process_pending_resources();
     _sg_notify_commit_listeners();
     _SG_TRACE_NOARGS(commit);
+    _sg_update_frame_stats();
     _sg.frame_index++;
 }
 
 SOKOL_API_IMPL void sg_reset_state_cache(void) {
     SOKOL_ASSERT(_sg.valid);
+    _sg_merge_flush();
     _sg_reset_state_cache();
     _SG_TRACE_NOARGS(reset_state_cache);
 }
@@ -16495,8 +20560,11 @@ SOKOL_API_IMPL void sg_update_buffer(sg_buffer buf_id, const sg_range* data) {
             SOKOL_ASSERT(buf->cmn.update_frame_index != _sg.frame_index);
             /* update and append on same buffer in same frame not allowed */
             SOKOL_ASSERT(buf->cmn.append_frame_index != _sg.frame_index);
+            _sg_merge_flush();
             _sg_update_buffer(buf, data);
             buf->cmn.update_frame_index = _sg.frame_index;
+            _sg_stats_add(num_update_buffer, 1);
+            _sg_stats_add(size_update_buffer, (uint32_t)data->size);
         }
     }
     _SG_TRACE_ARGS(update_buffer, buf_id, data);
@@ -16522,9 +20590,12 @@ SOKOL_API_IMPL int sg_append_buffer(sg_buffer buf_id, const sg_range* data) {
                 if (!buf->cmn.append_overflow && (data->size > 0)) {
                     /* update and append on same buffer in same frame not allowed */
                     SOKOL_ASSERT(buf->cmn.update_frame_index != _sg.frame_index);
+                    _sg_merge_flush();
                     int copied_num_bytes = _sg_append_buffer(buf, data, buf->cmn.append_frame_index != _sg.frame_index);
                     buf->cmn.append_pos += copied_num_bytes;
                     buf->cmn.append_frame_index = _sg.frame_index;
+                    _sg_stats_add(num_append_buffer, 1);
+                    _sg_stats_add(size_append_buffer, (uint32_t)data->size);
                 }
             }
         }
@@ -16568,8 +20639,13 @@ SOKOL_API_IMPL void sg_update_image(sg_image img_id, const sg_image_data* data)
     if (img && img->slot.state == SG_RESOURCESTATE_VALID) {
         if (_sg_validate_update_image(img, data)) {
             SOKOL_ASSERT(img->cmn.upd_frame_index != _sg.frame_index);
+            _sg_merge_flush();
+            const uint64_t start_us = _sg_time_us();
             _sg_update_image(img, data);
             img->cmn.upd_frame_index = _sg.frame_index;
+            _sg_stats_add(num_update_image, 1);
+            _sg_stats_add(size_update_image, _sg_image_data_size(img, data));
+            _sg_stats_add(time_update_image_us, (uint32_t)(_sg_time_us() - start_us));
         }
     }
     _SG_TRACE_ARGS(update_image, img_id, data);
@@ -16578,12 +20654,13 @@ SOKOL_API_IMPL void sg_update_image(sg_image img_id, const sg_image_data* data)
 SOKOL_API_IMPL void sg_push_debug_group(const char* name) {
     SOKOL_ASSERT(_sg.valid);
     SOKOL_ASSERT(name);
-    _SOKOL_UNUSED(name);
+    _sg_gpu_timer_begin(name);
     _SG_TRACE_ARGS(push_debug_group, name);
 }
 
 SOKOL_API_IMPL void sg_pop_debug_group(void) {
     SOKOL_ASSERT(_sg.valid);
+    _sg_gpu_timer_end();
     _SG_TRACE_NOARGS(pop_debug_group);
 }
 
@@ -1,4 +1,6 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
 
 #include <SDL2/SDL.h>
@@ -15,9 +17,72 @@
 #define SOKOL_GLCORE33
 #include "sokol_gfx.h"
 
+#define SPRITE_BATCH_IMPL
+#include "sprite_batch.h"
+
+#define ATLAS_IMPL
+#include "atlas.h"
+
+#define TEXTURE_COMPRESS_IMPL
+#include "texture_compress.h"
+
+#define TEXTURE_STREAM_IMPL
+#include "texture_stream.h"
+
+#define SOKOL_RENDER_QUEUE_IMPL
+#include "sokol_render_queue.h"
+
 // Sokol Gfx resources
-sg_pipeline pip;
-sg_bindings bind = { 0 };
+sprite_batch_t batch;
+atlas_t atlas;
+texture_stream_t stream;
+sg_image img;
+int image_w, image_h;
+int boomer_id;
+
+// Generated bitmaps packed next to boomer.png in benchmark mode
+#define NUM_ICONS (256)
+int icon_ids[NUM_ICONS];
+
+// Benchmark mode (--bench [num_sprites] or --instanced [num_quads])
+bool bench = false;
+bool instanced = false;
+int bench_sprite_count = 0;
+
+// Mipmap benchmark mode (--mipmap-bench), prints timings and exits
+bool mipmap_bench = false;
+
+// Render queue benchmark mode (--queue-bench), prints timings and frame stats and exits
+bool queue_bench = false;
+
+typedef struct
+{
+    float x, y;
+    float vx, vy;
+    int id;                 // atlas entry
+} bench_sprite_t;
+
+bench_sprite_t* bench_sprites = NULL;
+
+// Instanced quads, one vertex buffer with the 4 corners of a unit quad and
+// one per-instance vertex buffer, 28 bytes per quad
+#define INSTANCES_PER_DRAW (262144)
+
+typedef struct
+{
+    float rect[4];          // x, y, w, h in pixels
+    uint16_t uv[4];         // u0, v0, u1, v1 as normalized ushort
+    uint32_t color;
+} instance_t;
+
+typedef struct
+{
+    float mvp[16];
+} vs_instanced_params_t;
+
+sg_pipeline inst_pip;
+sg_bindings inst_bind = { 0 };
+instance_t* instances = NULL;
 
 // Window and rendering parameters
 const int window_width = 800;
@@ -62,7 +127,8 @@ bool init_sdl()
         return false;
     }
 
-    SDL_GL_SetSwapInterval(1);
+    // benchmark mode measures throughput, don't wait for vsync
+    SDL_GL_SetSwapInterval(bench ? 0 : 1);
 
     return true;
 }
@@ -76,42 +142,543 @@ SOKOL_SHDC_ALIGN(16) typedef struct {
 } vs_params_t;
 #pragma pack(pop)
 
-void frame(void)
+// Builds the mipmap chain of a 4K texture on the CPU and on the GPU, best of a few runs
+void bench_mipmaps(void)
+{
+    const int size = 4096;
+    uint32_t* pixels = malloc(sizeof(uint32_t) * size * size);
+
+    if (!pixels)
+    {
+        printf("Failed to allocate the %dx%d mipmap benchmark image\n", size, size);
+        return;
+    }
+
+    for (int i = 0; i < size * size; i++)
+        pixels[i] = 0xFF000000 | ((uint32_t)rand() & 0x00FFFFFF);
+
+    const sg_pixel_format formats[2] = { SG_PIXELFORMAT_RGBA8, SG_PIXELFORMAT_SRGB8A8 };
+    const sg_mipmap_gen modes[3] = { SG_MIPMAPGEN_NONE, SG_MIPMAPGEN_CPU, SG_MIPMAPGEN_GPU };
+    const char* mode_names[3] = { "top level only", "cpu mipmaps", "gpu mipmaps" };
+
+    for (int f = 0; f < 2; f++)
+    {
+        for (int m = 0; m < 3; m++)
+        {
+            double best_ms = 1e9;
+
+            for (int run = 0; run < 5; run++)
+            {
+                glFinish();
+                const Uint64 start = SDL_GetPerformanceCounter();
+
+                sg_image image = sg_make_image(&(sg_image_desc){
+                    .width = size,
+                    .height = size,
+                    .pixel_format = formats[f],
+                    .generate_mipmaps = modes[m],
+                    .data.subimage[0][0] = { .ptr = pixels, .size = sizeof(uint32_t) * size * size }
+                });
+
+                glFinish();
+                const double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+                if (ms < best_ms)
+                    best_ms = ms;
+
+                sg_destroy_image(image);
+            }
+
+            printf("%dx%d %s, %s: %.1f ms\n", size, size, f == 0 ? "RGBA8" : "SRGB8A8", mode_names[m], best_ms);
+        }
+    }
+
+    free(pixels);
+}
+
+// Issues the same quads with 4 pipelines and 16 textures in random order, once as they
+// come and once sorted by sokol_render_queue.h, best of a few frames
+#define QUEUE_QUADS (4096)
+#define QUEUE_PIPELINES (4)
+#define QUEUE_TEXTURES (16)
+
+typedef struct
+{
+    int pipeline;
+    int texture;
+    float scale;
+    float depth;
+} queue_quad_t;
+
+void print_queue_stats(const char* name, double best_ms)
+{
+    const sg_frame_stats stats = sg_query_frame_stats();
+
+    printf("%s: %.2f ms/frame, %u draws, %u apply_pipeline, %u apply_bindings, %u glUseProgram, %u glBindTexture\n",
+           name, best_ms, stats.num_draw, stats.num_apply_pipeline, stats.num_apply_bindings,
+           stats.gl.num_use_program, stats.gl.num_bind_texture);
+}
+
+void bench_queue(sg_shader shader)
 {
-    vs_params_t vs_params = {
-        .mvp = { 1, 0, 0, 0,
-                 0, 1, 0, 0,
-                 0, 0, 1, 0,
-                 0, 0, 0, 1 },
+    typedef struct
+    {
+        float x, y;
+        uint32_t color;
+        float u, v;
+    } queue_vertex_t;
+
+    const queue_vertex_t vertices[4] = {
+        { -0.1f, -0.1f, 0xFFFFFFFF, 0.0f, 0.0f },
+        {  0.1f, -0.1f, 0xFFFFFFFF, 1.0f, 0.0f },
+        {  0.1f,  0.1f, 0xFFFFFFFF, 1.0f, 1.0f },
+        { -0.1f,  0.1f, 0xFFFFFFFF, 0.0f, 1.0f }
+    };
+    const uint16_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+    sg_bindings bind = {
+        .vertex_buffers[0] = sg_make_buffer(&(sg_buffer_desc){ .data = SG_RANGE(vertices), .label = "queue quad" }),
+        .index_buffer = sg_make_buffer(&(sg_buffer_desc){ .type = SG_BUFFERTYPE_INDEXBUFFER, .data = SG_RANGE(indices), .label = "queue indices" })
+    };
+
+    // the same quad with different blend states, each a distinct pipeline
+    const sg_blend_state blends[QUEUE_PIPELINES] = {
+        { .enabled = false },
+        { .enabled = true, .src_factor_rgb = SG_BLENDFACTOR_SRC_ALPHA, .dst_factor_rgb = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA },
+        { .enabled = true, .src_factor_rgb = SG_BLENDFACTOR_ONE, .dst_factor_rgb = SG_BLENDFACTOR_ONE },
+        { .enabled = true, .src_factor_rgb = SG_BLENDFACTOR_DST_COLOR, .dst_factor_rgb = SG_BLENDFACTOR_ZERO }
+    };
+    sg_pipeline pipelines[QUEUE_PIPELINES];
+
+    for (int i = 0; i < QUEUE_PIPELINES; i++)
+    {
+        pipelines[i] = sg_make_pipeline(&(sg_pipeline_desc){
+            .layout.attrs = {
+                [0] = { .format = SG_VERTEXFORMAT_FLOAT2 },
+                [1] = { .format = SG_VERTEXFORMAT_UBYTE4N },
+                [2] = { .format = SG_VERTEXFORMAT_FLOAT2 }
+            },
+            .shader = shader,
+            .index_type = SG_INDEXTYPE_UINT16,
+            .colors[0].blend = blends[i],
+            .label = "queue pipeline"
+        });
+    }
+
+    sg_image textures[QUEUE_TEXTURES];
+
+    for (int i = 0; i < QUEUE_TEXTURES; i++)
+    {
+        uint32_t pixels[4 * 4];
+
+        for (int p = 0; p < 4 * 4; p++)
+            pixels[p] = 0xFF000000 | ((uint32_t)rand() & 0x00FFFFFF);
+
+        textures[i] = sg_make_image(&(sg_image_desc){
+            .width = 4,
+            .height = 4,
+            .data.subimage[0][0] = SG_RANGE(pixels),
+            .label = "queue texture"
+        });
+    }
+
+    queue_quad_t* quads = malloc(sizeof(queue_quad_t) * QUEUE_QUADS);
+
+    if (!quads)
+    {
+        printf("Failed to allocate the queue benchmark quads\n");
+        return;
+    }
+
+    for (int i = 0; i < QUEUE_QUADS; i++)
+    {
+        quads[i] = (queue_quad_t){
+            .pipeline = rand() % QUEUE_PIPELINES,
+            .texture = rand() % QUEUE_TEXTURES,
+            .scale = 1.0f + (float)(rand() % 8),
+            .depth = (float)rand() / (float)RAND_MAX
+        };
+    }
+
+    srq_setup(&(srq_desc){
+        .max_draws = QUEUE_QUADS,
+        .uniform_buffer_size = QUEUE_QUADS * (int)sizeof(vs_params_t),
+        .logger.func = slog_func
+    });
+    srq_set_pass(0, &(srq_pass_desc){
+        .action.colors[0] = { .load_action = SG_LOADACTION_CLEAR },
+        .width = window_width,
+        .height = window_height
+    });
+
+    for (int sorted = 0; sorted < 2; sorted++)
+    {
+        double best_ms = 1e9;
+
+        for (int run = 0; run < 20; run++)
+        {
+            glFinish();
+            const Uint64 start = SDL_GetPerformanceCounter();
+
+            if (!sorted)
+                sg_begin_default_pass(&(sg_pass_action){ .colors[0] = { .load_action = SG_LOADACTION_CLEAR } }, window_width, window_height);
+
+            for (int i = 0; i < QUEUE_QUADS; i++)
+            {
+                const queue_quad_t* q = &quads[i];
+                // the quad shader scales the clip space position component-wise
+                const vs_params_t params = {
+                    .mvp = { 1.0f, 0.0f, 0.0f, 0.0f,  0.0f, 1.0f, 0.0f, 0.0f,  0.0f, 0.0f, 1.0f, 0.0f,  0.0f, 0.0f, 0.0f, 1.0f },
+                    .scale = { q->scale, q->scale, 1.0f, 1.0f }
+                };
+                bind.fs_images[0] = textures[q->texture];
+
+                if (sorted)
+                {
+                    const srq_draw draw = {
+                        .pipeline = pipelines[q->pipeline],
+                        .bindings = bind,
+                        .vs_uniforms[0] = SG_RANGE(params),
+                        .num_elements = 6
+                    };
+                    srq_submit(srq_make_key(0, &draw, q->depth), &draw);
+                }
+                else
+                {
+                    sg_apply_pipeline(pipelines[q->pipeline]);
+                    sg_apply_bindings(&bind);
+                    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(params));
+                    sg_draw(0, 6, 1);
+                }
+            }
+
+            if (sorted)
+                srq_flush();
+            else
+                sg_end_pass();
+
+            sg_commit();
+            glFinish();
+
+            const double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+            if (ms < best_ms)
+                best_ms = ms;
+        }
+
+        print_queue_stats(sorted ? "render queue" : "unsorted", best_ms);
+    }
+
+    srq_shutdown();
+    free(quads);
+}
+
+// Small opaque squares with a dark border, each in its own color
+void add_icons(void)
+{
+    uint32_t pixels[40 * 40];
+
+    for (int i = 0; i < NUM_ICONS; i++)
+    {
+        const int w = 8 + rand() % 33;
+        const int h = 8 + rand() % 33;
+        const uint32_t color = 0xFF000000 | ((uint32_t)rand() & 0x00FFFFFF);
+
+        for (int y = 0; y < h; y++)
+        {
+            for (int x = 0; x < w; x++)
+            {
+                const bool border = (x == 0) || (y == 0) || (x == w - 1) || (y == h - 1);
+                pixels[y * w + x] = border ? 0xFF202020 : color;
+            }
+        }
+
+        icon_ids[i] = atlas_add(&atlas, pixels, w, h);
+    }
+}
+
+void init_bench(void)
+{
+    bench_sprites = malloc(sizeof(bench_sprite_t) * bench_sprite_count);
+
+    for (int i = 0; i < bench_sprite_count; i++)
+    {
+        bench_sprites[i].x  = (float)(rand() % window_width);
+        bench_sprites[i].y  = (float)(rand() % window_height);
+        bench_sprites[i].vx = (float)(rand() % 200 - 100) / 100.0f;
+        bench_sprites[i].vy = (float)(rand() % 200 - 100) / 100.0f;
+        bench_sprites[i].id = (i % (NUM_ICONS + 1) == 0) ? boomer_id : icon_ids[i % (NUM_ICONS + 1) - 1];
+    }
+}
+
+void update_bench(void)
+{
+    for (int i = 0; i < bench_sprite_count; i++)
+    {
+        bench_sprite_t* s = &bench_sprites[i];
+
+        s->x += s->vx;
+        s->y += s->vy;
+
+        if ((s->x < 0.0f) || (s->x > (float)window_width))
+            s->vx = -s->vx;
+
+        if ((s->y < 0.0f) || (s->y > (float)window_height))
+            s->vy = -s->vy;
+    }
+}
 
-        .scale = {2, 2, 1, 1}
+void init_instanced(sg_shader_desc shader_desc)
+{
+    // same fragment shader as the quad shader, per-instance rect, uv rect and color
+    shader_desc.vs.uniform_blocks[0] = (sg_shader_uniform_block_desc){
+        .size = sizeof(vs_instanced_params_t),
+        .layout = SG_UNIFORMLAYOUT_STD140,
+        .name = "vs_instanced_params"
     };
 
+    shader_desc.vs.source =
+        "#version 330\n"
+        "layout(std140) uniform vs_instanced_params {\n"
+        "  mat4 mvp;\n"
+        "};\n"
+        "layout(location = 0) in vec2 a_corner;\n"
+        "layout(location = 1) in vec4 i_rect;\n"
+        "layout(location = 2) in vec4 i_uv;\n"
+        "layout(location = 3) in vec4 i_col;\n"
+        "out vec4 col;\n"
+        "out vec2 uv;\n"
+        "void main() {\n"
+        "  gl_Position = mvp * vec4(i_rect.xy + a_corner * i_rect.zw, 0.0, 1.0);\n"
+        "  col = i_col;\n"
+        "  uv = mix(i_uv.xy, i_uv.zw, a_corner);\n"
+        "}\n";
+
+    const float corners[] = { 0.0f, 0.0f,  1.0f, 0.0f,  0.0f, 1.0f,  1.0f, 1.0f };
+
+    inst_bind.vertex_buffers[0] = sg_make_buffer(&(sg_buffer_desc){
+        .data  = SG_RANGE(corners),
+        .label = "quad corners"
+    });
+
+    inst_bind.vertex_buffers[1] = sg_make_buffer(&(sg_buffer_desc){
+        .size  = sizeof(instance_t) * bench_sprite_count,
+        .usage = SG_USAGE_STREAM,
+        .label = "quad instances"
+    });
+
+    inst_bind.fs_images[0] = img;
+
+    inst_pip = sg_make_pipeline(&(sg_pipeline_desc){
+        .layout = {
+            .buffers[1] = { .step_func = SG_VERTEXSTEP_PER_INSTANCE },
+            .attrs = {
+                [0] = { .format = SG_VERTEXFORMAT_FLOAT2,   .buffer_index = 0 },
+                [1] = { .format = SG_VERTEXFORMAT_FLOAT4,   .buffer_index = 1, .offset = offsetof(instance_t, rect) },
+                [2] = { .format = SG_VERTEXFORMAT_USHORT4N, .buffer_index = 1, .offset = offsetof(instance_t, uv) },
+                [3] = { .format = SG_VERTEXFORMAT_UBYTE4N,  .buffer_index = 1, .offset = offsetof(instance_t, color) }
+            }
+        },
+        .shader = sg_make_shader(&shader_desc),
+        .primitive_type = SG_PRIMITIVETYPE_TRIANGLE_STRIP,
+        .colors[0].blend = {
+            .enabled = true,
+            .src_factor_rgb = SG_BLENDFACTOR_SRC_ALPHA,
+            .dst_factor_rgb = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA
+        },
+        .label = "instanced quad pipeline"
+    });
+
+    // the image is flipped vertically on load, so v runs bottom to top
+    const atlas_rect_t r = atlas_rect(&atlas, boomer_id);
+    const uint16_t u0 = (uint16_t)(r.u0 * 65535.0f), v0 = (uint16_t)(r.v0 * 65535.0f);
+    const uint16_t u1 = (uint16_t)(r.u1 * 65535.0f), v1 = (uint16_t)(r.v1 * 65535.0f);
+
+    instances = malloc(sizeof(instance_t) * bench_sprite_count);
+
+    for (int i = 0; i < bench_sprite_count; i++)
+    {
+        instances[i] = (instance_t){
+            .rect  = { 0.0f, 0.0f, 16.0f, 16.0f },
+            .uv    = { u0, v1, u1, v0 },
+            .color = 0xFFFFFFFF
+        };
+    }
+}
+
+// Sprite submission time and counters, reported once per second in benchmark mode
+double submit_ms = 0.0;
+int num_frames = 0;
+int frame_sprites = 0;
+int frame_draws = 0;
+int frame_dropped = 0;
+Uint64 report_time = 0;
+
+void draw_instanced(void)
+{
+    for (int i = 0; i < bench_sprite_count; i++)
+    {
+        instances[i].rect[0] = bench_sprites[i].x - 8.0f;
+        instances[i].rect[1] = bench_sprites[i].y - 8.0f;
+    }
+
+    sg_update_buffer(inst_bind.vertex_buffers[1], &(sg_range){
+        .ptr = instances, .size = sizeof(instance_t) * bench_sprite_count
+    });
+
+    const HMM_Mat4 proj = HMM_Orthographic_RH_NO(0.0f, (float)window_width, (float)window_height, 0.0f, -1.0f, 1.0f);
+    vs_instanced_params_t params;
+    memcpy(params.mvp, &proj, sizeof(params.mvp));
+
+    sg_apply_pipeline(inst_pip);
+    frame_draws = 0;
+
+    for (int first = 0; first < bench_sprite_count; first += INSTANCES_PER_DRAW)
+    {
+        const int count = (bench_sprite_count - first) < INSTANCES_PER_DRAW ? (bench_sprite_count - first) : INSTANCES_PER_DRAW;
+
+        inst_bind.vertex_buffer_offsets[1] = first * (int)sizeof(instance_t);
+        sg_apply_bindings(&inst_bind);
+
+        if (first == 0)
+            sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(params));
+
+        sg_draw(0, 4, count);
+        frame_draws++;
+    }
+
+    frame_sprites = bench_sprite_count;
+    frame_dropped = 0;
+}
+
+void report_bench(void)
+{
+    const Uint64 now = SDL_GetPerformanceCounter();
+
+    if (report_time == 0)
+    {
+        report_time = now;
+        return;
+    }
+
+    const double elapsed_ms = (double)(now - report_time) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+    if (elapsed_ms < 1000.0)
+        return;
+
+    const double frame_submit_ms = submit_ms / num_frames;
+
+    printf("%d %s, %d draws, %d dropped: %.1f fps, submit %.2f ms/frame, %.0f sprites/ms\n",
+           frame_sprites, instanced ? "instanced quads" : "sprites", frame_draws, frame_dropped,
+           num_frames * 1000.0 / elapsed_ms, frame_submit_ms,
+           frame_sprites / frame_submit_ms);
+
+    submit_ms = 0.0;
+    num_frames = 0;
+    report_time = now;
+}
+
+void draw_sprites(void)
+{
+    if (bench)
+    {
+        // all bitmaps share one atlas page, so this is still one draw per batch
+        for (int i = 0; i < bench_sprite_count; i++)
+        {
+            const atlas_rect_t r = atlas_rect(&atlas, bench_sprites[i].id);
+
+            sprite_batch_draw(&batch, atlas_image(&atlas, r.page), &(sprite_t){
+                .x = bench_sprites[i].x - 8.0f, .y = bench_sprites[i].y - 8.0f,
+                .w = 16.0f, .h = 16.0f,
+                .u0 = r.u0, .v0 = r.v1, .u1 = r.u1, .v1 = r.v0,
+                .color = SPRITE_COLOR_WHITE
+            });
+        }
+    }
+    else
+    {
+        // the image is flipped vertically on load, so v runs bottom to top
+        // shows a placeholder until the streamed image is ready
+        const sg_image image = texture_stream_image(&stream, img);
+        const float w = (float)image_w / 2.0f;
+        const float h = (float)image_h / 2.0f;
+
+        for (int i = 0; i < 3; i++)
+        {
+            sprite_batch_draw(&batch, image, &(sprite_t){
+                .x = (float)window_width / 2.0f + (i - 1.5f) * w, .y = ((float)window_height - h) / 2.0f,
+                .w = w, .h = h,
+                .u0 = 0.0f, .v0 = 1.0f, .u1 = 1.0f, .v1 = 0.0f,
+                .color = (i == 1) ? SPRITE_COLOR_WHITE : 0x80FFFFFF
+            });
+        }
+    }
+}
+
+void frame(void)
+{
     sg_pass_action pass_action = {
         .colors[0] = { .load_action=SG_LOADACTION_CLEAR, .clear_value={0.0f, 0.0f, 0.0f, 1.0f } }
     };
 
+    if (bench)
+        update_bench();
+
     sg_begin_default_pass(&pass_action, window_width, window_height);
-    sg_apply_pipeline(pip);
-    sg_apply_bindings(&bind);
-    sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(vs_params));
-    sg_draw(0, 3, 1);
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    if (instanced)
+    {
+        draw_instanced();
+    }
+    else
+    {
+        sprite_batch_begin(&batch, window_width, window_height);
+        draw_sprites();
+        sprite_batch_end(&batch);
+
+        const sprite_batch_stats_t stats = sprite_batch_stats(&batch);
+        frame_sprites = stats.num_sprites;
+        frame_draws = stats.num_draws;
+        frame_dropped = stats.num_dropped;
+    }
+
+    submit_ms += (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    num_frames++;
+
     sg_end_pass();
     sg_commit();
-}
 
-sg_image img;
-sg_image_data img_data;
+    if (bench)
+        report_bench();
+}
 
-typedef struct
+int main(int argc, char* argv[])
 {
-    float pos[3];
-    float color[4];
-    float uv[2];
-} vertex_t;
+    for (int i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--bench") == 0) || (strcmp(argv[i], "--instanced") == 0))
+        {
+            bench = true;
+            instanced = (strcmp(argv[i], "--instanced") == 0);
+
+            if ((i + 1 < argc) && (atoi(argv[i + 1]) > 0))
+                bench_sprite_count = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--mipmap-bench") == 0)
+        {
+            mipmap_bench = true;
+        }
+        else if (strcmp(argv[i], "--queue-bench") == 0)
+        {
+            queue_bench = true;
+        }
+    }
+
+    if (bench_sprite_count == 0)
+        bench_sprite_count = instanced ? 1000000 : 200000;
 
-int main()
-{
     if (!init_sdl())
     {
         return -1;
@@ -119,60 +686,35 @@ int main()
 
     stbi_set_flip_vertically_on_load(true);
 
-    int image_w, image_h, image_c;
-    unsigned char* bitmap = stbi_load("./boomer.png", &image_w, &image_h,
-                                                      &image_c, 0);
-
     // Sokol Gfx initialization
 
     sg_setup(&(sg_desc){
         .logger.func = slog_func
     });
 
-    // Create a Sokol Gfx triangle
-    /*float vertices[] = {
-        // positions            // colors                //uvs
-         0.0f,  0.5f, 0.5f,     1.0f, 1.0f, 1.0f, 1.0f,  0.0f, 1.0f,
-         0.5f, -0.5f, 0.5f,     1.0f, 1.0f, 1.0f, 1.0f,  1.0f, 0.0f,
-        -0.5f, -0.5f, 0.5f,     1.0f, 1.0f, 1.0f, 1.0f,  0.0f, 0.0f,
-    };*/
-
-    vertex_t vertices[] = {
-        { { 0.0f,  0.5f, 0.5f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 1.0f } },
-        { { 0.5f, -0.5f, 0.5f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 0.0f } },
-        { {-0.5f, -0.5f, 0.5f }, { 1.0f, 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f } }
-    };
-
-    /*sg_buffer_desc vbuf_desc = {
-        .size = sizeof(vertex_t) * 3,
-        .data = vertices,
-        .label = "vertex buffer"
-    };*/
-
-    sg_buffer_desc vbuf_desc = {
-        .size  = sizeof(vertex_t) * 3,
-        .type  = SG_BUFFERTYPE_VERTEXBUFFER,
-        .data  = { .ptr = vertices, .size = sizeof(vertex_t) * 3 },
-        .label = "vertex buffer"
-    };
-
-    sg_buffer vbuf = sg_make_buffer(&vbuf_desc);
+    if (mipmap_bench)
+    {
+        bench_mipmaps();
+        sg_shutdown();
+        SDL_GL_DeleteContext(context);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 0;
+    }
 
     sg_shader_desc shader_desc = {
         .vs.uniform_blocks[0] = {
             .size = sizeof(vs_params_t),
-            //.layout = SG_UNIFORMLAYOUT_STD140, //SG_UNIFORMLAYOUT_NATIVE,  // this is the default and can be omitted
-            .uniforms = {
-                [0] = { .name = "mvp", .type = SG_UNIFORMTYPE_MAT4, .array_count = 1 },
-                [1] = { .name = "scale", .type = SG_UNIFORMTYPE_FLOAT4, .array_count = 1 },
-            }
-         },
+            .layout = SG_UNIFORMLAYOUT_STD140,
+            .name = "vs_params", // uploaded as a whole through a uniform buffer
+        },
 
-          //           "layout(binding = 0) uniform vs_params {\n" // <-- DOES NOT WORK
         .vs.source =
             "#version 330\n"
-            "uniform mat4 mvp;\n" // <-- THIS DOES WORK
-            "uniform vec4 scale;\n"
+            "layout(std140) uniform vs_params {\n"
+            "  mat4 mvp;\n"
+            "  vec4 scale;\n"
+            "};\n"
             "layout(location = 0) in vec4 a_pos;\n"
             "layout(location = 1) in vec4 a_col;\n"
             "layout(location = 2) in vec2 a_uv;\n"
@@ -197,32 +739,76 @@ int main()
 
     sg_shader shader = sg_make_shader(&shader_desc);
 
-    sg_pipeline_desc pip_desc = {
-        .layout = {
-            .attrs = {
-                /*[0] = { .format = SG_VERTEXFORMAT_FLOAT3,  },
-                [1] = { .format = SG_VERTEXFORMAT_FLOAT4,  },
-                [2] = { .format = SG_VERTEXFORMAT_FLOAT2,  }*/
-                [0] = { .format = SG_VERTEXFORMAT_FLOAT3, .offset = offsetof(vertex_t, pos) },
-                [1] = { .format = SG_VERTEXFORMAT_FLOAT4, .offset = offsetof(vertex_t, color) },
-                [2] = { .format = SG_VERTEXFORMAT_FLOAT2, .offset = offsetof(vertex_t, uv) }
-            }
-        },
-        .shader = shader,
-        .primitive_type = SG_PRIMITIVETYPE_TRIANGLES,
-        .index_type = SG_INDEXTYPE_NONE,
-        .label = "pipeline"
-    };
+    if (queue_bench)
+    {
+        bench_queue(shader);
+        sg_shutdown();
+        SDL_GL_DeleteContext(context);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 0;
+    }
 
-    pip = sg_make_pipeline(&pip_desc);
+    // boomer.png is decoded and BC3 compressed on a background thread and
+    // uploaded within sokol_gfx's init queue budget, only its size is read up front
+    if (!texture_stream_init(&stream, &(texture_stream_desc_t){
+        .flip_vertically = true,
+        .min_filter = SG_FILTER_LINEAR_MIPMAP_LINEAR,
+        .generate_mipmaps = SG_MIPMAPGEN_GPU,
+        .compress = SG_PIXELFORMAT_BC3_RGBA
+    }))
+    {
+        printf("Failed to start the texture stream\n");
+        return -1;
+    }
 
-    bind.fs_images[0] = sg_make_image(&(sg_image_desc){
-        .width = image_w,
-        .height = image_h,
-        .data.subimage[0][0] = { .ptr = bitmap, .size = image_w * image_h * image_c }
-    });
+    int image_c;
+    stbi_info("./boomer.png", &image_w, &image_h, &image_c);
+
+    if (!bench)
+        img = texture_stream_load(&stream, "./boomer.png");
+
+    // The benchmark needs boomer.png right away, it goes into a texture atlas
+    // along with a few hundred small generated bitmaps
+    if (!atlas_init(&atlas, &(atlas_desc_t){ .width = 2048, .height = 2048, .label = "atlas" }))
+    {
+        printf("Failed to allocate the texture atlas\n");
+        return -1;
+    }
+
+    if (bench)
+    {
+        unsigned char* bitmap = stbi_load("./boomer.png", &image_w, &image_h, &image_c, 4);
+        boomer_id = atlas_add(&atlas, bitmap, image_w, image_h);
+        stbi_image_free(bitmap);
+
+        if (!instanced)
+            add_icons();
+
+        atlas_commit(&atlas);
+        img = atlas_image(&atlas, atlas_rect(&atlas, boomer_id).page);
+
+        const atlas_stats_t atlas_info = atlas_stats(&atlas);
+        printf("atlas: %d bitmaps on %d pages, %.1f%% used, packed in %.2f ms, uploaded in %.2f ms\n",
+               atlas_info.num_entries, atlas_info.num_pages, atlas_info.efficiency * 100.0f,
+               atlas_info.pack_ms, atlas_info.upload_ms);
+    }
+
+    // The sprite batcher creates an alpha-blended pipeline for the quad shader
+    if (!sprite_batch_init(&batch, &(sprite_batch_desc_t){
+        .shader = shader,
+        .max_sprites = (bench && !instanced && bench_sprite_count > 262144) ? bench_sprite_count : 0
+    }))
+    {
+        printf("Failed to allocate the sprite batch\n");
+        return -1;
+    }
+
+    if (bench)
+        init_bench();
 
-    bind.vertex_buffers[0] = vbuf;
+    if (instanced)
+        init_instanced(shader_desc);
 
     // Main loop
     bool done = false;
@@ -255,6 +841,11 @@ int main()
     }
 
     // Cleanup
+    sprite_batch_shutdown(&batch);
+    atlas_shutdown(&atlas);
+    texture_stream_shutdown(&stream);
+    free(instances);
+    free(bench_sprites);
     sg_shutdown();
     SDL_GL_DeleteContext(context);
     SDL_DestroyWindow(window);
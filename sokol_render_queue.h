@@ -0,0 +1,729 @@
+#ifndef SOKOL_RENDER_QUEUE_H
+#define SOKOL_RENDER_QUEUE_H
+/*
+    sokol_render_queue.h -- sorted draw submission on top of sokol_gfx.h
+
+    Include sokol_gfx.h first, and do this:
+
+        #define SOKOL_RENDER_QUEUE_IMPL
+
+    before including this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following defines with your own implementations:
+
+    SOKOL_ASSERT(c)                 - your own assert macro (default: assert(c))
+
+
+    OVERVIEW
+    ========
+    sokol_render_queue.h collects draw packets (pipeline, bindings, uniform
+    data and draw range) together with a 64-bit sort key, and on flush
+    sorts the packets by key and issues the sokol-gfx calls in sorted order.
+
+    Without a queue, draws are issued in whatever order the application
+    happens to walk its scene, which means that the pipeline and texture
+    state flips back and forth between draws. Sorting the packets groups
+    draws with identical state, so that redundant sg_apply_pipeline() and
+    sg_apply_bindings() calls can be dropped entirely, and the remaining
+    ones hit the sokol-gfx state cache much more often.
+
+    The sort is a stable LSD radix sort over the 8 key bytes, key bytes
+    which are identical for all packets in the queue are skipped.
+
+
+    STEP BY STEP
+    ============
+    --- call srq_setup() after sg_setup():
+
+            srq_setup(&(srq_desc){ .logger.func = slog_func });
+
+        The following srq_desc items can be provided (all optional):
+
+        .max_draws          - max number of draw packets per flush (default: 4096)
+        .uniform_buffer_size - size of the buffer which holds copies of the uniform
+                              data of all draw packets in bytes (default: 256 KB)
+        .allocator          - optional memory allocation callbacks
+        .logger             - optional logging callback
+
+    --- register the render passes the queue should render into, passes are
+        rendered in ascending pass index order, and a registration remains
+        valid until it is replaced or removed with srq_set_pass(index, 0):
+
+            srq_set_pass(0, &(srq_pass_desc){
+                .pass = offscreen_pass,
+                .action = { ... },
+            });
+            srq_set_pass(1, &(srq_pass_desc){
+                .action = { ... },      // no .pass: the default pass
+                .width = width,
+                .height = height,
+            });
+
+    --- describe and submit draws anywhere between flushes, the srq_draw
+        struct and the uniform data it points to are copied into the queue:
+
+            const srq_draw draw = {
+                .pipeline = pip,
+                .bindings = { ... },
+                .vs_uniforms[0] = SG_RANGE(vs_params),
+                .num_elements = 6,
+            };
+            srq_submit(srq_make_key(1, &draw, view_depth), &draw);
+
+    --- once per frame, sort the queue and issue the sokol-gfx calls, this must
+        be called outside of a sokol-gfx render pass. All registered passes
+        are started and finished (even those without draws so that their
+        pass action is performed), afterwards the queue is empty:
+
+            srq_flush();
+            sg_commit();
+
+    --- optionally query what the last flush did:
+
+            srq_stats stats = srq_query_stats();
+
+    --- call srq_shutdown() before sg_shutdown()
+
+
+    SORT KEYS
+    =========
+    srq_make_key() builds a key with the following layout:
+
+        bits 56..63: pass index
+        bits 40..55: pipeline rank (of srq_draw.pipeline)
+        bits 24..39: texture rank (of srq_draw.bindings.fs_images[0])
+        bits  0..23: depth, quantized from the range 0.0 .. 1.0
+
+    ...so that packets are grouped by pass, then by pipeline, then by
+    texture, and sorted front-to-back within groups with identical state.
+
+    A rank is a small number which the queue assigns to each distinct
+    pipeline and image handle id in the order in which srq_make_key() first
+    sees them, the ranks are forgotten in srq_flush(), so keys built with
+    srq_make_key() are only valid until the next flush. If there are more
+    distinct pipelines or images than srq_desc.max_draws (or 65534), the
+    remaining ids share the last rank: those packets are still rendered
+    correctly, just not grouped.
+
+    For back-to-front rendering of translucent geometry, pass '1.0 - depth'
+    and register the translucent draws in a separate pass, or build your own
+    key with depth in the most significant bits below the pass index.
+
+    Any custom key layout can be used with srq_submit() as long as the
+    pass index is kept in the top 8 bits. Packets with identical keys are
+    issued in submission order.
+
+
+    LIMITATIONS
+    ===========
+    - the queue is a single global object and not thread-safe
+    - the uniform data of a packet is applied with every draw, even if it
+      is identical to the previous draw's uniform data
+*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before sokol_render_queue.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    SRQ_MAX_PASSES = 256,   // the pass index occupies the top 8 bits of a sort key
+};
+
+#define _SRQ_LOG_ITEMS \
+    _SRQ_LOGITEM_XMACRO(OK, "Ok") \
+    _SRQ_LOGITEM_XMACRO(MALLOC_FAILED, "memory allocation failed") \
+    _SRQ_LOGITEM_XMACRO(DRAWS_FULL, "draw queue is full (increase srq_desc.max_draws)") \
+    _SRQ_LOGITEM_XMACRO(UNIFORMS_FULL, "uniform buffer is full (increase srq_desc.uniform_buffer_size)") \
+    _SRQ_LOGITEM_XMACRO(PASS_INDEX_OUT_OF_RANGE, "pass index must be >= 0 and < SRQ_MAX_PASSES") \
+    _SRQ_LOGITEM_XMACRO(PASS_NOT_REGISTERED, "draws were submitted for a pass index without srq_set_pass() registration, dropped") \
+
+#define _SRQ_LOGITEM_XMACRO(item,msg) SRQ_LOGITEM_##item,
+typedef enum srq_log_item_t {
+    _SRQ_LOG_ITEMS
+} srq_log_item_t;
+#undef _SRQ_LOGITEM_XMACRO
+
+/*
+    srq_allocator
+
+    Used in srq_desc to provide custom memory-alloc and -free functions
+    to sokol_render_queue.h. If memory management should be overridden,
+    both the alloc and free function must be provided (e.g. it's not
+    valid to override one function but not the other).
+*/
+typedef struct srq_allocator {
+    void* (*alloc)(size_t size, void* user_data);
+    void (*free)(void* ptr, void* user_data);
+    void* user_data;
+} srq_allocator;
+
+/*
+    srq_logger
+
+    Used in srq_desc to provide a logging function. Please be aware that
+    without logging function, sokol_render_queue.h will be completely
+    silent, e.g. it will not report errors or warnings. For maximum error
+    verbosity, compile in debug mode (e.g. NDEBUG *not* defined) and install
+    a logger (for instance the standard logging function from sokol_log.h).
+*/
+typedef struct srq_logger {
+    void (*func)(
+        const char* tag,                // always "srq"
+        uint32_t log_level,             // 0=panic, 1=error, 2=warning, 3=info
+        uint32_t log_item_id,           // SRQ_LOGITEM_*
+        const char* message_or_null,    // a message string, may be nullptr in release mode
+        uint32_t line_nr,               // line number in sokol_render_queue.h
+        const char* filename_or_null,   // source filename, may be nullptr in release mode
+        void* user_data);
+    void* user_data;
+} srq_logger;
+
+typedef struct srq_desc {
+    int max_draws;              // default: 4096
+    int uniform_buffer_size;    // default: 256 KB
+    srq_allocator allocator;
+    srq_logger logger;
+} srq_desc;
+
+/* a render pass the queue renders into, an invalid .pass means the default pass */
+typedef struct srq_pass_desc {
+    sg_pass pass;
+    sg_pass_action action;
+    int width;                  // default pass only
+    int height;                 // default pass only
+} srq_pass_desc;
+
+/* a draw packet, the uniform data is copied into the queue on submission */
+typedef struct srq_draw {
+    sg_pipeline pipeline;
+    sg_bindings bindings;
+    sg_range vs_uniforms[SG_MAX_SHADERSTAGE_UBS];
+    sg_range fs_uniforms[SG_MAX_SHADERSTAGE_UBS];
+    int base_element;
+    int num_elements;
+    int num_instances;          // default: 1
+} srq_draw;
+
+/* what the last srq_flush() call did */
+typedef struct srq_stats {
+    int num_draws;              // number of sg_draw() calls
+    int num_apply_pipeline;     // number of sg_apply_pipeline() calls
+    int num_apply_bindings;     // number of sg_apply_bindings() calls
+    int num_passes;             // number of render passes
+    int num_dropped;            // number of packets dropped because their pass wasn't registered
+} srq_stats;
+
+void srq_setup(const srq_desc* desc);
+void srq_shutdown(void);
+void srq_set_pass(int pass_index, const srq_pass_desc* desc);
+uint64_t srq_make_key(int pass_index, const srq_draw* draw, float depth);
+void srq_submit(uint64_t key, const srq_draw* draw);
+void srq_flush(void);
+srq_stats srq_query_stats(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif // SOKOL_RENDER_QUEUE_H
+
+// ██ ███    ███ ██████  ██      ███████ ███    ███ ███████ ███    ██ ████████  █████  ████████ ██  ██████  ███    ██
+// ██ ████  ████ ██   ██ ██      ██      ████  ████ ██      ████   ██    ██    ██   ██    ██    ██ ██    ██ ████   ██
+// ██ ██ ████ ██ ██████  ██      █████   ██ ████ ██ █████   ██ ██  ██    ██    ███████    ██    ██ ██    ██ ██ ██  ██
+// ██ ██  ██  ██ ██      ██      ██      ██  ██  ██ ██      ██  ██ ██    ██    ██   ██    ██    ██ ██    ██ ██  ██ ██
+// ██ ██      ██ ██      ███████ ███████ ██      ██ ███████ ██   ████    ██    ██   ██    ██    ██  ██████  ██   ████
+//
+// >>implementation
+#ifdef SOKOL_RENDER_QUEUE_IMPL
+#ifndef SOKOL_RENDER_QUEUE_IMPL_INCLUDED
+#define SOKOL_RENDER_QUEUE_IMPL_INCLUDED
+
+#if defined(SOKOL_MALLOC) || defined(SOKOL_CALLOC) || defined(SOKOL_FREE)
+#error "SOKOL_MALLOC/CALLOC/FREE macros are no longer supported, please use srq_desc.allocator to override memory allocation functions"
+#endif
+
+#include <stdlib.h> // malloc, free
+#include <string.h> // memset, memcpy
+
+#ifndef SOKOL_DEBUG
+    #ifndef NDEBUG
+        #define SOKOL_DEBUG
+    #endif
+#endif
+#ifndef SOKOL_ASSERT
+    #include <assert.h>
+    #define SOKOL_ASSERT(c) assert(c)
+#endif
+
+#ifndef _SOKOL_PRIVATE
+    #if defined(__GNUC__) || defined(__clang__)
+        #define _SOKOL_PRIVATE __attribute__((unused)) static
+    #else
+        #define _SOKOL_PRIVATE static
+    #endif
+#endif
+
+#define _srq_def(val, def) (((val) == 0) ? (def) : (val))
+
+enum {
+    _SRQ_DEFAULT_MAX_DRAWS = 4096,
+    _SRQ_DEFAULT_UNIFORM_BUFFER_SIZE = 256 * 1024,
+    _SRQ_UNIFORM_ALIGN = 16,
+    _SRQ_PASS_SHIFT = 56,
+    _SRQ_PIPELINE_SHIFT = 40,
+    _SRQ_TEXTURE_SHIFT = 24,
+    _SRQ_DEPTH_MASK = 0xFFFFFF,
+    _SRQ_RANK_MASK = 0xFFFF,
+};
+
+typedef struct {
+    uint64_t key;
+    uint32_t draw_index;
+} _srq_item_t;
+
+typedef struct {
+    bool valid;
+    srq_pass_desc desc;
+} _srq_pass_t;
+
+/* open-addressing hash map from resource id to sort key rank, cleared in srq_flush() */
+typedef struct {
+    uint32_t mask;          // number of entries - 1, the number of entries is a power of 2
+    uint32_t num_ranks;
+    uint32_t* ids;          // SG_INVALID_ID marks a free entry
+    uint32_t* ranks;
+} _srq_rank_map_t;
+
+typedef struct {
+    bool valid;
+    srq_desc desc;
+    int num_draws;
+    int uniform_pos;
+    srq_draw* draws;
+    _srq_item_t* items;
+    _srq_item_t* sort_tmp;
+    uint8_t* uniforms;
+    _srq_pass_t passes[SRQ_MAX_PASSES];
+    _srq_rank_map_t pipeline_ranks;
+    _srq_rank_map_t image_ranks;
+    srq_stats stats;
+} _srq_state_t;
+static _srq_state_t _srq;
+
+// ██       ██████   ██████   ██████  ██ ███    ██  ██████
+// ██      ██    ██ ██       ██       ██ ████   ██ ██
+// ██      ██    ██ ██   ███ ██   ███ ██ ██ ██  ██ ██   ███
+// ██      ██    ██ ██    ██ ██    ██ ██ ██  ██ ██ ██    ██
+// ███████  ██████   ██████   ██████  ██ ██   ████  ██████
+//
+// >>logging
+#if defined(SOKOL_DEBUG)
+#define _SRQ_LOGITEM_XMACRO(item,msg) #item ": " msg,
+static const char* _srq_log_messages[] = {
+    _SRQ_LOG_ITEMS
+};
+#undef _SRQ_LOGITEM_XMACRO
+#endif // SOKOL_DEBUG
+
+#define _SRQ_PANIC(code) _srq_log(SRQ_LOGITEM_ ##code, 0, __LINE__)
+#define _SRQ_ERROR(code) _srq_log(SRQ_LOGITEM_ ##code, 1, __LINE__)
+#define _SRQ_WARN(code) _srq_log(SRQ_LOGITEM_ ##code, 2, __LINE__)
+
+static void _srq_log(srq_log_item_t log_item, uint32_t log_level, uint32_t line_nr) {
+    if (_srq.desc.logger.func) {
+        #if defined(SOKOL_DEBUG)
+            const char* filename = __FILE__;
+            const char* message = _srq_log_messages[log_item];
+        #else
+            const char* filename = 0;
+            const char* message = 0;
+        #endif
+        _srq.desc.logger.func("srq", log_level, log_item, message, line_nr, filename, _srq.desc.logger.user_data);
+    }
+    else {
+        // for log level PANIC it would be 'undefined behaviour' to continue
+        if (log_level == 0) {
+            abort();
+        }
+    }
+}
+
+// ███    ███ ███████ ███    ███  ██████  ██████  ██    ██
+// ████  ████ ██      ████  ████ ██    ██ ██   ██  ██  ██
+// ██ ████ ██ █████   ██ ████ ██ ██    ██ ██████    ████
+// ██  ██  ██ ██      ██  ██  ██ ██    ██ ██   ██    ██
+// ██      ██ ███████ ██      ██  ██████  ██   ██    ██
+//
+// >>memory
+_SOKOL_PRIVATE void _srq_clear(void* ptr, size_t size) {
+    SOKOL_ASSERT(ptr && (size > 0));
+    memset(ptr, 0, size);
+}
+
+_SOKOL_PRIVATE void* _srq_malloc(size_t size) {
+    SOKOL_ASSERT(size > 0);
+    void* ptr;
+    if (_srq.desc.allocator.alloc) {
+        ptr = _srq.desc.allocator.alloc(size, _srq.desc.allocator.user_data);
+    }
+    else {
+        ptr = malloc(size);
+    }
+    if (0 == ptr) {
+        _SRQ_PANIC(MALLOC_FAILED);
+    }
+    return ptr;
+}
+
+_SOKOL_PRIVATE void _srq_free(void* ptr) {
+    if (_srq.desc.allocator.free) {
+        _srq.desc.allocator.free(ptr, _srq.desc.allocator.user_data);
+    }
+    else {
+        free(ptr);
+    }
+}
+
+// ███████  ██████  ██████  ████████
+// ██      ██    ██ ██   ██    ██
+// ███████ ██    ██ ██████     ██
+//      ██ ██    ██ ██   ██    ██
+// ███████  ██████  ██   ██    ██
+//
+// >>sort
+
+/* stable LSD radix sort by key, one 8-bit digit per pass, all histograms
+   are gathered in a single sweep, and digits where all keys fall into the
+   same bucket are skipped (common for the pass index and pipeline bits)
+*/
+_SOKOL_PRIVATE _srq_item_t* _srq_radix_sort(_srq_item_t* items, _srq_item_t* tmp, int num) {
+    uint32_t hist[8][256];
+    _srq_clear(hist, sizeof(hist));
+    for (int i = 0; i < num; i++) {
+        const uint64_t key = items[i].key;
+        for (int d = 0; d < 8; d++) {
+            hist[d][(key >> (d * 8)) & 0xFF]++;
+        }
+    }
+    _srq_item_t* src = items;
+    _srq_item_t* dst = tmp;
+    for (int d = 0; d < 8; d++) {
+        uint32_t* h = hist[d];
+        const int shift = d * 8;
+        if (h[(src[0].key >> shift) & 0xFF] == (uint32_t)num) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            const uint32_t count = h[b];
+            h[b] = offset;
+            offset += count;
+        }
+        for (int i = 0; i < num; i++) {
+            dst[h[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        _srq_item_t* swap = src;
+        src = dst;
+        dst = swap;
+    }
+    return src;
+}
+
+// ██████   █████  ███    ██ ██   ██ ███████
+// ██   ██ ██   ██ ████   ██ ██  ██  ██
+// ██████  ███████ ██ ██  ██ █████   ███████
+// ██   ██ ██   ██ ██  ██ ██ ██  ██       ██
+// ██   ██ ██   ██ ██   ████ ██   ██ ███████
+//
+// >>ranks
+_SOKOL_PRIVATE void _srq_rank_map_init(_srq_rank_map_t* map, int max_ids) {
+    uint32_t num = 16;
+    while (num < (uint32_t)max_ids * 2) {
+        num *= 2;
+    }
+    map->mask = num - 1;
+    map->num_ranks = 0;
+    map->ids = (uint32_t*) _srq_malloc(num * sizeof(uint32_t));
+    map->ranks = (uint32_t*) _srq_malloc(num * sizeof(uint32_t));
+    _srq_clear(map->ids, num * sizeof(uint32_t));
+}
+
+_SOKOL_PRIVATE void _srq_rank_map_discard(_srq_rank_map_t* map) {
+    _srq_free(map->ranks);
+    _srq_free(map->ids);
+}
+
+_SOKOL_PRIVATE void _srq_rank_map_reset(_srq_rank_map_t* map) {
+    if (map->num_ranks > 0) {
+        _srq_clear(map->ids, (map->mask + 1) * sizeof(uint32_t));
+        map->num_ranks = 0;
+    }
+}
+
+/* returns the rank of a resource id, assigning the next free rank to unseen
+   ids, the map is kept at most half full, after that (or when the ranks run
+   out) unseen ids share the last rank
+*/
+_SOKOL_PRIVATE uint32_t _srq_rank(_srq_rank_map_t* map, uint32_t id) {
+    if (SG_INVALID_ID == id) {
+        return 0;
+    }
+    uint32_t i = (id * 2654435761u) & map->mask;
+    while (map->ids[i] != SG_INVALID_ID) {
+        if (map->ids[i] == id) {
+            return map->ranks[i];
+        }
+        i = (i + 1) & map->mask;
+    }
+    if ((map->num_ranks >= (_SRQ_RANK_MASK - 1)) || ((map->num_ranks * 2) > map->mask)) {
+        return _SRQ_RANK_MASK;
+    }
+    map->ids[i] = id;
+    map->ranks[i] = ++map->num_ranks;
+    return map->ranks[i];
+}
+
+// ██ ███████ ███████ ██    ██ ███████
+// ██ ██      ██      ██    ██ ██
+// ██ ███████ ███████ ██    ██ █████
+// ██      ██      ██ ██    ██ ██
+// ██ ███████ ███████  ██████  ███████
+//
+// >>issue
+_SOKOL_PRIVATE int _srq_pass_index(uint64_t key) {
+    return (int)(key >> _SRQ_PASS_SHIFT);
+}
+
+_SOKOL_PRIVATE void _srq_begin_pass(const srq_pass_desc* desc) {
+    if (desc->pass.id != SG_INVALID_ID) {
+        sg_begin_pass(desc->pass, &desc->action);
+    }
+    else {
+        sg_begin_default_pass(&desc->action, desc->width, desc->height);
+    }
+    _srq.stats.num_passes++;
+}
+
+/* compares only the bindings which are in use: the vertex buffers and images
+   up to the first empty slot and the index buffer if there is one, unused
+   offsets and the canaries are ignored
+*/
+_SOKOL_PRIVATE bool _srq_bindings_equal(const sg_bindings* a, const sg_bindings* b) {
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_BUFFERS; i++) {
+        if (a->vertex_buffers[i].id != b->vertex_buffers[i].id) {
+            return false;
+        }
+        if (SG_INVALID_ID == a->vertex_buffers[i].id) {
+            break;
+        }
+        if (a->vertex_buffer_offsets[i] != b->vertex_buffer_offsets[i]) {
+            return false;
+        }
+    }
+    if (a->index_buffer.id != b->index_buffer.id) {
+        return false;
+    }
+    if ((SG_INVALID_ID != a->index_buffer.id) && (a->index_buffer_offset != b->index_buffer_offset)) {
+        return false;
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        if (a->vs_images[i].id != b->vs_images[i].id) {
+            return false;
+        }
+        if (SG_INVALID_ID == a->vs_images[i].id) {
+            break;
+        }
+    }
+    for (int i = 0; i < SG_MAX_SHADERSTAGE_IMAGES; i++) {
+        if (a->fs_images[i].id != b->fs_images[i].id) {
+            return false;
+        }
+        if (SG_INVALID_ID == a->fs_images[i].id) {
+            break;
+        }
+    }
+    return true;
+}
+
+/* issue the sorted draws of one pass, dropping redundant pipeline and bindings updates */
+_SOKOL_PRIVATE void _srq_issue_draws(const _srq_item_t* items, int num) {
+    sg_pipeline cur_pip = { SG_INVALID_ID };
+    const sg_bindings* cur_bnd = 0;
+    for (int i = 0; i < num; i++) {
+        const srq_draw* draw = &_srq.draws[items[i].draw_index];
+        if (draw->pipeline.id != cur_pip.id) {
+            cur_pip = draw->pipeline;
+            cur_bnd = 0;
+            sg_apply_pipeline(cur_pip);
+            _srq.stats.num_apply_pipeline++;
+        }
+        if ((0 == cur_bnd) || !_srq_bindings_equal(cur_bnd, &draw->bindings)) {
+            cur_bnd = &draw->bindings;
+            sg_apply_bindings(cur_bnd);
+            _srq.stats.num_apply_bindings++;
+        }
+        for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+            if (draw->vs_uniforms[ub_index].size > 0) {
+                sg_apply_uniforms(SG_SHADERSTAGE_VS, ub_index, &draw->vs_uniforms[ub_index]);
+            }
+            if (draw->fs_uniforms[ub_index].size > 0) {
+                sg_apply_uniforms(SG_SHADERSTAGE_FS, ub_index, &draw->fs_uniforms[ub_index]);
+            }
+        }
+        sg_draw(draw->base_element, draw->num_elements, draw->num_instances);
+        _srq.stats.num_draws++;
+    }
+}
+
+/* copy uniform data into the queue's uniform buffer, returns false if it's full */
+_SOKOL_PRIVATE bool _srq_copy_uniforms(sg_range* range) {
+    if (0 == range->size) {
+        range->ptr = 0;
+        return true;
+    }
+    SOKOL_ASSERT(range->ptr);
+    const size_t size = (range->size + (_SRQ_UNIFORM_ALIGN - 1)) & ~((size_t)_SRQ_UNIFORM_ALIGN - 1);
+    if ((_srq.uniform_pos + size) > (size_t)_srq.desc.uniform_buffer_size) {
+        return false;
+    }
+    uint8_t* dst = _srq.uniforms + _srq.uniform_pos;
+    memcpy(dst, range->ptr, range->size);
+    range->ptr = dst;
+    _srq.uniform_pos += (int)size;
+    return true;
+}
+
+// ██████  ██    ██ ██████  ██      ██  ██████
+// ██   ██ ██    ██ ██   ██ ██      ██ ██
+// ██████  ██    ██ ██████  ██      ██ ██
+// ██      ██    ██ ██   ██ ██      ██ ██
+// ██       ██████  ██████  ███████ ██  ██████
+//
+// >>public
+void srq_setup(const srq_desc* desc) {
+    SOKOL_ASSERT(desc);
+    _srq_clear(&_srq, sizeof(_srq));
+    _srq.desc = *desc;
+    _srq.desc.max_draws = _srq_def(_srq.desc.max_draws, _SRQ_DEFAULT_MAX_DRAWS);
+    _srq.desc.uniform_buffer_size = _srq_def(_srq.desc.uniform_buffer_size, _SRQ_DEFAULT_UNIFORM_BUFFER_SIZE);
+    SOKOL_ASSERT((_srq.desc.max_draws > 0) && (_srq.desc.uniform_buffer_size > 0));
+    _srq.draws = (srq_draw*) _srq_malloc((size_t)_srq.desc.max_draws * sizeof(srq_draw));
+    _srq.items = (_srq_item_t*) _srq_malloc((size_t)_srq.desc.max_draws * sizeof(_srq_item_t));
+    _srq.sort_tmp = (_srq_item_t*) _srq_malloc((size_t)_srq.desc.max_draws * sizeof(_srq_item_t));
+    _srq.uniforms = (uint8_t*) _srq_malloc((size_t)_srq.desc.uniform_buffer_size);
+    _srq_rank_map_init(&_srq.pipeline_ranks, _srq.desc.max_draws);
+    _srq_rank_map_init(&_srq.image_ranks, _srq.desc.max_draws);
+    _srq.valid = true;
+}
+
+void srq_shutdown(void) {
+    SOKOL_ASSERT(_srq.valid);
+    _srq_rank_map_discard(&_srq.image_ranks);
+    _srq_rank_map_discard(&_srq.pipeline_ranks);
+    _srq_free(_srq.uniforms);
+    _srq_free(_srq.sort_tmp);
+    _srq_free(_srq.items);
+    _srq_free(_srq.draws);
+    _srq.valid = false;
+}
+
+void srq_set_pass(int pass_index, const srq_pass_desc* desc) {
+    SOKOL_ASSERT(_srq.valid);
+    if ((pass_index < 0) || (pass_index >= SRQ_MAX_PASSES)) {
+        _SRQ_ERROR(PASS_INDEX_OUT_OF_RANGE);
+        return;
+    }
+    _srq_pass_t* pass = &_srq.passes[pass_index];
+    if (desc) {
+        pass->valid = true;
+        pass->desc = *desc;
+    }
+    else {
+        _srq_clear(pass, sizeof(_srq_pass_t));
+    }
+}
+
+uint64_t srq_make_key(int pass_index, const srq_draw* draw, float depth) {
+    SOKOL_ASSERT(_srq.valid);
+    SOKOL_ASSERT(draw);
+    SOKOL_ASSERT((pass_index >= 0) && (pass_index < SRQ_MAX_PASSES));
+    if (depth < 0.0f) {
+        depth = 0.0f;
+    }
+    else if (depth > 1.0f) {
+        depth = 1.0f;
+    }
+    const uint64_t pip = _srq_rank(&_srq.pipeline_ranks, draw->pipeline.id);
+    const uint64_t tex = _srq_rank(&_srq.image_ranks, draw->bindings.fs_images[0].id);
+    const uint64_t z = (uint64_t)(depth * (float)_SRQ_DEPTH_MASK) & _SRQ_DEPTH_MASK;
+    return ((uint64_t)pass_index << _SRQ_PASS_SHIFT) | (pip << _SRQ_PIPELINE_SHIFT) | (tex << _SRQ_TEXTURE_SHIFT) | z;
+}
+
+void srq_submit(uint64_t key, const srq_draw* draw) {
+    SOKOL_ASSERT(_srq.valid);
+    SOKOL_ASSERT(draw);
+    if (_srq.num_draws >= _srq.desc.max_draws) {
+        _SRQ_ERROR(DRAWS_FULL);
+        return;
+    }
+    srq_draw* dst = &_srq.draws[_srq.num_draws];
+    *dst = *draw;
+    dst->num_instances = _srq_def(dst->num_instances, 1);
+    const int uniform_pos = _srq.uniform_pos;
+    for (int ub_index = 0; ub_index < SG_MAX_SHADERSTAGE_UBS; ub_index++) {
+        if (!_srq_copy_uniforms(&dst->vs_uniforms[ub_index]) || !_srq_copy_uniforms(&dst->fs_uniforms[ub_index])) {
+            _srq.uniform_pos = uniform_pos;
+            _SRQ_ERROR(UNIFORMS_FULL);
+            return;
+        }
+    }
+    _srq.items[_srq.num_draws].key = key;
+    _srq.items[_srq.num_draws].draw_index = (uint32_t)_srq.num_draws;
+    _srq.num_draws++;
+}
+
+void srq_flush(void) {
+    SOKOL_ASSERT(_srq.valid);
+    _srq_clear(&_srq.stats, sizeof(_srq.stats));
+    const _srq_item_t* items = _srq.items;
+    const int num = _srq.num_draws;
+    if (num > 1) {
+        items = _srq_radix_sort(_srq.items, _srq.sort_tmp, num);
+    }
+    int i = 0;
+    for (int pass_index = 0; pass_index < SRQ_MAX_PASSES; pass_index++) {
+        const int first = i;
+        while ((i < num) && (_srq_pass_index(items[i].key) == pass_index)) {
+            i++;
+        }
+        const _srq_pass_t* pass = &_srq.passes[pass_index];
+        if (pass->valid) {
+            _srq_begin_pass(&pass->desc);
+            _srq_issue_draws(&items[first], i - first);
+            sg_end_pass();
+        }
+        else if (i > first) {
+            _srq.stats.num_dropped += i - first;
+            _SRQ_WARN(PASS_NOT_REGISTERED);
+        }
+    }
+    _srq.num_draws = 0;
+    _srq.uniform_pos = 0;
+    _srq_rank_map_reset(&_srq.pipeline_ranks);
+    _srq_rank_map_reset(&_srq.image_ranks);
+}
+
+srq_stats srq_query_stats(void) {
+    SOKOL_ASSERT(_srq.valid);
+    return _srq.stats;
+}
+
+#endif // SOKOL_RENDER_QUEUE_IMPL_INCLUDED
+#endif // SOKOL_RENDER_QUEUE_IMPL
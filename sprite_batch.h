@@ -0,0 +1,338 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+/*
+    sprite_batch.h -- batched textured sprites on top of sokol_gfx.h
+
+    Include sokol_gfx.h first, and do this:
+
+        #define SPRITE_BATCH_IMPL
+
+    before including this file in *one* C file to create the implementation.
+
+    Sprites are written into a CPU-side vertex array and appended to a stream
+    vertex buffer with sg_append_buffer(). A draw call is only issued when the
+    texture or pipeline changes, or when a batch is full. Since every sprite is
+    a quad with the same index pattern, the index buffer is immutable and
+    shared by all batches, each batch binds the vertex buffer at the offset
+    returned by sg_append_buffer() so the 16-bit indices restart at 0.
+
+    The vertex layout matches the inputs of the quad shader (quad.glsl):
+
+        location 0: float3 position
+        location 1: ubyte4n color
+        location 2: float2 uv
+
+    Sprite positions are in pixels with (0, 0) at the top-left corner of the
+    framebuffer and y pointing down. They are transformed into clip space
+    while the vertices are written, since the quad shader multiplies
+    (mvp * scale) component-wise with the position and thus can't express
+    a translation, the 'vs_params' uniform block is set to identity.
+
+    Usage:
+
+        sprite_batch_t batch;
+        sprite_batch_init(&batch, &(sprite_batch_desc_t){ .shader = quad_shader });  // false if out of memory
+
+        // each frame, inside a render pass:
+        sprite_batch_begin(&batch, width, height);
+        sprite_batch_draw(&batch, image, &(sprite_t){ ..., .color = SPRITE_COLOR_WHITE });
+        ...
+        sprite_batch_end(&batch);
+
+        // on exit, before sg_shutdown():
+        sprite_batch_shutdown(&batch);
+
+    Every sprite of a frame occupies its own space in the stream vertex
+    buffer, so desc.max_sprites is the maximum number of sprites per frame
+    (summed over all begin/end pairs). Sprites beyond that are dropped and
+    counted in sprite_batch_stats_t.num_dropped.
+
+    The sprite color is written to the vertices unchanged, a zero-initialized
+    sprite is transparent black. Use SPRITE_COLOR_WHITE to draw the texture
+    without a tint.
+*/
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SPRITE_BATCH_MAX_BATCH_SIZE (16384)     // 4 vertices per sprite, 16-bit indices
+#define SPRITE_COLOR_WHITE (0xFFFFFFFFu)        // no tint
+
+typedef struct
+{
+    float x, y;                 // top-left corner in pixels
+    float w, h;                 // size in pixels
+    float u0, v0;               // texture coordinates at the top-left corner
+    float u1, v1;               // texture coordinates at the bottom-right corner
+    uint32_t color;             // tint color as 0xAABBGGRR, usually SPRITE_COLOR_WHITE
+    float depth;                // z coordinate, only relevant with a depth-testing pipeline
+} sprite_t;
+
+typedef struct
+{
+    float pos[3];
+    uint32_t color;
+    float uv[2];
+} sprite_vertex_t;
+
+typedef struct
+{
+    sg_shader shader;           // the quad shader, required unless a pipeline is provided
+    sg_pipeline pipeline;       // optional, default: alpha-blended pipeline for the quad shader
+    int max_sprites;            // max sprites per frame, default: 262144
+    int batch_size;             // max sprites per draw call, default and max: SPRITE_BATCH_MAX_BATCH_SIZE
+} sprite_batch_desc_t;
+
+typedef struct
+{
+    int num_sprites;            // sprites drawn since sprite_batch_begin()
+    int num_draws;              // draw calls issued since sprite_batch_begin()
+    int num_dropped;            // sprites which didn't fit into the vertex buffer this frame
+} sprite_batch_stats_t;
+
+typedef struct
+{
+    sprite_batch_desc_t desc;
+    bool own_pipeline;
+    sg_buffer vbuf;
+    sg_buffer ibuf;
+    sg_pipeline pipeline;       // pipeline of the current batch
+    sg_pipeline applied_pipeline;
+    sg_image image;             // texture of the current batch
+    float scale_x, scale_y;     // pixels to clip space
+    int count;                  // number of sprites in the current batch
+    sprite_vertex_t* vertices;
+    sprite_batch_stats_t stats;
+} sprite_batch_t;
+
+bool sprite_batch_init(sprite_batch_t* batch, const sprite_batch_desc_t* desc);
+void sprite_batch_shutdown(sprite_batch_t* batch);
+void sprite_batch_begin(sprite_batch_t* batch, int width, int height);
+void sprite_batch_set_pipeline(sprite_batch_t* batch, sg_pipeline pipeline);
+void sprite_batch_draw(sprite_batch_t* batch, sg_image image, const sprite_t* sprite);
+void sprite_batch_end(sprite_batch_t* batch);
+sprite_batch_stats_t sprite_batch_stats(const sprite_batch_t* batch);
+
+#endif // SPRITE_BATCH_H
+
+#ifdef SPRITE_BATCH_IMPL
+#ifndef SPRITE_BATCH_IMPL_INCLUDED
+#define SPRITE_BATCH_IMPL_INCLUDED
+
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <assert.h>
+
+// must match the vs_params uniform block of the quad shader
+typedef struct
+{
+    float mvp[16];
+    float scale[4];
+} sprite_batch_params_t;
+
+bool sprite_batch_init(sprite_batch_t* batch, const sprite_batch_desc_t* desc)
+{
+    assert(batch && desc);
+    memset(batch, 0, sizeof(*batch));
+
+    batch->desc = *desc;
+
+    if (batch->desc.max_sprites <= 0)
+        batch->desc.max_sprites = 262144;
+
+    if ((batch->desc.batch_size <= 0) || (batch->desc.batch_size > SPRITE_BATCH_MAX_BATCH_SIZE))
+        batch->desc.batch_size = SPRITE_BATCH_MAX_BATCH_SIZE;
+
+    // the same two triangles for every quad
+    const int num_indices = 6 * batch->desc.batch_size;
+    uint16_t* indices = malloc(sizeof(uint16_t) * num_indices);
+    batch->vertices = malloc(sizeof(sprite_vertex_t) * 4 * batch->desc.batch_size);
+
+    if (!indices || !batch->vertices)
+    {
+        free(indices);
+        free(batch->vertices);
+        memset(batch, 0, sizeof(*batch));
+        return false;
+    }
+
+    batch->vbuf = sg_make_buffer(&(sg_buffer_desc){
+        .size  = sizeof(sprite_vertex_t) * 4 * batch->desc.max_sprites,
+        .type  = SG_BUFFERTYPE_VERTEXBUFFER,
+        .usage = SG_USAGE_STREAM,
+        .label = "sprite vertices"
+    });
+
+    for (int i = 0; i < batch->desc.batch_size; i++)
+    {
+        const uint16_t base = (uint16_t)(i * 4);
+        uint16_t* dst = indices + i * 6;
+        dst[0] = base + 0; dst[1] = base + 1; dst[2] = base + 2;
+        dst[3] = base + 0; dst[4] = base + 2; dst[5] = base + 3;
+    }
+
+    batch->ibuf = sg_make_buffer(&(sg_buffer_desc){
+        .type  = SG_BUFFERTYPE_INDEXBUFFER,
+        .data  = { .ptr = indices, .size = sizeof(uint16_t) * num_indices },
+        .label = "sprite indices"
+    });
+
+    free(indices);
+
+    if (batch->desc.pipeline.id == SG_INVALID_ID)
+    {
+        batch->desc.pipeline = sg_make_pipeline(&(sg_pipeline_desc){
+            .layout = {
+                .buffers[0].stride = sizeof(sprite_vertex_t),
+                .attrs = {
+                    [0] = { .format = SG_VERTEXFORMAT_FLOAT3,  .offset = offsetof(sprite_vertex_t, pos) },
+                    [1] = { .format = SG_VERTEXFORMAT_UBYTE4N, .offset = offsetof(sprite_vertex_t, color) },
+                    [2] = { .format = SG_VERTEXFORMAT_FLOAT2,  .offset = offsetof(sprite_vertex_t, uv) }
+                }
+            },
+            .shader = batch->desc.shader,
+            .index_type = SG_INDEXTYPE_UINT16,
+            .colors[0].blend = {
+                .enabled = true,
+                .src_factor_rgb = SG_BLENDFACTOR_SRC_ALPHA,
+                .dst_factor_rgb = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA
+            },
+            .label = "sprite pipeline"
+        });
+
+        batch->own_pipeline = true;
+    }
+
+    batch->pipeline = batch->desc.pipeline;
+    return true;
+}
+
+void sprite_batch_shutdown(sprite_batch_t* batch)
+{
+    assert(batch);
+
+    if (batch->own_pipeline)
+        sg_destroy_pipeline(batch->desc.pipeline);
+
+    sg_destroy_buffer(batch->ibuf);
+    sg_destroy_buffer(batch->vbuf);
+    free(batch->vertices);
+    memset(batch, 0, sizeof(*batch));
+}
+
+void sprite_batch_begin(sprite_batch_t* batch, int width, int height)
+{
+    assert(batch && (width > 0) && (height > 0));
+
+    batch->scale_x = 2.0f / (float)width;
+    batch->scale_y = -2.0f / (float)height;
+    memset(&batch->stats, 0, sizeof(batch->stats));
+    batch->applied_pipeline.id = SG_INVALID_ID;
+    batch->image.id = SG_INVALID_ID;
+    batch->count = 0;
+}
+
+static void sprite_batch_flush(sprite_batch_t* batch)
+{
+    if (batch->count == 0)
+        return;
+
+    const sg_range data = { .ptr = batch->vertices, .size = sizeof(sprite_vertex_t) * 4 * batch->count };
+    const int num_sprites = batch->count;
+    batch->count = 0;
+
+    if (sg_query_buffer_will_overflow(batch->vbuf, data.size))
+    {
+        batch->stats.num_dropped += num_sprites;
+        return;
+    }
+
+    const int offset = sg_append_buffer(batch->vbuf, &data);
+    const bool new_pipeline = (batch->pipeline.id != batch->applied_pipeline.id);
+
+    if (new_pipeline)
+    {
+        sg_apply_pipeline(batch->pipeline);
+        batch->applied_pipeline = batch->pipeline;
+    }
+
+    sg_apply_bindings(&(sg_bindings){
+        .vertex_buffers[0] = batch->vbuf,
+        .vertex_buffer_offsets[0] = offset,
+        .index_buffer = batch->ibuf,
+        .fs_images[0] = batch->image
+    });
+
+    if (new_pipeline)
+    {
+        const sprite_batch_params_t params = {
+            .mvp = { 1.0f, 0.0f, 0.0f, 0.0f,
+                     0.0f, 1.0f, 0.0f, 0.0f,
+                     0.0f, 0.0f, 1.0f, 0.0f,
+                     0.0f, 0.0f, 0.0f, 1.0f },
+            .scale = { 1.0f, 1.0f, 1.0f, 1.0f }
+        };
+
+        sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, &SG_RANGE(params));
+    }
+
+    sg_draw(0, 6 * num_sprites, 1);
+    batch->stats.num_draws++;
+}
+
+void sprite_batch_set_pipeline(sprite_batch_t* batch, sg_pipeline pipeline)
+{
+    assert(batch);
+
+    if (pipeline.id == SG_INVALID_ID)
+        pipeline = batch->desc.pipeline;
+
+    if (pipeline.id != batch->pipeline.id)
+    {
+        sprite_batch_flush(batch);
+        batch->pipeline = pipeline;
+    }
+}
+
+void sprite_batch_draw(sprite_batch_t* batch, sg_image image, const sprite_t* sprite)
+{
+    assert(batch && sprite);
+
+    if ((image.id != batch->image.id) || (batch->count == batch->desc.batch_size))
+    {
+        sprite_batch_flush(batch);
+        batch->image = image;
+    }
+
+    const float x0 = sprite->x * batch->scale_x - 1.0f;
+    const float y0 = sprite->y * batch->scale_y + 1.0f;
+    const float x1 = (sprite->x + sprite->w) * batch->scale_x - 1.0f;
+    const float y1 = (sprite->y + sprite->h) * batch->scale_y + 1.0f;
+    const float z = sprite->depth;
+    const uint32_t color = sprite->color;
+
+    sprite_vertex_t* v = batch->vertices + batch->count * 4;
+
+    v[0] = (sprite_vertex_t){ { x0, y0, z }, color, { sprite->u0, sprite->v0 } };
+    v[1] = (sprite_vertex_t){ { x1, y0, z }, color, { sprite->u1, sprite->v0 } };
+    v[2] = (sprite_vertex_t){ { x1, y1, z }, color, { sprite->u1, sprite->v1 } };
+    v[3] = (sprite_vertex_t){ { x0, y1, z }, color, { sprite->u0, sprite->v1 } };
+
+    batch->count++;
+    batch->stats.num_sprites++;
+}
+
+void sprite_batch_end(sprite_batch_t* batch)
+{
+    assert(batch);
+    sprite_batch_flush(batch);
+}
+
+sprite_batch_stats_t sprite_batch_stats(const sprite_batch_t* batch)
+{
+    assert(batch);
+    return batch->stats;
+}
+
+#endif // SPRITE_BATCH_IMPL_INCLUDED
+#endif // SPRITE_BATCH_IMPL
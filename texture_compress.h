@@ -0,0 +1,605 @@
+#ifndef TEXTURE_COMPRESS_H
+#define TEXTURE_COMPRESS_H
+/*
+    texture_compress.h -- BC1/BC3/BC4/BC5 block compression for sokol_gfx.h
+
+    Include sokol_gfx.h first, and do this:
+
+        #define TEXTURE_COMPRESS_IMPL
+
+    before including this file in *one* C file to create the implementation.
+
+    Decoded RGBA8 bitmaps (e.g. from stbi_load(..., 4)) are compressed into
+    4x4 pixel blocks at load time, the result goes through sokol_gfx's
+    glCompressedTexImage2D() path like any precompressed texture:
+
+        SG_PIXELFORMAT_BC1_RGBA     8 bytes per block, RGB plus 1-bit alpha
+        SG_PIXELFORMAT_BC3_RGBA     16 bytes per block, RGB plus 8-bit alpha
+        SG_PIXELFORMAT_BC4_R        8 bytes per block, the red channel
+        SG_PIXELFORMAT_BC5_RG       16 bytes per block, red and green
+
+    That is 4x (BC3, BC5) to 8x (BC1, BC4) less memory and sampling bandwidth
+    than RGBA8. The encoder only depends on sokol_gfx.h for the pixel format
+    enum, so it also works offline, e.g. in an asset build step that writes
+    the blocks to a file.
+
+    Colors are fitted along the principal axis of each block: the endpoints
+    start at the two pixels furthest apart along that axis and are refined
+    once with a least squares fit, then every pixel picks the closest of the
+    palette entries. Blocks with pixels below 50% alpha use BC1's 3-color mode,
+    which renders them transparent black. Alpha and the BC4/BC5 channels are
+    quantized between their block minimum and maximum.
+
+    Usage:
+
+        if (texture_compress_supported(SG_PIXELFORMAT_BC3_RGBA))
+        {
+            sg_image_desc desc = {
+                .width = w, .height = h,
+                .data.subimage[0][0] = { .ptr = pixels, .size = w * h * 4 }
+            };
+
+            void* blocks = texture_compress_image(&desc, SG_PIXELFORMAT_BC3_RGBA);
+            sg_image img = sg_make_image(&desc);
+            free(blocks);
+        }
+
+    texture_compress_image() turns an RGBA8 image desc into a compressed one:
+    it compresses every face and mipmap, rewrites the pixel format and data
+    pointers and returns the memory of all blocks, which must outlive the
+    image creation and is released with free(). It returns NULL and leaves
+    the desc unchanged if the format can't be encoded or memory allocation
+    fails. With desc.generate_mipmaps set, it builds the mipmap chain from
+    the top level with a 2x2 box filter before compressing, since sokol_gfx
+    can't generate mipmaps for compressed formats. It only calls
+    sg_query_srgb_tables() into sokol_gfx and can run on any thread.
+
+    Like sokol_gfx's own CPU mipmaps, SRGB8A8 sources are averaged as linear
+    colors and RGBA8 sources as stored. sokol_gfx has no sRGB variants of the
+    BC formats, so the blocks of an SRGB8A8 source are sampled without sRGB
+    decoding.
+
+    texture_compress_supported() asks sokol_gfx whether the GPU can sample
+    the format, call it on the thread which owns the sokol_gfx context and
+    keep uploading RGBA8 if it returns false.
+*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+bool texture_compress_supported(sg_pixel_format format);
+size_t texture_compress_size(sg_pixel_format format, int width, int height);
+bool texture_compress(sg_pixel_format format, const void* pixels, int width, int height, void* blocks);
+void* texture_compress_image(sg_image_desc* desc, sg_pixel_format format);
+
+#endif // TEXTURE_COMPRESS_H
+
+#ifdef TEXTURE_COMPRESS_IMPL
+#ifndef TEXTURE_COMPRESS_IMPL_INCLUDED
+#define TEXTURE_COMPRESS_IMPL_INCLUDED
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+
+static int texture_compress_block_size(sg_pixel_format format)
+{
+    switch (format)
+    {
+        case SG_PIXELFORMAT_BC1_RGBA:
+        case SG_PIXELFORMAT_BC4_R:
+            return 8;
+
+        case SG_PIXELFORMAT_BC3_RGBA:
+        case SG_PIXELFORMAT_BC5_RG:
+            return 16;
+
+        default:
+            return 0;
+    }
+}
+
+bool texture_compress_supported(sg_pixel_format format)
+{
+    return (texture_compress_block_size(format) > 0) && sg_query_pixelformat(format).sample;
+}
+
+size_t texture_compress_size(sg_pixel_format format, int width, int height)
+{
+    const int blocks_x = (width + 3) / 4;
+    const int blocks_y = (height + 3) / 4;
+    return (size_t)blocks_x * (size_t)blocks_y * (size_t)texture_compress_block_size(format);
+}
+
+static uint16_t texture_compress_to_565(const float* color)
+{
+    int r = (int)(color[0] * (31.0f / 255.0f) + 0.5f);
+    int g = (int)(color[1] * (63.0f / 255.0f) + 0.5f);
+    int b = (int)(color[2] * (31.0f / 255.0f) + 0.5f);
+
+    r = r < 0 ? 0 : (r > 31 ? 31 : r);
+    g = g < 0 ? 0 : (g > 63 ? 63 : g);
+    b = b < 0 ? 0 : (b > 31 ? 31 : b);
+
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static void texture_compress_from_565(uint16_t c, int* color)
+{
+    const int r = (c >> 11) & 31;
+    const int g = (c >> 5) & 63;
+    const int b = c & 31;
+
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// Picks the closest palette entry for every pixel, transparent pixels get index 3 in 3-color mode
+static uint32_t texture_compress_color_indices(const uint8_t* block, uint16_t c0, uint16_t c1, bool three_color)
+{
+    int palette[4][3];
+    texture_compress_from_565(c0, palette[0]);
+    texture_compress_from_565(c1, palette[1]);
+
+    for (int c = 0; c < 3; c++)
+    {
+        if (three_color)
+        {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+        else
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+    }
+
+    const int num_colors = three_color ? 3 : 4;
+    uint32_t indices = 0;
+
+    for (int i = 0; i < 16; i++)
+    {
+        const uint8_t* p = block + i * 4;
+        int best = 0;
+
+        if (three_color && (p[3] < 128))
+        {
+            best = 3;
+        }
+        else
+        {
+            int best_dist = 0x7FFFFFFF;
+
+            for (int j = 0; j < num_colors; j++)
+            {
+                const int dr = p[0] - palette[j][0];
+                const int dg = p[1] - palette[j][1];
+                const int db = p[2] - palette[j][2];
+                const int dist = dr * dr + dg * dg + db * db;
+
+                if (dist < best_dist)
+                {
+                    best_dist = dist;
+                    best = j;
+                }
+            }
+        }
+
+        indices |= (uint32_t)best << (2 * i);
+    }
+
+    return indices;
+}
+
+// A BC1 color block, BC3 blocks always use 4-color mode
+static void texture_compress_color_block(const uint8_t* block, bool allow_alpha, uint8_t* dst)
+{
+    bool three_color = false;
+
+    if (allow_alpha)
+    {
+        for (int i = 0; i < 16; i++)
+            three_color |= (block[i * 4 + 3] < 128);
+    }
+
+    // mean and covariance of the opaque pixels
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    int count = 0;
+
+    for (int i = 0; i < 16; i++)
+    {
+        const uint8_t* p = block + i * 4;
+
+        if (three_color && (p[3] < 128))
+            continue;
+
+        mean[0] += p[0]; mean[1] += p[1]; mean[2] += p[2];
+        count++;
+    }
+
+    if (count == 0)
+    {
+        // fully transparent, every pixel gets the transparent index
+        memset(dst, 0, 4);
+        memset(dst + 4, 0xFF, 4);
+        return;
+    }
+
+    for (int c = 0; c < 3; c++)
+        mean[c] /= (float)count;
+
+    float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+    for (int i = 0; i < 16; i++)
+    {
+        const uint8_t* p = block + i * 4;
+
+        if (three_color && (p[3] < 128))
+            continue;
+
+        const float r = p[0] - mean[0], g = p[1] - mean[1], b = p[2] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+        cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+    }
+
+    // principal axis by power iteration, starting from the luminance direction
+    float axis[3] = { 0.299f, 0.587f, 0.114f };
+
+    for (int iter = 0; iter < 4; iter++)
+    {
+        const float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        const float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        const float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float len = x * x + y * y + z * z;
+
+        if (len < 1e-6f)
+            break;
+
+        len = 1.0f / sqrtf(len);
+        axis[0] = x * len; axis[1] = y * len; axis[2] = z * len;
+    }
+
+    // the pixels furthest apart along the axis are the initial endpoints
+    float min_dot = 1e9f, max_dot = -1e9f;
+    float end0[3] = { mean[0], mean[1], mean[2] };
+    float end1[3] = { mean[0], mean[1], mean[2] };
+
+    for (int i = 0; i < 16; i++)
+    {
+        const uint8_t* p = block + i * 4;
+
+        if (three_color && (p[3] < 128))
+            continue;
+
+        const float d = p[0] * axis[0] + p[1] * axis[1] + p[2] * axis[2];
+
+        if (d < min_dot)
+        {
+            min_dot = d;
+            end1[0] = p[0]; end1[1] = p[1]; end1[2] = p[2];
+        }
+
+        if (d > max_dot)
+        {
+            max_dot = d;
+            end0[0] = p[0]; end0[1] = p[1]; end0[2] = p[2];
+        }
+    }
+
+    // least squares refinement: every pixel is a blend of the endpoints with
+    // the weight of its palette position along the axis
+    if (max_dot - min_dot > 1e-3f)
+    {
+        const float steps = three_color ? 2.0f : 3.0f;
+        float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+        float ax[3] = { 0.0f, 0.0f, 0.0f };
+        float bx[3] = { 0.0f, 0.0f, 0.0f };
+
+        for (int i = 0; i < 16; i++)
+        {
+            const uint8_t* p = block + i * 4;
+
+            if (three_color && (p[3] < 128))
+                continue;
+
+            const float d = p[0] * axis[0] + p[1] * axis[1] + p[2] * axis[2];
+            const float t = (float)(int)((d - min_dot) / (max_dot - min_dot) * steps + 0.5f) / steps;
+            const float s = 1.0f - t;
+
+            aa += t * t; ab += t * s; bb += s * s;
+
+            for (int c = 0; c < 3; c++)
+            {
+                ax[c] += t * p[c];
+                bx[c] += s * p[c];
+            }
+        }
+
+        const float det = aa * bb - ab * ab;
+
+        if (det > 1e-3f)
+        {
+            const float inv = 1.0f / det;
+
+            for (int c = 0; c < 3; c++)
+            {
+                end0[c] = (ax[c] * bb - bx[c] * ab) * inv;
+                end1[c] = (bx[c] * aa - ax[c] * ab) * inv;
+            }
+        }
+    }
+
+    uint16_t c0 = texture_compress_to_565(end0);
+    uint16_t c1 = texture_compress_to_565(end1);
+
+    // the endpoint order selects the mode: c0 > c1 is 4-color, c0 <= c1 is 3-color
+    if ((three_color && (c0 > c1)) || (!three_color && (c0 < c1)))
+    {
+        const uint16_t tmp = c0;
+        c0 = c1;
+        c1 = tmp;
+    }
+
+    const uint32_t indices = (!three_color && (c0 == c1)) ? 0 : texture_compress_color_indices(block, c0, c1, three_color);
+
+    dst[0] = (uint8_t)(c0 & 0xFF); dst[1] = (uint8_t)(c0 >> 8);
+    dst[2] = (uint8_t)(c1 & 0xFF); dst[3] = (uint8_t)(c1 >> 8);
+    dst[4] = (uint8_t)(indices & 0xFF);
+    dst[5] = (uint8_t)((indices >> 8) & 0xFF);
+    dst[6] = (uint8_t)((indices >> 16) & 0xFF);
+    dst[7] = (uint8_t)(indices >> 24);
+}
+
+// A BC4 block of one channel, also the alpha block of BC3 and the halves of BC5
+static void texture_compress_channel_block(const uint8_t* block, int channel, uint8_t* dst)
+{
+    int lo = 255, hi = 0;
+
+    for (int i = 0; i < 16; i++)
+    {
+        const int v = block[i * 4 + channel];
+        lo = v < lo ? v : lo;
+        hi = v > hi ? v : hi;
+    }
+
+    dst[0] = (uint8_t)hi;
+    dst[1] = (uint8_t)lo;
+
+    // hi > lo selects the 8-value mode, position k between lo (0) and hi (7)
+    // is index 1 for lo, 0 for hi and 8 - k in between
+    uint64_t indices = 0;
+
+    if (hi > lo)
+    {
+        const int range = hi - lo;
+
+        for (int i = 0; i < 16; i++)
+        {
+            const int k = ((block[i * 4 + channel] - lo) * 7 + range / 2) / range;
+            const int index = (k == 0) ? 1 : ((k == 7) ? 0 : 8 - k);
+            indices |= (uint64_t)index << (3 * i);
+        }
+    }
+
+    for (int i = 0; i < 6; i++)
+        dst[2 + i] = (uint8_t)(indices >> (8 * i));
+}
+
+bool texture_compress(sg_pixel_format format, const void* pixels, int width, int height, void* blocks)
+{
+    assert(pixels && blocks && (width > 0) && (height > 0));
+
+    const int block_size = texture_compress_block_size(format);
+
+    if (block_size == 0)
+        return false;
+
+    const uint8_t* src = pixels;
+    uint8_t* dst = blocks;
+    uint8_t block[16 * 4];
+
+    for (int by = 0; by < height; by += 4)
+    {
+        for (int bx = 0; bx < width; bx += 4)
+        {
+            // blocks past the right or bottom edge repeat the last column or row
+            for (int y = 0; y < 4; y++)
+            {
+                const int sy = (by + y) < height ? (by + y) : (height - 1);
+
+                for (int x = 0; x < 4; x++)
+                {
+                    const int sx = (bx + x) < width ? (bx + x) : (width - 1);
+                    memcpy(block + (y * 4 + x) * 4, src + ((size_t)sy * width + sx) * 4, 4);
+                }
+            }
+
+            switch (format)
+            {
+                case SG_PIXELFORMAT_BC1_RGBA:
+                    texture_compress_color_block(block, true, dst);
+                    break;
+
+                case SG_PIXELFORMAT_BC3_RGBA:
+                    texture_compress_channel_block(block, 3, dst);
+                    texture_compress_color_block(block, false, dst + 8);
+                    break;
+
+                case SG_PIXELFORMAT_BC4_R:
+                    texture_compress_channel_block(block, 0, dst);
+                    break;
+
+                default:
+                    texture_compress_channel_block(block, 0, dst);
+                    texture_compress_channel_block(block, 1, dst + 8);
+                    break;
+            }
+
+            dst += block_size;
+        }
+    }
+
+    return true;
+}
+
+// 2x2 box filter for the mipmap chain, odd sizes drop the last row or column,
+// with to_linear and to_srgb the color channels are averaged as 12-bit linear values
+static void texture_compress_downsample(const uint8_t* src, int src_w, int src_h, uint8_t* dst, int dst_w, int dst_h,
+                                        const uint16_t* to_linear, const uint8_t* to_srgb)
+{
+    for (int y = 0; y < dst_h; y++)
+    {
+        const uint8_t* row0 = src + (size_t)(2 * y < src_h ? 2 * y : src_h - 1) * src_w * 4;
+        const uint8_t* row1 = src + (size_t)(2 * y + 1 < src_h ? 2 * y + 1 : src_h - 1) * src_w * 4;
+
+        for (int x = 0; x < dst_w; x++)
+        {
+            const int x0 = (2 * x < src_w ? 2 * x : src_w - 1) * 4;
+            const int x1 = (2 * x + 1 < src_w ? 2 * x + 1 : src_w - 1) * 4;
+
+            uint8_t* out = dst + (y * dst_w + x) * 4;
+
+            if (to_linear)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    const int sum = to_linear[row0[x0 + c]] + to_linear[row0[x1 + c]] + to_linear[row1[x0 + c]] + to_linear[row1[x1 + c]];
+                    out[c] = to_srgb[(sum + 2) >> 2];
+                }
+
+                out[3] = (uint8_t)((row0[x0 + 3] + row0[x1 + 3] + row1[x0 + 3] + row1[x1 + 3] + 2) >> 2);
+            }
+            else
+            {
+                for (int c = 0; c < 4; c++)
+                    out[c] = (uint8_t)((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+            }
+        }
+    }
+}
+
+void* texture_compress_image(sg_image_desc* desc, sg_pixel_format format)
+{
+    assert(desc && (desc->width > 0) && (desc->height > 0));
+    assert((desc->pixel_format == _SG_PIXELFORMAT_DEFAULT) || (desc->pixel_format == SG_PIXELFORMAT_RGBA8) ||
+           (desc->pixel_format == SG_PIXELFORMAT_SRGB8A8));
+
+    if (texture_compress_block_size(format) == 0)
+        return NULL;
+
+    const bool gen_mipmaps = (desc->generate_mipmaps != _SG_MIPMAPGEN_DEFAULT) && (desc->generate_mipmaps != SG_MIPMAPGEN_NONE);
+    int num_mipmaps = desc->num_mipmaps;
+
+    if (gen_mipmaps && (num_mipmaps <= 0))
+    {
+        const int size = desc->width > desc->height ? desc->width : desc->height;
+        num_mipmaps = 1;
+
+        while (((size >> num_mipmaps) > 0) && (num_mipmaps < SG_MAX_MIPMAPS))
+            num_mipmaps++;
+    }
+
+    if (num_mipmaps <= 0)
+        num_mipmaps = 1;
+
+    const int num_faces = (desc->type == SG_IMAGETYPE_CUBE) ? 6 : 1;
+    size_t total_size = 0;
+
+    for (int mip = 0; mip < num_mipmaps; mip++)
+    {
+        const int w = (desc->width >> mip) > 0 ? (desc->width >> mip) : 1;
+        const int h = (desc->height >> mip) > 0 ? (desc->height >> mip) : 1;
+        total_size += texture_compress_size(format, w, h);
+    }
+
+    uint8_t* mem = malloc(total_size * num_faces);
+
+    if (!mem)
+        return NULL;
+
+    // generated levels are downsampled from the previous uncompressed level,
+    // alternating between two scratch buffers the size of the second level
+    uint8_t* scratch = NULL;
+    uint8_t* levels[2] = { NULL, NULL };
+
+    if (gen_mipmaps && (num_mipmaps > 1))
+    {
+        const int w = (desc->width >> 1) > 0 ? (desc->width >> 1) : 1;
+        const int h = (desc->height >> 1) > 0 ? (desc->height >> 1) : 1;
+        scratch = malloc((size_t)w * h * 4 * 2);
+
+        if (!scratch)
+        {
+            free(mem);
+            return NULL;
+        }
+
+        levels[0] = scratch;
+        levels[1] = scratch + (size_t)w * h * 4;
+    }
+
+    // the same sRGB <-> 12-bit linear tables as sokol_gfx's CPU mipmaps
+    const sg_srgb_tables tables = sg_query_srgb_tables();
+    uint8_t to_srgb[4096];
+    const bool srgb = gen_mipmaps && (desc->pixel_format == SG_PIXELFORMAT_SRGB8A8);
+
+    if (srgb)
+    {
+        int c = 0;
+
+        for (int i = 0; i < 4096; i++)
+        {
+            while ((c < 255) && (i >= tables.from_linear[c + 1]))
+                c++;
+
+            to_srgb[i] = (uint8_t)c;
+        }
+    }
+
+    uint8_t* dst = mem;
+
+    for (int face = 0; face < num_faces; face++)
+    {
+        const uint8_t* src = desc->data.subimage[face][0].ptr;
+
+        for (int mip = 0; mip < num_mipmaps; mip++)
+        {
+            const int w = (desc->width >> mip) > 0 ? (desc->width >> mip) : 1;
+            const int h = (desc->height >> mip) > 0 ? (desc->height >> mip) : 1;
+
+            if (mip > 0)
+            {
+                if (gen_mipmaps)
+                {
+                    const int src_w = (desc->width >> (mip - 1)) > 0 ? (desc->width >> (mip - 1)) : 1;
+                    const int src_h = (desc->height >> (mip - 1)) > 0 ? (desc->height >> (mip - 1)) : 1;
+                    texture_compress_downsample(src, src_w, src_h, levels[mip & 1], w, h,
+                                                srgb ? tables.to_linear : NULL, srgb ? to_srgb : NULL);
+                    src = levels[mip & 1];
+                }
+                else
+                {
+                    src = desc->data.subimage[face][mip].ptr;
+                }
+            }
+
+            const size_t size = texture_compress_size(format, w, h);
+            texture_compress(format, src, w, h, dst);
+            desc->data.subimage[face][mip] = (sg_range){ .ptr = dst, .size = size };
+            dst += size;
+        }
+    }
+
+    free(scratch);
+
+    desc->pixel_format = format;
+    desc->num_mipmaps = num_mipmaps;
+    desc->generate_mipmaps = SG_MIPMAPGEN_NONE;
+    return mem;
+}
+
+#endif // TEXTURE_COMPRESS_IMPL_INCLUDED
+#endif // TEXTURE_COMPRESS_IMPL
@@ -0,0 +1,614 @@
+#if defined(TEXTURE_STREAM_IMPL) && defined(__STRICT_ANSI__) && !defined(_POSIX_C_SOURCE) && !defined(_WIN32) && !defined(__APPLE__)
+#define _POSIX_C_SOURCE 199309L // clock_gettime(CLOCK_MONOTONIC) under -std=c99
+#endif
+#ifndef TEXTURE_STREAM_H
+#define TEXTURE_STREAM_H
+/*
+    texture_stream.h -- background texture loading on top of sokol_gfx.h
+
+    Include sokol_gfx.h, stb_image.h and texture_compress.h first, and do this:
+
+        #define TEXTURE_STREAM_IMPL
+
+    before including this file in *one* C file to create the implementation.
+
+    texture_stream_load() returns an image handle right away, in ALLOC state.
+    A pool of decoder threads loads the file with stb_image and hands the
+    pixels to sg_queue_init_image(), and sokol_gfx initializes the image in
+    sg_commit() within its per-frame time budget (sg_desc.init_queue_budget_us).
+    No decoding or uploading happens on the calling thread, so loading a batch
+    of textures doesn't stall the frame.
+
+    Until the image is VALID, texture_stream_image() returns a placeholder
+    texture, pass every handle through it when drawing:
+
+        texture_stream_t stream;
+        if (!texture_stream_init(&stream, &(texture_stream_desc_t){ .flip_vertically = true }))
+            return false;   // out of memory, threads or commit listeners, the stream is left zeroed
+
+        sg_image img = texture_stream_load(&stream, "boomer.png");
+
+        // when drawing:
+        bind.fs_images[0] = texture_stream_image(&stream, img);
+
+        // on exit, before sg_shutdown():
+        texture_stream_shutdown(&stream);
+
+    Decoded pixels must outlive the queued sg_image_desc, the stream frees them
+    from a commit listener once the image has left the ALLOC state. A file that
+    fails to load puts the image into FAILED state, it keeps showing the
+    placeholder.
+
+    With desc.compress set to one of the formats of texture_compress.h, the
+    decoder threads also compress the pixels (and generated mipmaps) into
+    blocks before queueing them. If the GPU can't sample that format, images
+    are uploaded as RGBA8.
+
+    At most desc.max_jobs images can be in flight, texture_stream_load()
+    returns an invalid handle when all are taken or memory runs out. The
+    images belong to the caller, destroying one that is still loading is
+    fine.
+
+    The decoder threads are timed with clock_gettime(CLOCK_MONOTONIC) on POSIX
+    platforms. Under -std=c99 this file defines _POSIX_C_SOURCE to get it,
+    which only works before the first system header: either include it (or
+    sokol_gfx.h with its implementation) ahead of them, or define
+    _POSIX_C_SOURCE=199309L on the command line.
+*/
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct
+{
+    int num_threads;            // decoder threads, default: 2
+    int max_jobs;               // max images in flight, default: 64
+    bool flip_vertically;       // flip images on load, like stbi_set_flip_vertically_on_load()
+    sg_filter min_filter;       // filters of the loaded images, default: sokol_gfx default
+    sg_filter mag_filter;
+    sg_mipmap_gen generate_mipmaps; // mipmaps of the loaded images, default: none
+    sg_pixel_format compress;   // block compression on the decoder threads, see texture_compress.h, default: none
+    sg_image placeholder;       // shown while loading, default: grey checkerboard
+} texture_stream_desc_t;
+
+typedef struct
+{
+    int num_pending;            // waiting for or being decoded
+    int num_decoded;            // waiting for sg_commit() to create the image
+    int num_loaded;
+    int num_failed;
+    double decode_ms;           // time spent decoding, summed over all threads
+    double compress_ms;         // time spent compressing, summed over all threads
+} texture_stream_stats_t;
+
+typedef struct texture_stream_job_t texture_stream_job_t;
+typedef struct texture_stream_impl_t texture_stream_impl_t;
+
+typedef struct
+{
+    texture_stream_desc_t desc;
+    bool own_placeholder;
+    texture_stream_impl_t* impl;
+} texture_stream_t;
+
+bool texture_stream_init(texture_stream_t* stream, const texture_stream_desc_t* desc);
+void texture_stream_shutdown(texture_stream_t* stream);
+sg_image texture_stream_load(texture_stream_t* stream, const char* path);
+sg_image texture_stream_image(const texture_stream_t* stream, sg_image image);
+texture_stream_stats_t texture_stream_stats(const texture_stream_t* stream);
+
+#endif // TEXTURE_STREAM_H
+
+#ifdef TEXTURE_STREAM_IMPL
+#ifndef TEXTURE_STREAM_IMPL_INCLUDED
+#define TEXTURE_STREAM_IMPL_INCLUDED
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+    typedef CRITICAL_SECTION texture_stream_mutex_t;
+    typedef CONDITION_VARIABLE texture_stream_cond_t;
+    typedef HANDLE texture_stream_thread_t;
+#else
+    #include <pthread.h>
+    #include <time.h>
+    #if !defined(CLOCK_MONOTONIC)
+    #error "texture_stream.h: clock_gettime() is unavailable, define _POSIX_C_SOURCE=199309L"
+    #endif
+    typedef pthread_mutex_t texture_stream_mutex_t;
+    typedef pthread_cond_t texture_stream_cond_t;
+    typedef pthread_t texture_stream_thread_t;
+#endif
+
+typedef enum
+{
+    TEXTURE_STREAM_JOB_FREE,
+    TEXTURE_STREAM_JOB_QUEUED,      // waiting for a decoder thread
+    TEXTURE_STREAM_JOB_DECODING,
+    TEXTURE_STREAM_JOB_DECODED,     // sokol_gfx's init queue was full, retried after sg_commit()
+    TEXTURE_STREAM_JOB_UPLOADING,   // in sokol_gfx's init queue
+    TEXTURE_STREAM_JOB_FAILED
+} texture_stream_job_state_t;
+
+struct texture_stream_job_t
+{
+    texture_stream_job_state_t state;
+    sg_image image;
+    char* path;
+    unsigned char* pixels;
+    void* blocks;                   // compressed pixels, from texture_compress_image()
+    sg_image_desc image_desc;
+};
+
+struct texture_stream_impl_t
+{
+    texture_stream_mutex_t mutex;
+    texture_stream_cond_t cond;
+    texture_stream_thread_t* threads;
+    bool quit;
+    texture_stream_job_t* jobs;
+    int* queue;                     // FIFO of job indices waiting for a decoder thread
+    int queue_head, queue_count;
+    texture_stream_stats_t stats;
+    texture_stream_desc_t desc;
+};
+
+static void texture_stream_lock(texture_stream_impl_t* impl)
+{
+    #if defined(_WIN32)
+        EnterCriticalSection(&impl->mutex);
+    #else
+        pthread_mutex_lock(&impl->mutex);
+    #endif
+}
+
+static void texture_stream_unlock(texture_stream_impl_t* impl)
+{
+    #if defined(_WIN32)
+        LeaveCriticalSection(&impl->mutex);
+    #else
+        pthread_mutex_unlock(&impl->mutex);
+    #endif
+}
+
+static void texture_stream_wait(texture_stream_impl_t* impl)
+{
+    #if defined(_WIN32)
+        SleepConditionVariableCS(&impl->cond, &impl->mutex, INFINITE);
+    #else
+        pthread_cond_wait(&impl->cond, &impl->mutex);
+    #endif
+}
+
+static void texture_stream_wake(texture_stream_impl_t* impl, bool all)
+{
+    #if defined(_WIN32)
+        if (all)
+            WakeAllConditionVariable(&impl->cond);
+        else
+            WakeConditionVariable(&impl->cond);
+    #else
+        if (all)
+            pthread_cond_broadcast(&impl->cond);
+        else
+            pthread_cond_signal(&impl->cond);
+    #endif
+}
+
+static double texture_stream_now_ms(void)
+{
+    #if defined(_WIN32)
+        LARGE_INTEGER freq, counter;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&counter);
+        return (double)counter.QuadPart * 1000.0 / (double)freq.QuadPart;
+    #else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+    #endif
+}
+
+// Hands a decoded image to sokol_gfx, called with the mutex held
+static void texture_stream_queue_upload(texture_stream_job_t* job)
+{
+    const bool queued = sg_queue_init_image(job->image, &job->image_desc);
+    job->state = queued ? TEXTURE_STREAM_JOB_UPLOADING : TEXTURE_STREAM_JOB_DECODED;
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI texture_stream_thread(LPVOID arg)
+#else
+static void* texture_stream_thread(void* arg)
+#endif
+{
+    texture_stream_impl_t* impl = arg;
+
+    stbi_set_flip_vertically_on_load_thread(impl->desc.flip_vertically);
+
+    texture_stream_lock(impl);
+
+    while (true)
+    {
+        while (!impl->quit && (impl->queue_count == 0))
+            texture_stream_wait(impl);
+
+        if (impl->quit)
+            break;
+
+        texture_stream_job_t* job = &impl->jobs[impl->queue[impl->queue_head]];
+        impl->queue_head = (impl->queue_head + 1) % impl->desc.max_jobs;
+        impl->queue_count--;
+        job->state = TEXTURE_STREAM_JOB_DECODING;
+
+        texture_stream_unlock(impl);
+
+        const double start = texture_stream_now_ms();
+        int w = 0, h = 0, c = 0;
+        unsigned char* pixels = stbi_load(job->path, &w, &h, &c, 4);
+        const double decode_ms = texture_stream_now_ms() - start;
+
+        sg_image_desc image_desc = {
+            .width = w,
+            .height = h,
+            .pixel_format = SG_PIXELFORMAT_RGBA8,
+            .min_filter = impl->desc.min_filter,
+            .mag_filter = impl->desc.mag_filter,
+            .generate_mipmaps = impl->desc.generate_mipmaps,
+            .data.subimage[0][0] = { .ptr = pixels, .size = (size_t)w * h * 4 }
+        };
+
+        void* blocks = NULL;
+        double compress_ms = 0.0;
+
+        if (pixels && (impl->desc.compress != SG_PIXELFORMAT_NONE))
+        {
+            const double compress_start = texture_stream_now_ms();
+            blocks = texture_compress_image(&image_desc, impl->desc.compress);
+            compress_ms = texture_stream_now_ms() - compress_start;
+            stbi_image_free(pixels);
+            pixels = NULL;
+        }
+
+        texture_stream_lock(impl);
+
+        impl->stats.decode_ms += decode_ms;
+        impl->stats.compress_ms += compress_ms;
+        free(job->path);
+        job->path = NULL;
+
+        if (pixels || blocks)
+        {
+            job->pixels = pixels;
+            job->blocks = blocks;
+            job->image_desc = image_desc;
+            texture_stream_queue_upload(job);
+        }
+        else
+        {
+            job->state = TEXTURE_STREAM_JOB_FAILED;
+        }
+    }
+
+    texture_stream_unlock(impl);
+    return 0;
+}
+
+static void texture_stream_free_job(texture_stream_job_t* job)
+{
+    free(job->path);
+    stbi_image_free(job->pixels);
+    free(job->blocks);
+    memset(job, 0, sizeof(*job));
+}
+
+// Runs at the end of sg_commit(), after sokol_gfx worked through its init queue
+static void texture_stream_on_commit(void* user_data)
+{
+    texture_stream_impl_t* impl = user_data;
+
+    texture_stream_lock(impl);
+
+    for (int i = 0; i < impl->desc.max_jobs; i++)
+    {
+        texture_stream_job_t* job = &impl->jobs[i];
+
+        switch (job->state)
+        {
+            case TEXTURE_STREAM_JOB_DECODED:
+                texture_stream_queue_upload(job);
+                break;
+
+            case TEXTURE_STREAM_JOB_UPLOADING:
+            {
+                const sg_resource_state state = sg_query_image_state(job->image);
+
+                if (state == SG_RESOURCESTATE_ALLOC)
+                    break;
+
+                if (state == SG_RESOURCESTATE_VALID)
+                    impl->stats.num_loaded++;
+                else
+                    impl->stats.num_failed++;
+
+                texture_stream_free_job(job);
+                break;
+            }
+
+            case TEXTURE_STREAM_JOB_FAILED:
+                if (sg_query_image_state(job->image) == SG_RESOURCESTATE_ALLOC)
+                    sg_fail_image(job->image);
+
+                impl->stats.num_failed++;
+                texture_stream_free_job(job);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    texture_stream_unlock(impl);
+}
+
+// Tells the first num_threads decoder threads to quit and waits for them
+static void texture_stream_stop_threads(texture_stream_impl_t* impl, int num_threads)
+{
+    texture_stream_lock(impl);
+    impl->quit = true;
+    texture_stream_wake(impl, true);
+    texture_stream_unlock(impl);
+
+    for (int i = 0; i < num_threads; i++)
+    {
+        #if defined(_WIN32)
+            WaitForSingleObject(impl->threads[i], INFINITE);
+            CloseHandle(impl->threads[i]);
+        #else
+            pthread_join(impl->threads[i], NULL);
+        #endif
+    }
+}
+
+static void texture_stream_destroy_mutex(texture_stream_impl_t* impl)
+{
+    #if defined(_WIN32)
+        DeleteCriticalSection(&impl->mutex);
+    #else
+        pthread_cond_destroy(&impl->cond);
+        pthread_mutex_destroy(&impl->mutex);
+    #endif
+}
+
+// Frees the placeholder and the impl, if any, and zeroes the stream
+static void texture_stream_free(texture_stream_t* stream, texture_stream_impl_t* impl)
+{
+    if (stream->own_placeholder)
+        sg_destroy_image(stream->desc.placeholder);
+
+    if (impl)
+    {
+        free(impl->threads);
+        free(impl->queue);
+        free(impl->jobs);
+        free(impl);
+    }
+
+    memset(stream, 0, sizeof(*stream));
+}
+
+bool texture_stream_init(texture_stream_t* stream, const texture_stream_desc_t* desc)
+{
+    assert(stream && desc);
+    memset(stream, 0, sizeof(*stream));
+
+    stream->desc = *desc;
+
+    if (stream->desc.num_threads <= 0)
+        stream->desc.num_threads = 2;
+
+    if (stream->desc.max_jobs <= 0)
+        stream->desc.max_jobs = 64;
+
+    if ((stream->desc.compress == _SG_PIXELFORMAT_DEFAULT) || !texture_compress_supported(stream->desc.compress))
+        stream->desc.compress = SG_PIXELFORMAT_NONE;
+
+    if (stream->desc.placeholder.id == SG_INVALID_ID)
+    {
+        uint32_t pixels[4 * 4];
+
+        for (int i = 0; i < 16; i++)
+            pixels[i] = (((i & 3) ^ (i >> 2)) & 1) ? 0xFF808080 : 0xFFC0C0C0;
+
+        stream->desc.placeholder = sg_make_image(&(sg_image_desc){
+            .width = 4,
+            .height = 4,
+            .data.subimage[0][0] = SG_RANGE(pixels),
+            .label = "texture stream placeholder"
+        });
+
+        stream->own_placeholder = true;
+    }
+
+    texture_stream_impl_t* impl = calloc(1, sizeof(texture_stream_impl_t));
+
+    if (!impl)
+    {
+        texture_stream_free(stream, NULL);
+        return false;
+    }
+
+    impl->desc = stream->desc;
+    impl->jobs = calloc(impl->desc.max_jobs, sizeof(texture_stream_job_t));
+    impl->queue = calloc(impl->desc.max_jobs, sizeof(int));
+    impl->threads = calloc(impl->desc.num_threads, sizeof(texture_stream_thread_t));
+
+    if (!impl->jobs || !impl->queue || !impl->threads)
+    {
+        texture_stream_free(stream, impl);
+        return false;
+    }
+
+    #if defined(_WIN32)
+        InitializeCriticalSection(&impl->mutex);
+        InitializeConditionVariable(&impl->cond);
+    #else
+        pthread_mutex_init(&impl->mutex, NULL);
+        pthread_cond_init(&impl->cond, NULL);
+    #endif
+
+    for (int i = 0; i < impl->desc.num_threads; i++)
+    {
+        #if defined(_WIN32)
+            impl->threads[i] = CreateThread(NULL, 0, texture_stream_thread, impl, 0, NULL);
+            const bool started = (impl->threads[i] != NULL);
+        #else
+            const bool started = (pthread_create(&impl->threads[i], NULL, texture_stream_thread, impl) == 0);
+        #endif
+
+        if (!started)
+        {
+            texture_stream_stop_threads(impl, i);
+            texture_stream_destroy_mutex(impl);
+            texture_stream_free(stream, impl);
+            return false;
+        }
+    }
+
+    if (!sg_add_commit_listener((sg_commit_listener){ .func = texture_stream_on_commit, .user_data = impl }))
+    {
+        texture_stream_stop_threads(impl, impl->desc.num_threads);
+        texture_stream_destroy_mutex(impl);
+        texture_stream_free(stream, impl);
+        return false;
+    }
+
+    stream->impl = impl;
+    return true;
+}
+
+void texture_stream_shutdown(texture_stream_t* stream)
+{
+    assert(stream && stream->impl);
+
+    texture_stream_impl_t* impl = stream->impl;
+
+    sg_remove_commit_listener((sg_commit_listener){ .func = texture_stream_on_commit, .user_data = impl });
+
+    texture_stream_stop_threads(impl, impl->desc.num_threads);
+
+    // images still waiting in sokol_gfx's init queue reference pixels which
+    // are freed here, failing them makes sg_commit() skip the queued items
+    for (int i = 0; i < impl->desc.max_jobs; i++)
+    {
+        texture_stream_job_t* job = &impl->jobs[i];
+
+        if (job->state == TEXTURE_STREAM_JOB_FREE)
+            continue;
+
+        if (sg_query_image_state(job->image) == SG_RESOURCESTATE_ALLOC)
+            sg_fail_image(job->image);
+
+        texture_stream_free_job(job);
+    }
+
+    texture_stream_destroy_mutex(impl);
+    texture_stream_free(stream, impl);
+}
+
+sg_image texture_stream_load(texture_stream_t* stream, const char* path)
+{
+    assert(stream && stream->impl && path);
+
+    texture_stream_impl_t* impl = stream->impl;
+    sg_image image = { SG_INVALID_ID };
+
+    texture_stream_lock(impl);
+
+    int index = 0;
+
+    while ((index < impl->desc.max_jobs) && (impl->jobs[index].state != TEXTURE_STREAM_JOB_FREE))
+        index++;
+
+    if (index < impl->desc.max_jobs)
+        image = sg_alloc_image();
+
+    if (image.id != SG_INVALID_ID)
+    {
+        texture_stream_job_t* job = &impl->jobs[index];
+        const size_t len = strlen(path) + 1;
+
+        job->path = malloc(len);
+
+        if (!job->path)
+        {
+            sg_dealloc_image(image);
+            texture_stream_unlock(impl);
+            return (sg_image){ SG_INVALID_ID };
+        }
+
+        job->state = TEXTURE_STREAM_JOB_QUEUED;
+        job->image = image;
+        memcpy(job->path, path, len);
+
+        impl->queue[(impl->queue_head + impl->queue_count) % impl->desc.max_jobs] = index;
+        impl->queue_count++;
+        texture_stream_wake(impl, false);
+    }
+
+    texture_stream_unlock(impl);
+    return image;
+}
+
+sg_image texture_stream_image(const texture_stream_t* stream, sg_image image)
+{
+    assert(stream);
+
+    if (sg_query_image_state(image) == SG_RESOURCESTATE_VALID)
+        return image;
+
+    return stream->desc.placeholder;
+}
+
+texture_stream_stats_t texture_stream_stats(const texture_stream_t* stream)
+{
+    assert(stream && stream->impl);
+
+    texture_stream_impl_t* impl = stream->impl;
+
+    texture_stream_lock(impl);
+
+    texture_stream_stats_t stats = impl->stats;
+    stats.num_pending = 0;
+    stats.num_decoded = 0;
+
+    for (int i = 0; i < impl->desc.max_jobs; i++)
+    {
+        switch (impl->jobs[i].state)
+        {
+            case TEXTURE_STREAM_JOB_QUEUED:
+            case TEXTURE_STREAM_JOB_DECODING:
+                stats.num_pending++;
+                break;
+
+            case TEXTURE_STREAM_JOB_DECODED:
+            case TEXTURE_STREAM_JOB_UPLOADING:
+                stats.num_decoded++;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    texture_stream_unlock(impl);
+    return stats;
+}
+
+#endif // TEXTURE_STREAM_IMPL_INCLUDED
+#endif // TEXTURE_STREAM_IMPL